@@ -156,14 +156,17 @@ void parameters::initialize()
     is_include_start_ramp_costs.set(	  true,	 "is_include_start_ramp_costs",		 false,	"Include startup and ramping costs in financial models?",	   "",			    "Financial|Parameters" );
 
     std::string rp = "perf_over_mrt";
+    std::string hs = "first";
     std::vector< double > shape = { 1. };
     std::vector< double > scale = { 12000. };
     std::vector< double > mtr = { 2. };
     std::vector< double > repair_cost = { 300. };
     avail_seed.set(                        123,                   "avail_seed",      false,                     "Random number generator seed",           "-", "Heliostat availability|Parameters" );
+    avail_replications.set(                  1,           "avail_replications",      false,                "Number of availability replications",     "-", "Heliostat availability|Parameters" );
     om_staff_max_hours_week.set(            35,      "om_staff_max_hours_week",      false,                     "Max O&M staff hours per week",          "hr", "Heliostat availability|Parameters" );
     n_heliostats_sim.set(                 1000,             "n_heliostats_sim",      false,                   "Number of simulated heliostats",           "-", "Heliostat availability|Parameters" );
     helio_repair_priority.set(              rp,        "helio_repair_priority",      false,                        "Heliostat repair priority",           "-", "Heliostat availability|Parameters" );
+    helio_sampling.set(                     hs,               "helio_sampling",      false,                 "Simulated heliostat sampling",           "-", "Heliostat availability|Parameters" );
     avail_model_timestep.set(               24,         "avail_model_timestep",      false,                      "Availability model timestep",          "hr", "Heliostat availability|Parameters" );
     helio_comp_weibull_shape.set(        shape,     "helio_comp_weibull_shape",      false,             "Helio component Weibull shape params",           "-", "Heliostat availability|Parameters" );
     helio_comp_weibull_scale.set(        scale,     "helio_comp_weibull_scale",      false,             "Helio component Weibull scale params",          "hr", "Heliostat availability|Parameters" );
@@ -280,9 +283,11 @@ void parameters::initialize()
     (*this)["adjust_constant"] = &adjust_constant;
 	(*this)["is_include_start_ramp_costs"] = &is_include_start_ramp_costs;
     (*this)["avail_seed"] = &avail_seed;
+    (*this)["avail_replications"] = &avail_replications;
     (*this)["om_staff_max_hours_week"] = &om_staff_max_hours_week;
     (*this)["n_heliostats_sim"] = &n_heliostats_sim;
     (*this)["helio_repair_priority"] = &helio_repair_priority;
+    (*this)["helio_sampling"] = &helio_sampling;
     (*this)["avail_model_timestep"] = &avail_model_timestep;
     (*this)["helio_comp_weibull_shape"] = &helio_comp_weibull_shape;
     (*this)["helio_comp_weibull_scale"] = &helio_comp_weibull_scale;
@@ -402,6 +407,8 @@ void solarfield_outputs::initialize()
     heliostat_repair_cost_y1.set(          nan,     "heliostat_repair_cost_y1",       true,					  "Heliostat repair cost (year 1)",        "$",    "Heliostat availability|Outputs" );
     heliostat_repair_cost_real.set(        nan,   "heliostat_repair_cost_real",       true );
     avg_avail.set(                         nan,                    "avg_avail",       true,                    "Average lifetime availability",        "-",    "Heliostat availability|Outputs" );
+    avg_avail_ci.set(                      nan,                 "avg_avail_ci",       true,          "Average availability 95% CI half-width",        "-",    "Heliostat availability|Outputs" );
+    n_repairs_ci.set(                      nan,                 "n_repairs_ci",       true,             "Number of repairs 95% CI half-width",        "-",    "Heliostat availability|Outputs" );
 
     std::vector< double > empty_vec;
     avail_schedule.set(              empty_vec,               "avail_schedule",       true,            "Heliostat field availability schedule",        "-",    "Heliostat availability|Outputs" );
@@ -414,6 +421,8 @@ void solarfield_outputs::initialize()
     (*this)["heliostat_repair_cost_real"] = &heliostat_repair_cost_real;
     (*this)["avail_schedule"] = &avail_schedule;
     (*this)["avg_avail"] = &avg_avail;
+    (*this)["avg_avail_ci"] = &avg_avail_ci;
+    (*this)["n_repairs_ci"] = &n_repairs_ci;
     (*this)["n_repairs_per_component"] = &n_repairs_per_component;
 
 }
@@ -1507,6 +1516,7 @@ bool Project::M()
     sfa.m_settings.n_helio = m_design_outputs.number_heliostats.as_integer();
     sfa.m_settings.n_helio_sim = std::min(m_parameters.n_heliostats_sim.as_integer(), m_design_outputs.number_heliostats.as_integer());
     sfa.m_settings.seed = m_parameters.avail_seed.as_integer();
+    sfa.m_settings.n_replications = std::max(1, m_parameters.avail_replications.as_integer());
 
     sfa.m_settings.is_fix_hours = false;
     std::string weatherfile = m_parameters.solar_resource_file.as_string();
@@ -1534,6 +1544,18 @@ bool Project::M()
         return false;
     }
 
+    //-- Choice of simulated heliostats
+    std::string sampling = m_parameters.helio_sampling.as_string();
+    if (sampling == "first")
+        sfa.m_settings.helio_sampling = FIRST_HELIOSTATS;
+    else if (sampling == "stratified")
+        sfa.m_settings.helio_sampling = STRATIFIED;
+    else
+    {
+        message_handler("Specified helio_sampling not recognized. Valid inputs are 'first', 'stratified'");
+        return false;
+    }
+
 
     //-- Heliostat components
     bool good_as_new = true;
@@ -1585,6 +1607,7 @@ bool Project::M()
     sfo.m_settings.system_efficiency = m_parameters.TES_powercycle_eff.as_number();
     sfo.m_settings.revenue_discount_rate = term_int_rate * 0.01;
     sfo.m_settings.temporary_staff_cost_multiple = 2.5;
+    sfo.m_settings.n_threads = std::max(1, std::min(m_parameters.n_sim_threads.as_integer(), wxThread::GetCPUCount()));
 
     sfo.m_sfa = sfa;
     
@@ -1610,6 +1633,8 @@ bool Project::M()
     m_solarfield_outputs.heliostat_repair_cost_y1.assign( sfo.m_results.heliostat_repair_cost_y1 );
     m_solarfield_outputs.heliostat_repair_cost_real.assign( sfo.m_results.heliostat_repair_cost );
     m_solarfield_outputs.avg_avail.assign( sfo.m_results.avg_avail );
+    m_solarfield_outputs.avg_avail_ci.assign( sfo.m_results.avg_avail_ci );
+    m_solarfield_outputs.n_repairs_ci.assign( sfo.m_results.n_repairs_ci / sfo.m_sfa.m_settings.n_years );
     m_solarfield_outputs.avail_schedule.assign_vector( sfo.m_results.avail_schedule );
 
     std::vector<double> n_per_comp;
@@ -1709,9 +1734,8 @@ bool Project::C()
     //--- Average number of failure events over all scenarios
     double nf = 0.0;
     /*
-    std::unordered_map < int, std::vector < std::string > > failure_event_labels;
     for (int s = 0; s < ns; s++)
-        nf += pc.m_results.failure_event_labels[s].size() / (double)ns;
+        nf += pc.m_results.failure_events[s].Size() / (double)ns;
     */
 
     // for now count failures from capacity/efficiency results
@@ -3095,6 +3119,7 @@ void Project::initialize_cycle_model(PowerCycle &pc)
 
     pc.m_sim_params.num_scenarios = m_parameters.num_cycle_scenarios.as_integer();
     pc.m_sim_params.steplength = 1.0 / m_parameters.disp_steps_per_hour.as_number();
+    pc.m_sim_params.num_threads = std::max(1, std::min(m_parameters.n_sim_threads.as_integer(), wxThread::GetCPUCount()));
     
     pc.Initialize(0.0);
     
@@ -501,10 +501,12 @@ struct parameters : public hash_base
 	parameter ampl_data_dir;
 	parameter solar_resource_file;
 	parameter helio_repair_priority;
+	parameter helio_sampling;
 	parameter cluster_algorithm;
     //ints
 	parameter disp_steps_per_hour;
 	parameter avail_seed;
+	parameter avail_replications;
 	parameter plant_lifetime;
 	parameter finance_period;
 	parameter ppa_multiplier_model;
@@ -641,6 +643,8 @@ struct solarfield_outputs : public hash_base
 	parameter avail_schedule;
 
 	parameter avg_avail;
+	parameter avg_avail_ci;
+	parameter n_repairs_ci;
 	parameter n_repairs_per_component;
 
 	solarfield_outputs();
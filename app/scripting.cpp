@@ -487,7 +487,9 @@ void _power_cycle(lk::invoke_t &cxt)
 		"radiators_per_train, num_salt_steam_trains, num_fwh, num_salt_pumps, "
 		"num_salt_pumps_required, num_water_pumps, num_water_pumps_required, "
 		"num_boiler_pumps, num_boiler_pumps_required, num_turbines,"
-		" condenser_eff_cold, condenser_eff_hot", "(table:cycle_inputs):table");
+		" condenser_eff_cold, condenser_eff_hot, instrument. "
+		"Returns a table with avg_labor_cost, num_failures and, if instrument "
+		"is true, an instrumentation table of event counts and phase times.", "(table:cycle_inputs):table");
 
 	MainWindow &mw = MainWindow::Instance();
 
@@ -723,6 +725,9 @@ void _power_cycle(lk::invoke_t &cxt)
 		stop_at_first_repair
 		);
 
+	if (h->find("instrument") != h->end())
+		cycle.m_sim_params.instrument = h->at("instrument")->as_boolean();
+
 	std::unordered_map<std::string, std::vector<double> > dispatch;
 	dispatch["cycle_power"] = { 0,0,0,0,0,0,0,0,9,9,9,9,9,9,9,9,0,0,0,0,0,0,0,0,
 		0,0,0,0,0,0,0,0,9,9,9,9,9,9,9,9,0,0,0,0,0,0,0,0 };
@@ -764,7 +769,39 @@ void _power_cycle(lk::invoke_t &cxt)
 	mw.SetProgress(0.);
 
 	mw.Log(wxString::Format("Average cycle repair labor costs: %.2f",cycle.m_results.avg_labor_cost));
-	mw.Log(wxString::Format("Total number of failures: %i", cycle.m_results.failure_event_labels.size()));
+	size_t nfail = 0;
+	for (std::unordered_map<int, FailureEventStore>::iterator it = cycle.m_results.failure_events.begin(); it != cycle.m_results.failure_events.end(); it++)
+		nfail += it->second.Size();
+	mw.Log(wxString::Format("Total number of failures: %i", (int)nfail));
+
+	cxt.result().empty_hash();
+	cxt.result().hash_item("avg_labor_cost", cycle.m_results.avg_labor_cost);
+	cxt.result().hash_item("num_failures", (double)nfail);
+	if (cycle.m_sim_params.instrument)
+	{
+		const cycle_instrumentation &ci = cycle.m_results.instrumentation;
+		cxt.result().hash_item("instrumentation", 0.);
+		lk::vardata_t *inst = cxt.result().hash()->at("instrumentation");
+		inst->empty_hash();
+		inst->hash_item("failures_tested", (double)ci.failures_tested);
+		inst->hash_item("variates_drawn", (double)ci.variates_drawn);
+		inst->hash_item("maintenance_shutdowns", (double)ci.maintenance_shutdowns);
+		inst->hash_item("unplanned_shutdowns", (double)ci.unplanned_shutdowns);
+		inst->hash_item("pump_switches", (double)ci.pump_switches);
+		inst->hash_item("checkpoint_restores", (double)ci.checkpoint_restores);
+		inst->hash_item("periods_read_in", (double)ci.periods_read_in);
+		inst->hash_item("periods_skipped", (double)ci.periods_skipped);
+		inst->hash_item("read_in_time", ci.read_in_time);
+		inst->hash_item("steady_time", ci.steady_time);
+		inst->hash_item("failure_test_time", ci.failure_test_time);
+		inst->hash_item("maintenance_time", ci.maintenance_time);
+		inst->hash_item("operate_time", ci.operate_time);
+		inst->hash_item("dispatch_time", ci.dispatch_time);
+		inst->hash_item("state_time", ci.state_time);
+		inst->hash_item("output_time", ci.output_time);
+		inst->hash_item("scenario_time", ci.scenario_time);
+		inst->hash_item("simulate_time", ci.simulate_time);
+	}
 
 	return;
 }
@@ -835,13 +872,46 @@ void _simulate_optical(lk::invoke_t &cxt)
 void _simulate_solarfield(lk::invoke_t &cxt)
 {
 
-	LK_DOC("simulate_solarfield", "Simulates solar field availability from current project settings.", "([table:options]):table");
+	LK_DOC("simulate_solarfield", "Simulates solar field availability from current project settings. "
+		"Options are replications (number of independent realisations averaged) and rng_seed; "
+		"they apply to this call only, and the project settings are restored afterwards. "
+		"Returns a table with avg_avail, n_repairs, staff_utilization and the 95% confidence "
+		"interval half-widths avg_avail_ci and n_repairs_ci (not a number for a single replication).", "([table:options]):table");
 	
 	MainWindow &mw = MainWindow::Instance();
-	mw.GetProject()->M();
+	Project* P = mw.GetProject();
+
+	int replications = P->m_parameters.avail_replications.as_integer();
+	int rng_seed = P->m_parameters.avail_seed.as_integer();
+
+	if (cxt.arg_count() > 0)
+	{
+		lk::varhash_t *h = cxt.arg(0).hash();
+
+		if (h->find("replications") != h->end())
+			P->m_parameters.avail_replications.assign( h->at("replications")->as_integer() );
+
+		if (h->find("rng_seed") != h->end())
+			P->m_parameters.avail_seed.assign( h->at("rng_seed")->as_integer() );
+	}
+
+	bool ok = P->M();
+
+	P->m_parameters.avail_replications.assign( replications );
+	P->m_parameters.avail_seed.assign( rng_seed );
 	mw.UpdateDataTable();
     mw.SetProgress(0.);
 
+	if (!ok)
+		return;
+
+	cxt.result().empty_hash();
+	cxt.result().hash_item("avg_avail", P->m_solarfield_outputs.avg_avail.as_number());
+	cxt.result().hash_item("avg_avail_ci", P->m_solarfield_outputs.avg_avail_ci.as_number());
+	cxt.result().hash_item("n_repairs", P->m_solarfield_outputs.n_repairs.as_number());
+	cxt.result().hash_item("n_repairs_ci", P->m_solarfield_outputs.n_repairs_ci.as_number());
+	cxt.result().hash_item("staff_utilization", P->m_solarfield_outputs.staff_utilization.as_number());
+	cxt.result().hash_item("n_om_staff", P->m_solarfield_outputs.n_om_staff.as_number());
 	return;
 
 }
@@ -82,6 +82,8 @@ void Project::add_documentation()
         "Number of time steps per hour to be used in the dispatch optimization model. "
         "This value may differ from the time step in the weather file data.");
     m_parameters.avail_seed.doc.set("-", "Seed for the solar field availability model random number generator.");
+    m_parameters.avail_replications.doc.set("-", "Number of independent realisations of the solar field availability model "
+        "averaged at each staff level. Realisations are simulated in parallel on up to n_sim_threads threads.");
     m_parameters.plant_lifetime.doc.set("yr", "Expected operational lifetime of the plant. The expected lifetime has total revenue, degradation, and failure implications.");
     m_parameters.finance_period.doc.set("yr", "Term during which loans are repayed in full.");
     m_parameters.ppa_multiplier_model.doc.set("-", 
@@ -110,6 +112,11 @@ void Project::add_documentation()
         "count in the simulation, and the results of the simulation are scaled according the number of heliostats included in the "
         "plant. Fewer heliostats for simulation corresponds to more significant random effects during stochastic evaluation, while "
         "more heliostats reduces uncertainty effects but incurs more computational expense.");
+    m_parameters.helio_sampling.doc.set("-", 
+        "Choice of the heliostats simulated in the availability model. 'first' simulates the first n_heliostats_sim heliostats "
+        "of the layout. 'stratified' sorts the heliostats by annual energy, splits them into n_heliostats_sim strata of equal size, "
+        "and simulates one heliostat per stratum that represents the energy of the whole stratum, so that fewer simulated "
+        "heliostats are needed for the same accuracy of the availability and revenue loss.");
     m_parameters.wash_rate.doc.set("1/hr", "Number of heliostats washed per hour per wash crew.");
     m_parameters.n_sim_threads.doc.set("-", "Maximum number of CPU threads to utilize in simulating plant performance. "
         "Multithreading is only available if ");
@@ -198,6 +205,10 @@ void Project::add_documentation()
         "heliostat field O&M staff.");
     m_solarfield_outputs.heliostat_repair_cost_y1.doc.set("$/yr", "Annualized cost of all heliostat repairs made discounted to year 1.");
     m_solarfield_outputs.heliostat_repair_cost_real.doc.set("$", "Lifetime cost of all heliostat repairs made.");
+    m_solarfield_outputs.avg_avail_ci.doc.set("-", "Half-width of the 95% confidence interval of the average availability "
+        "over the availability model replications (not a number for a single replication).");
+    m_solarfield_outputs.n_repairs_ci.doc.set("-", "Half-width of the 95% confidence interval of the number of repairs "
+        "over the availability model replications (not a number for a single replication).");
     m_solarfield_outputs.avail_schedule.doc.set("-", "Calculated solar field availability time series based on modeled failure and repair events.");
 
 	m_optical_outputs.n_wash_vehicles.doc.set("-", "Number of wash vehicles purchased.");
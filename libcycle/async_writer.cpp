@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include "async_writer.h"
+
+//buffer size of the file streams of the writer thread
+static const size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+AsyncFileWriter::AsyncFileWriter(size_t max_queued_bytes)
+{
+	m_queued_bytes = 0;
+	m_max_queued_bytes = max_queued_bytes;
+	m_busy = false;
+	m_stop = false;
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+	/* writes any queued blocks; errors are dropped, as they cannot be reported. */
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_has_work.notify_one();
+	if (m_thread.joinable())
+		m_thread.join();
+}
+
+void AsyncFileWriter::Write(const std::string &filename, std::string data, bool append)
+{
+	/*
+	Queues a block of text to be written.  Waits only while the queue is
+	full; a block larger than the queue is accepted once the queue is empty.
+	filename -- path of the file
+	data -- text to write
+	append -- appends to the file if true, and replaces it otherwise
+	*/
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (!m_thread.joinable())
+		m_thread = std::thread(&AsyncFileWriter::Run, this);
+	while (m_queued_bytes > 0 && m_queued_bytes + data.size() > m_max_queued_bytes)
+		m_has_room.wait(lock);
+	m_queued_bytes += data.size();
+	m_queue.push_back(block());
+	block &b = m_queue.back();
+	b.filename = filename;
+	b.append = append;
+	b.data.swap(data);
+	lock.unlock();
+	m_has_work.notify_one();
+}
+
+void AsyncFileWriter::Flush()
+{
+	/*
+	Waits until all queued blocks are written.  Throws if a write failed
+	since the last flush.
+	*/
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (!m_queue.empty() || m_busy)
+		m_idle.wait(lock);
+	if (!m_error.empty())
+	{
+		std::string error;
+		error.swap(m_error);
+		throw std::runtime_error(error);
+	}
+}
+
+void AsyncFileWriter::Run()
+{
+	/* writer thread: takes all queued blocks at once and writes them in order. */
+	std::vector< char > buffer(WRITE_BUFFER_SIZE);
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		while (m_queue.empty() && !m_stop)
+			m_has_work.wait(lock);
+		if (m_queue.empty())
+			break;
+		std::deque< block > work;
+		work.swap(m_queue);
+		m_busy = true;
+		lock.unlock();
+
+		std::string error;
+		FILE *file = NULL;
+		for (size_t i = 0; i < work.size(); i++)
+		{
+			const block &b = work[i];
+			//keep the file open for appends that follow
+			if (file == NULL || !b.append || b.filename != work[i - 1].filename)
+			{
+				if (file != NULL && std::fclose(file) != 0 && error.empty())
+					error = "could not write " + work[i - 1].filename;
+				file = std::fopen(b.filename.c_str(), b.append ? "a" : "w");
+				if (file == NULL)
+				{
+					if (error.empty())
+						error = "could not open " + b.filename + " for writing";
+					continue;
+				}
+				std::setvbuf(file, &buffer[0], _IOFBF, buffer.size());
+			}
+			if (!b.data.empty() && std::fwrite(b.data.data(), 1, b.data.size(), file) != b.data.size()
+				&& error.empty())
+				error = "could not write " + b.filename;
+		}
+		if (file != NULL && std::fclose(file) != 0 && error.empty())
+			error = "could not write " + work.back().filename;
+
+		lock.lock();
+		for (size_t i = 0; i < work.size(); i++)
+			m_queued_bytes -= work[i].data.size();
+		if (!error.empty() && m_error.empty())
+			m_error = error;
+		m_busy = false;
+		m_has_room.notify_all();
+		if (m_queue.empty())
+			m_idle.notify_all();
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef _ASYNC_WRITER_
+#define _ASYNC_WRITER_
+
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stddef.h>
+
+/*
+Writes text files on a background thread.  The simulation formats each
+output as a block of text and hands it to Write, which only waits if more
+than a set number of bytes are already queued; blocks are written in the
+order they were handed over, each with one buffered write, and consecutive
+blocks appended to the same file share one open file.  Flush waits until
+all queued blocks are on disk, and reports the first failed write.  Safe
+to use from several threads.
+*/
+class AsyncFileWriter
+{
+	struct block
+	{
+		std::string filename;
+		bool append;
+		std::string data;
+	};
+
+	std::deque< block > m_queue;
+	size_t m_queued_bytes;
+	size_t m_max_queued_bytes;
+	bool m_busy;
+	bool m_stop;
+	std::string m_error;
+	std::mutex m_mutex;
+	std::condition_variable m_has_work;
+	std::condition_variable m_has_room;
+	std::condition_variable m_idle;
+	std::thread m_thread;
+
+	void Run();
+
+	AsyncFileWriter(const AsyncFileWriter &);
+	AsyncFileWriter &operator=(const AsyncFileWriter &);
+
+public:
+	AsyncFileWriter(size_t max_queued_bytes = 64 << 20);
+	~AsyncFileWriter();
+
+	void Write(const std::string &filename, std::string data, bool append = false);
+
+	void Flush();
+};
+
+#endif
@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/prettywriter.h>
+
+#include "plant.h"
+
+/*
+Benchmark suite of the power cycle availability model.
+
+Runs a synthetic hourly dispatch profile through the default plant
+(PowerCycle::GeneratePlantComponents()) over horizons of 48 hours, one
+year and five years, and times:
+	(i) the hourly dispatch loop driven through the enumerated mode API and
+	through the string-based mode API, both untimed inside the loop, and, in
+	a separate pass, the phases of the enumerated loop, 
+	SetCycleCapacityAndEfficiency, TestForComponentFailures and OperatePlant;
+	(ii) a single-scenario call to PowerCycle::RunDispatch(); and
+	(iii) PowerCycle::Simulate() with 1, 10, 100 and 1000 scenarios.
+Each timing is the fastest of a number of repetitions from the same start
+state and RNG streams, so the simulated work is identical between
+repetitions and between revisions of the library.  Results are written as
+JSON, with the capacity and labor cost the runs produce, so that speedups
+can be checked not to have changed them.
+
+usage: cycle_benchmark [-o file] [-t threads] [-s max scenarios] [-r repetitions]
+	-o -- writes the results to a file instead of standard output
+	-t -- worker threads of Simulate(); 0 uses all hardware threads (default 1)
+	-s -- largest number of scenarios to simulate (default 1000)
+	-r -- repetitions of each timing (default 3)
+*/
+
+typedef rapidjson::PrettyWriter< rapidjson::StringBuffer > JsonWriter;
+
+static const int HORIZONS[] = { 48, 8760, 43800 };
+static const int SCENARIO_COUNTS[] = { 1, 10, 100, 1000 };
+//the enumerated and string-based loops differ by a few percent; they are 
+//cheap, so they are repeated at least this many times
+static const int MIN_LOOP_REPETITIONS = 10;
+
+static std::unordered_map< std::string, std::vector< double > > GetDispatch(int n)
+{
+	/*
+	Synthetic dispatch: the cycle runs from 8am to 8pm at a load that varies
+	from day to day, and sits on standby for an hour either side.
+	n -- number of hourly periods
+	*/
+	std::unordered_map< std::string, std::vector< double > > dispatch;
+	for (int t = 0; t < n; t++)
+	{
+		int h = t % 24;
+		double load = (h >= 8 && h < 20) ? 0.6 + 0.2*((t / 24) % 3) : 0.;
+		dispatch["cycle_power"].push_back(load * 4.e8);
+		dispatch["thermal_power"].push_back(load * 1.2e9);
+		dispatch["ambient_temperature"].push_back(h > 12 ? 25. : 15.);
+		dispatch["standby"].push_back((h == 7 || h == 20) ? 1. : 0.);
+	}
+	return dispatch;
+}
+
+static void SetupPlant(PowerCycle &pc, int n, int num_scenarios, int num_threads)
+{
+	pc.m_sim_params.num_scenarios = num_scenarios;
+	pc.Initialize(0.0);
+	pc.SetPlantAttributes(1.e6, 168., 24., 1.e6, 0., 0., false, 5.e8, 1.5e9);
+	pc.SetSimulationParameters(0, n, 1.0, false, num_scenarios, 50., false, false);
+	pc.m_sim_params.num_threads = num_threads;
+	//keep memory flat in the number of scenarios
+	pc.m_sim_params.retain_scenario_results = false;
+	std::unordered_map< std::string, std::vector< double > > dispatch = GetDispatch(n);
+	pc.SetDispatch(dispatch);
+	pc.StoreCycleState();
+}
+
+static double Seconds(std::chrono::steady_clock::time_point start_time)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+struct phase_times
+{
+	double set_capacity;
+	double test_failures;
+	double operate;
+	double total;
+};
+
+static double RunEnumModes(PowerCycle &pc, int n)
+{
+	/* hot loop through the enumerated mode API; returns seconds. */
+	std::unordered_map< std::string, std::vector< double > > dispatch = pc.GetDispatch();
+	const std::vector< double > &power = dispatch.at("cycle_power");
+	const std::vector< double > &thermal = dispatch.at("thermal_power");
+	const std::vector< double > &temp = dispatch.at("ambient_temperature");
+	std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+	for (int t = 0; t < n; t++)
+	{
+		pc.ResetCycleEventFlags();
+		pc.SetCycleCapacityAndEfficiency(temp[t]);
+		start_mode start = pc.GetStartModeEnum(t);
+		operating_mode mode = pc.GetOperatingModeEnum(t);
+		double ramp_mult = pc.GetRampMult(thermal[t]);
+		pc.TestForComponentFailures(ramp_mult, t, start, mode);
+		pc.SetCycleCapacityAndEfficiency(temp[t]);
+		if (pc.GetCycleCapacity() < 1.e-10)
+			mode = MODE_OFF;
+		pc.OperatePlant(power[t], thermal[t], t, start, mode);
+	}
+	return Seconds(start_time);
+}
+
+static phase_times RunEnumModePhases(PowerCycle &pc, int n)
+{
+	/* 
+	hot loop through the enumerated mode API, timing each phase; returns 
+	seconds.  The timers add to the loop, so its total is not comparable 
+	to that of the untimed loops.
+	*/
+	phase_times times = { 0., 0., 0., 0. };
+	std::unordered_map< std::string, std::vector< double > > dispatch = pc.GetDispatch();
+	const std::vector< double > &power = dispatch.at("cycle_power");
+	const std::vector< double > &thermal = dispatch.at("thermal_power");
+	const std::vector< double > &temp = dispatch.at("ambient_temperature");
+	std::chrono::steady_clock::time_point loop_start = std::chrono::steady_clock::now();
+	for (int t = 0; t < n; t++)
+	{
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		pc.ResetCycleEventFlags();
+		pc.SetCycleCapacityAndEfficiency(temp[t]);
+		times.set_capacity += Seconds(start_time);
+		start_mode start = pc.GetStartModeEnum(t);
+		operating_mode mode = pc.GetOperatingModeEnum(t);
+		double ramp_mult = pc.GetRampMult(thermal[t]);
+		start_time = std::chrono::steady_clock::now();
+		pc.TestForComponentFailures(ramp_mult, t, start, mode);
+		times.test_failures += Seconds(start_time);
+		start_time = std::chrono::steady_clock::now();
+		pc.SetCycleCapacityAndEfficiency(temp[t]);
+		times.set_capacity += Seconds(start_time);
+		if (pc.GetCycleCapacity() < 1.e-10)
+			mode = MODE_OFF;
+		start_time = std::chrono::steady_clock::now();
+		pc.OperatePlant(power[t], thermal[t], t, start, mode);
+		times.operate += Seconds(start_time);
+	}
+	times.total = Seconds(loop_start);
+	return times;
+}
+
+static double RunStringModes(PowerCycle &pc, int n)
+{
+	/* hot loop through the string-based mode API; returns seconds. */
+	std::unordered_map< std::string, std::vector< double > > dispatch = pc.GetDispatch();
+	const std::vector< double > &power = dispatch.at("cycle_power");
+	const std::vector< double > &thermal = dispatch.at("thermal_power");
+	const std::vector< double > &temp = dispatch.at("ambient_temperature");
+	std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+	for (int t = 0; t < n; t++)
+	{
+		pc.ResetCycleEventFlags();
+		pc.SetCycleCapacityAndEfficiency(temp[t]);
+		std::string start = pc.GetStartMode(t);
+		std::string mode = pc.GetOperatingMode(t);
+		double ramp_mult = pc.GetRampMult(thermal[t]);
+		pc.TestForComponentFailures(ramp_mult, t, start, mode);
+		pc.SetCycleCapacityAndEfficiency(temp[t]);
+		if (pc.GetCycleCapacity() < 1.e-10)
+			mode = "OFF";
+		pc.OperatePlant(power[t], thermal[t], t, start, mode);
+	}
+	return Seconds(start_time);
+}
+
+static void WriteTiming(JsonWriter &writer, const char *name, double seconds, int calls)
+{
+	/* writes the total time of a function, or loop of periods, and its time per call or period. */
+	writer.Key(name);
+	writer.StartObject();
+	writer.Key("seconds");
+	writer.Double(seconds);
+	writer.Key("calls");
+	writer.Int(calls);
+	writer.Key("ns_per_call");
+	writer.Double(calls > 0 ? 1.e9 * seconds / calls : 0.);
+	writer.EndObject();
+}
+
+static void BenchmarkHotLoop(JsonWriter &writer, int n, int repetitions)
+{
+	/*
+	Times the phases of the dispatch loop and RunDispatch over a horizon,
+	for a single scenario.
+	n -- number of hourly periods
+	repetitions -- number of runs, of which the fastest is kept
+	*/
+	WELLFiveTwelve gen1(0), gen2(0), gen3(0);
+	PowerCycle pc;
+	pc.AssignGenerators(&gen1, &gen2, &gen3);
+	SetupPlant(pc, n, 1, 1);
+
+	phase_times best = { 0., 0., 0., 0. };
+	double t_enum = 0., t_string = 0., t_dispatch = 0.;
+	double cap_enum = 0., cap_string = 0.;
+	int loop_repetitions = std::max(repetitions, MIN_LOOP_REPETITIONS);
+	for (int r = 0; r < loop_repetitions; r++)
+	{
+		//alternate which loop runs first, so neither gains from the other's warm-up
+		for (int i = 0; i < 2; i++)
+		{
+			if ((r + i) % 2 == 0)
+			{
+				double t = RunEnumModes(pc, n);
+				cap_enum = pc.GetCycleCapacity();
+				pc.RevertToStartState(true);
+				t_enum = r == 0 ? t : std::min(t_enum, t);
+			}
+			else
+			{
+				double t = RunStringModes(pc, n);
+				cap_string = pc.GetCycleCapacity();
+				pc.RevertToStartState(true);
+				t_string = r == 0 ? t : std::min(t_string, t);
+			}
+		}
+
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		pc.RunDispatch();
+		double t = Seconds(start_time);
+		pc.RevertToStartState(true);
+		t_dispatch = r == 0 ? t : std::min(t_dispatch, t);
+	}
+
+	//the phase breakdown is a separate pass, as its timers slow the loop down
+	for (int r = 0; r < repetitions; r++)
+	{
+		phase_times times = RunEnumModePhases(pc, n);
+		pc.RevertToStartState(true);
+		if (r == 0 || times.total < best.total)
+			best = times;
+	}
+
+	writer.StartObject();
+	writer.Key("periods");
+	writer.Int(n);
+	WriteTiming(writer, "SetCycleCapacityAndEfficiency", best.set_capacity, 2 * n);
+	WriteTiming(writer, "TestForComponentFailures", best.test_failures, n);
+	WriteTiming(writer, "OperatePlant", best.operate, n);
+	WriteTiming(writer, "dispatch_loop_timed_phases", best.total, n);
+	WriteTiming(writer, "dispatch_loop_enum_modes", t_enum, n);
+	WriteTiming(writer, "dispatch_loop_string_modes", t_string, n);
+	WriteTiming(writer, "RunDispatch", t_dispatch, n);
+	writer.Key("final_capacities_match");
+	writer.Bool(cap_enum == cap_string);
+	writer.EndObject();
+}
+
+static void BenchmarkSimulate(JsonWriter &writer, int n, int num_scenarios,
+	int num_threads, int repetitions)
+{
+	/*
+	Times Simulate() over a horizon and number of scenarios.
+	n -- number of hourly periods
+	num_scenarios -- number of scenarios
+	num_threads -- number of worker threads
+	repetitions -- number of runs, of which the fastest is kept
+	*/
+	double best = 0.;
+	double avg_capacity = 0., avg_labor_cost = 0.;
+	for (int r = 0; r < repetitions; r++)
+	{
+		WELLFiveTwelve gen1(0), gen2(0), gen3(0);
+		PowerCycle pc;
+		pc.AssignGenerators(&gen1, &gen2, &gen3);
+		SetupPlant(pc, n, num_scenarios, num_threads);
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		pc.Simulate();
+		double t = Seconds(start_time);
+		best = r == 0 ? t : std::min(best, t);
+		avg_capacity = 0.;
+		for (size_t i = 0; i < pc.m_results.avg_cycle_capacity.size(); i++)
+			avg_capacity += pc.m_results.avg_cycle_capacity.at(i) / n;
+		avg_labor_cost = pc.m_results.avg_labor_cost;
+	}
+
+	writer.StartObject();
+	writer.Key("periods");
+	writer.Int(n);
+	writer.Key("scenarios");
+	writer.Int(num_scenarios);
+	writer.Key("threads");
+	writer.Int(num_threads);
+	writer.Key("seconds");
+	writer.Double(best);
+	writer.Key("us_per_scenario_period");
+	writer.Double(1.e6 * best / ((double)n * num_scenarios));
+	writer.Key("avg_cycle_capacity");
+	writer.Double(avg_capacity);
+	writer.Key("avg_labor_cost");
+	writer.Double(avg_labor_cost);
+	writer.EndObject();
+}
+
+int main(int argc, char *argv[])
+{
+	std::string output_file;
+	int num_threads = 1;
+	int max_scenarios = 1000;
+	int repetitions = 3;
+	for (int i = 1; i < argc; i++)
+	{
+		bool has_value = i + 1 < argc;
+		if (std::strcmp(argv[i], "-o") == 0 && has_value)
+			output_file = argv[++i];
+		else if (std::strcmp(argv[i], "-t") == 0 && has_value)
+			num_threads = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "-s") == 0 && has_value)
+			max_scenarios = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "-r") == 0 && has_value)
+			repetitions = std::atoi(argv[++i]);
+		else
+			repetitions = 0;
+	}
+	if (num_threads < 0 || max_scenarios < 1 || repetitions < 1)
+	{
+		std::cerr << "usage: cycle_benchmark [-o file] [-t threads] [-s max scenarios] [-r repetitions]\n";
+		return 1;
+	}
+	if (num_threads == 0)
+		num_threads = std::max(1, (int)std::thread::hardware_concurrency());
+
+	rapidjson::StringBuffer buffer;
+	JsonWriter writer(buffer);
+	writer.StartObject();
+	writer.Key("benchmark");
+	writer.String("cycle_benchmark");
+	writer.Key("repetitions");
+	writer.Int(repetitions);
+
+	writer.Key("hot_loop");
+	writer.StartArray();
+	for (size_t h = 0; h < sizeof(HORIZONS) / sizeof(HORIZONS[0]); h++)
+	{
+		std::cerr << "hot loop, " << HORIZONS[h] << " periods\n";
+		BenchmarkHotLoop(writer, HORIZONS[h], repetitions);
+	}
+	writer.EndArray();
+
+	writer.Key("simulate");
+	writer.StartArray();
+	for (size_t h = 0; h < sizeof(HORIZONS) / sizeof(HORIZONS[0]); h++)
+	{
+		for (size_t s = 0; s < sizeof(SCENARIO_COUNTS) / sizeof(SCENARIO_COUNTS[0]); s++)
+		{
+			if (SCENARIO_COUNTS[s] > max_scenarios)
+				continue;
+			std::cerr << "Simulate, " << HORIZONS[h] << " periods, " << SCENARIO_COUNTS[s] << " scenarios\n";
+			BenchmarkSimulate(writer, HORIZONS[h], SCENARIO_COUNTS[s], num_threads, repetitions);
+		}
+	}
+	writer.EndArray();
+	writer.EndObject();
+
+	if (output_file.empty())
+	{
+		std::cout << buffer.GetString() << "\n";
+		return 0;
+	}
+	FILE *file = std::fopen(output_file.c_str(), "w");
+	if (file == NULL || std::fputs(buffer.GetString(), file) < 0 || std::fclose(file) != 0)
+	{
+		std::cerr << "could not write " << output_file << "\n";
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "well512.h"
+
+/*
+Check of the WELL512 jump-ahead.
+
+The jump polynomials are derived at run time with the Berlekamp-Massey 
+algorithm, so a slip there shows up only as streams that quietly overlap 
+or differ between revisions.  This checks, from several start states, that
+jumpAhead(k, e) leaves the generator where k * 2^e calls to getVariate() 
+do, for small k and e, by comparing the variates that follow.  It also 
+checks that assignSubstream(s, 0) is the state assignStates(s) sets.
+
+usage: well512_check [-n max steps]
+	-n -- largest number of steps checked (default 2000)
+Exits with a nonzero status on any mismatch.
+*/
+
+//variates compared after each jump
+static const int NUM_COMPARED = 64;
+
+static bool SameOutput(WELLFiveTwelve &a, WELLFiveTwelve &b)
+{
+	/* retval -- whether the next NUM_COMPARED variates of a and b agree */
+	for (int i = 0; i < NUM_COMPARED; i++)
+	{
+		if (a.getVariate() != b.getVariate())
+			return false;
+	}
+	return true;
+}
+
+static int CheckJump(int stream, uint64_t k, int log2_stride)
+{
+	/* retval -- 1 if jumping k strides of 2^log2_stride from 'stream' differs from stepping, else 0 */
+	WELLFiveTwelve jumped(stream);
+	WELLFiveTwelve stepped(stream);
+	uint64_t steps = k << log2_stride;
+	for (uint64_t i = 0; i < steps; i++)
+		stepped.getVariate();
+	jumped.jumpAhead(k, log2_stride);
+	if (SameOutput(jumped, stepped))
+		return 0;
+	std::cerr << "stream " << stream << ": jumpAhead(" << k << ", " << log2_stride 
+		<< ") differs from " << steps << " steps\n";
+	return 1;
+}
+
+int main(int argc, char *argv[])
+{
+	int max_steps = 2000;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			max_steps = std::atoi(argv[++i]);
+		else
+			max_steps = 0;
+	}
+	if (max_steps < 1)
+	{
+		std::cerr << "usage: well512_check [-n max steps]\n";
+		return 1;
+	}
+
+	int checks = 0;
+	int failures = 0;
+	const int streams[] = { 0, 1, 7 };
+	for (size_t s = 0; s < sizeof(streams) / sizeof(streams[0]); s++)
+	{
+		//every distance up to 64 steps, then a spread of larger ones
+		for (int k = 0; k <= max_steps; k += (k < 64 ? 1 : 37))
+		{
+			failures += CheckJump(streams[s], (uint64_t)k, 0);
+			checks++;
+		}
+		//strides of 2^e steps
+		for (int e = 1; (1 << e) <= max_steps; e++)
+		{
+			for (uint64_t k = 1; (k << e) <= (uint64_t)max_steps; k += 3)
+			{
+				failures += CheckJump(streams[s], k, e);
+				checks++;
+			}
+		}
+		WELLFiveTwelve stream(streams[s]);
+		WELLFiveTwelve substream(0);
+		substream.assignSubstream(streams[s], 0);
+		if (!SameOutput(stream, substream))
+		{
+			std::cerr << "stream " << streams[s] << ": substream 0 differs from the stream\n";
+			failures++;
+		}
+		checks++;
+	}
+	std::printf("well512_check: %d checks, %d failures\n", checks, failures);
+	return failures == 0 ? 0 : 1;
+}
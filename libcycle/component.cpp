@@ -13,13 +13,140 @@ failure_event::failure_event(int _time, std::string _component, int _fail_idx, d
 {}
 
 
-std::string failure_event::print()
+std::string failure_event::print() const
 {
     return "<" + component + ", " + std::to_string(duration) + ", " + std::to_string(new_life) + ", scenario " + std::to_string(scen_index) + ", period " + std::to_string(time);
 }
 
 //##################################################################################
 
+uint64_t FailureEventStore::PackKey(int scenario, int t, int component_slot, int event_slot)
+{
+	/*
+	Packs an event's position into a single key; the layout, from the high bits
+	down, is scenario (20 bits), period (24 bits), component slot (12 bits)
+	and event slot (8 bits), so all events of one period share the upper 44 bits.
+	*/
+	if (scenario < 0 || scenario >= (1 << 20) || t < 0 || t >= (1 << 24) ||
+		component_slot < 0 || component_slot >= (1 << 12) ||
+		event_slot < 0 || event_slot >= (1 << 8))
+		throw std::runtime_error("failure event index out of range.");
+	return ((uint64_t)scenario << 44) | ((uint64_t)t << 20) |
+		((uint64_t)component_slot << 8) | (uint64_t)event_slot;
+}
+
+uint64_t FailureEventStore::FailureKey(int scenario, int t, int component_idx, int fail_idx)
+{
+	/* key of failure type fail_idx of component component_idx in period t. */
+	return PackKey(scenario, t, component_idx + 1, fail_idx + 1);
+}
+
+uint64_t FailureEventStore::SwitchKey(int scenario, int t, int component_idx)
+{
+	/* key of the switching event of pump component_idx in period t. */
+	return PackKey(scenario, t, component_idx + 1, 0);
+}
+
+uint64_t FailureEventStore::MaintenanceKey(int scenario, int t, bool planned)
+{
+	/* key of a plant-wide (planned or unplanned) maintenance event in period t. */
+	return PackKey(scenario, t, 0, planned ? 0 : 1);
+}
+
+void FailureEventStore::Add(uint64_t key, const failure_event &e)
+{
+	/*
+	Records an event; if the key is already present, lookups return the most
+	recent event.
+	*/
+	m_index[key] = m_events.size();
+	m_events.push_back(e);
+	m_keys.push_back(key);
+	m_period_counts[key >> 20]++;
+}
+
+const failure_event *FailureEventStore::Find(uint64_t key) const
+{
+	/* retval -- event recorded with the given key, or NULL if there is none. */
+	std::unordered_map< uint64_t, size_t >::const_iterator it = m_index.find(key);
+	if (it == m_index.end())
+		return NULL;
+	return &m_events[it->second];
+}
+
+bool FailureEventStore::HasEventsInPeriod(int scenario, int t) const
+{
+	/* retval -- true if any event was recorded in period t of the scenario. */
+	return m_period_counts.find(PackKey(scenario, t, 0, 0) >> 20) != m_period_counts.end();
+}
+
+size_t FailureEventStore::Size() const
+{
+	/* accessor for the number of recorded events. */
+	return m_events.size();
+}
+
+const failure_event &FailureEventStore::At(size_t i) const
+{
+	/* accessor for the i-th event, in order of occurrence. */
+	return m_events.at(i);
+}
+
+std::string FailureEventStore::GetLabel(size_t i) const
+{
+	/*
+	Generates the text label of the i-th event, as used in the failure file:
+	"S<scenario>T<period><component>F<failure index>" for component failures, 
+	and "S<scenario>T<period><event>" for maintenance and pump switching events.
+	*/
+	const failure_event &e = m_events.at(i);
+	std::string label = "S" + std::to_string(e.scen_index) + "T" + std::to_string(e.time) + e.component;
+	if (e.fail_idx >= 0)
+		label += "F" + std::to_string(e.fail_idx);
+	return label;
+}
+
+void FailureEventStore::Truncate(size_t n)
+{
+	/*
+	Removes all but the first n events, e.g., to return to the events 
+	recorded up to a checkpoint.
+	n -- number of events to keep
+	*/
+	while (m_events.size() > n)
+	{
+		size_t i = m_events.size() - 1;
+		uint64_t key = m_keys[i];
+		std::unordered_map< uint64_t, int >::iterator pc = m_period_counts.find(key >> 20);
+		if (--pc->second == 0)
+			m_period_counts.erase(pc);
+		m_events.pop_back();
+		m_keys.pop_back();
+		if (m_index[key] != i)
+			continue;
+		//fall back on an earlier event with the same key, if any
+		m_index.erase(key);
+		for (size_t j = m_keys.size(); j > 0; j--)
+		{
+			if (m_keys[j - 1] == key)
+			{
+				m_index[key] = j - 1;
+				break;
+			}
+		}
+	}
+}
+
+void FailureEventStore::Clear()
+{
+	m_events.clear();
+	m_keys.clear();
+	m_index.clear();
+	m_period_counts.clear();
+}
+
+//##################################################################################
+
 ComponentStatus::ComponentStatus(){}
 
 ComponentStatus::ComponentStatus(std::vector<double> _lifes, double _hazard, 
@@ -29,15 +156,290 @@ ComponentStatus::ComponentStatus(std::vector<double> _lifes, double _hazard,
 
 //##################################################################################
 
+component_type ComponentTypeFromString(const std::string &type)
+{
+	/* 
+	type -- component type description, as passed to Component()
+	retval -- integer code of the type; COMPONENT_OTHER if not recognized
+	*/
+	if (type == "Condenser train")
+		return COMPONENT_CONDENSER_TRAIN;
+	if (type == "Condenser fan")
+		return COMPONENT_CONDENSER_FAN;
+	if (type == "Salt-to-steam train")
+		return COMPONENT_SALT_STEAM_TRAIN;
+	if (type == "Feedwater heater")
+		return COMPONENT_FEEDWATER_HEATER;
+	if (type == "Molten salt pump")
+		return COMPONENT_SALT_PUMP;
+	if (type == "Boiler pump")
+		return COMPONENT_BOILER_PUMP;
+	if (type == "Water pump")
+		return COMPONENT_WATER_PUMP;
+	if (type == "Turbine")
+		return COMPONENT_TURBINE;
+	return COMPONENT_OTHER;
+}
+
+bool IsPumpType(component_type type)
+{
+	/* retval -- true if the type is a salt, boiler or water pump. */
+	return type == COMPONENT_SALT_PUMP || type == COMPONENT_BOILER_PUMP || 
+		type == COMPONENT_WATER_PUMP;
+}
+
+//##################################################################################
+
+ComponentStateArrays::ComponentStateArrays()
+{
+	life_offset = { 0 };
+	log_likelihood_ratio = 0.;
+}
+
+int ComponentStateArrays::AddComponent(component_type ctype, repair_mode rmode,
+	double cap_reduction, double eff_reduction)
+{
+	/*
+	Appends a new, operational component with no failure types.
+	retval -- index of the new component
+	*/
+	type.push_back(ctype);
+	repair.push_back(rmode);
+	capacity_reduction.push_back(cap_reduction);
+	efficiency_reduction.push_back(eff_reduction);
+	operational.push_back(1);
+	new_failure.push_back(0);
+	new_repair.push_back(0);
+	hazard_rate.push_back(1.0);
+	downtime_remaining.push_back(0.0);
+	repair_event_time.push_back(0.0);
+	age.push_back(0.0);
+	life_offset.push_back(lifetimes.size());
+	return (int)type.size() - 1;
+}
+
+void ComponentStateArrays::AddFailureType(int i, operating_mode mode)
+{
+	/*
+	Appends a failure type, with a lifetime of one, to component i; the 
+	entries of all later components are shifted back by one.
+	*/
+	size_t pos = life_offset.at(i + 1);
+	lifetimes.insert(lifetimes.begin() + pos, 1.);
+	fail_mode.insert(fail_mode.begin() + pos, mode);
+	for (size_t c = i + 1; c < life_offset.size(); c++)
+		life_offset[c]++;
+}
+
+size_t ComponentStateArrays::Size() const
+{
+	/* accessor for the number of components. */
+	return type.size();
+}
+
+void ComponentStateArrays::Clear()
+{
+	*this = ComponentStateArrays();
+}
+
+void ComponentStateArrays::SaveState(std::vector< double > &values, 
+	std::vector< unsigned char > &flags) const
+{
+	/*
+	Copies the state that changes over a simulation into two flat arrays:
+	hazard rates, downtimes, repair event times, ages, lifetimes and the log
+	likelihood ratio in 'values', and the operational, new failure and new 
+	repair flags in 'flags'.  The arrays are reused if already allocated.
+	*/
+	size_t n = Size();
+	values.resize(4 * n + lifetimes.size() + 1);
+	flags.resize(3 * n);
+	values.back() = log_likelihood_ratio;
+	if (n == 0)
+		return;
+	std::copy(hazard_rate.begin(), hazard_rate.end(), values.begin());
+	std::copy(downtime_remaining.begin(), downtime_remaining.end(), values.begin() + n);
+	std::copy(repair_event_time.begin(), repair_event_time.end(), values.begin() + 2 * n);
+	std::copy(age.begin(), age.end(), values.begin() + 3 * n);
+	std::copy(lifetimes.begin(), lifetimes.end(), values.begin() + 4 * n);
+	std::copy(operational.begin(), operational.end(), flags.begin());
+	std::copy(new_failure.begin(), new_failure.end(), flags.begin() + n);
+	std::copy(new_repair.begin(), new_repair.end(), flags.begin() + 2 * n);
+}
+
+void ComponentStateArrays::RestoreState(const std::vector< double > &values, 
+	const std::vector< unsigned char > &flags)
+{
+	/*
+	Restores the state saved by SaveState().  The components and failure 
+	types must be the same as when the state was saved.
+	*/
+	size_t n = Size();
+	if (values.size() != 4 * n + lifetimes.size() + 1 || flags.size() != 3 * n)
+		throw std::runtime_error("saved component state does not match the plant's components.");
+	log_likelihood_ratio = values.back();
+	if (n == 0)
+		return;
+	std::vector< double >::const_iterator v = values.begin();
+	std::copy(v, v + n, hazard_rate.begin());
+	std::copy(v + n, v + 2 * n, downtime_remaining.begin());
+	std::copy(v + 2 * n, v + 3 * n, repair_event_time.begin());
+	std::copy(v + 3 * n, v + 4 * n, age.begin());
+	std::copy(v + 4 * n, values.end() - 1, lifetimes.begin());
+	std::vector< unsigned char >::const_iterator f = flags.begin();
+	std::copy(f, f + n, operational.begin());
+	std::copy(f + n, f + 2 * n, new_failure.begin());
+	std::copy(f + 2 * n, f + 3 * n, new_repair.begin());
+}
+
+bool ComponentStateArrays::CanBeRepaired(int i, operating_mode mode) const
+{
+	/*
+	determines whether or not component i can be repaired.
+	if the plant is off, or the component can be repaired for any mode,
+	then return true.
+
+	mode -- operating mode indicator
+	*/
+	if (mode == MODE_OFF || repair[i] == REPAIR_ANYTIME)
+	{
+		return true;
+	}
+	//if the plant is in standby and the component may be repaired in standby,
+	//return true.
+	if (repair[i] == REPAIR_STANDBY && (mode == MODE_SS || mode == MODE_SF || mode == MODE_SO) )
+	{
+		return true;
+	}		
+	return false;
+}
+
+double ComponentStateArrays::HoursToFailure(int i, double ramp_mult, operating_mode mode) const
+{
+    /* 
+    Returns number of hours of operation that would lead to failure of 
+    component i under the operation parameters given as input.
+        
+    ramp_mult -- degradation multiplier due to ramping
+	mode -- operating mode
+    retval - floating point number indicating hours of operation to failure
+    */
+    if( ramp_mult == 0 )
+        return INFINITY;
+	double hours = INFINITY;
+	for (size_t j = life_offset[i]; j < life_offset[i + 1]; j++)
+	{
+		if (fail_mode[j] == mode)
+		{
+			hours = std::min(hours, 
+				lifetimes[j] / 
+				(hazard_rate[i] * ramp_mult)
+				);
+		}
+	}
+    return hours;
+}
+
+void ComponentStateArrays::Operate(int i, double duration, double ramp_mult, 
+	bool read_only, double hazard_increase, operating_mode mode)
+{
+    /* 
+    assumes operation of component i for a given period of time, with 
+    no permanent change to the hazard rate.
+    duration -- length of time of operation
+    ramp_mult -- degradation multiplier due to ramping
+    read_only -- indicates whether to generate a failure event if 
+        life_remaining falls below 0 during operation
+	hazard_increase -- increase in hazard rate due to a start
+	mode -- operating mode
+    retval -- None
+    */
+    if( ! operational[i] )
+        throw std::runtime_error("can't operate a plant in downtime.");
+	hazard_rate[i] += hazard_increase;
+	operating_mode opmode;
+	//if starting a mode, operate as if
+	//in the first hour of operation for that mode to degrade lifetimes.
+	if (mode == MODE_OS)
+		opmode = MODE_OF;
+	else if (mode == MODE_SS)
+		opmode = MODE_SF;
+	else
+		opmode = mode;
+	double wear = duration * hazard_rate[i] * ramp_mult;
+	for (size_t j = life_offset[i]; j < life_offset[i + 1]; j++)
+	{
+		operating_mode fmode = fail_mode[j];
+		if (fmode == opmode || (opmode != MODE_OFF && fmode == MODE_ALL))
+		{
+			if (wear > lifetimes[j] && !read_only)
+				throw std::runtime_error("failure should be thrown.");
+			lifetimes[j] -= wear;
+		}
+		if (fmode == MODE_O && (opmode == MODE_OO || opmode == MODE_OF))
+		{
+			if (wear > lifetimes[j] && !read_only)
+				throw std::runtime_error("failure should be thrown.");
+			lifetimes[j] -= wear;
+		}
+	}		
+	if (opmode == MODE_OO || opmode == MODE_OF)
+		age[i] += duration;
+}
+
+void ComponentStateArrays::AdvanceDowntime(int i, double time, operating_mode mode)
+{
+    //moves component i forward in time while the plant is down, or on standby
+	//if the repair mode is "S".
+	if (operational[i])
+		return;
+	if (CanBeRepaired(i, mode))
+	{
+		downtime_remaining[i] -= time;
+		if (downtime_remaining[i] <= 0.0)
+		{
+			downtime_remaining[i] = 0.0;
+			operational[i] = 1;
+			new_repair[i] = 1;
+		}
+	}
+}
+
+double ComponentStateArrays::AgeEfficiency(int i) const
+{
+	/*
+	returns impact of turbine aging on efficiency.  Source:
+	Staffel 2014 (notes that previous studies and techincal 
+	reports indicate a decrease in efficiency of 0.15%-0.55%
+	per year of operation.) and anecdotal evidence from a 
+	partner that the manufacturer specs indicate a decrease
+	of about 0.2% per year.  
+	*/
+	return 1.0 - (age[i] * 0.002 / 5000);  //source: anecdotal; Staffel 2014 cites 0.15%-0.55% decline in efficiency per year.
+}
+
+double ComponentStateArrays::AgeCapacity(int i) const
+{
+	/*
+	returns impact of turbine aging on capacity.  Source:
+	Diakunchuk 1992; this is for gas engines, but cites
+	a 1% decrease in efficiency = ~2.5% decrease in power.
+	Need to verify if this makes sense for a steam turbine too.
+	*/
+	return 1.0 - (age[i] * 0.005 / 5000); 
+}
+
+//##################################################################################
+
 Component::Component()
+	: m_parent_failure_events(NULL), m_state(NULL), m_index(-1)
 {}
 
 Component::Component(std::string name, std::string type,
 		//std::string dist_type, double failure_alpha, double failure_beta, 
 		double mean_repair_time, double repair_cooldown_time,
-		std::unordered_map< std::string, failure_event > *failure_events,
+		FailureEventStore *failure_events,
 		double capacity_reduction, double efficiency_reduction, double repair_cost, std::string repair_mode,
-		std::vector<std::string> *failure_event_labels,
 		bool reset_hazard_rate)
 {
     /*
@@ -46,13 +448,15 @@ Component::Component(std::string name, std::string type,
     type -- component type description
     repair_rate -- rate at which repairs take place (events/h)
     repair_cooldown_time -- added required downtime for repair (h)
-	failure_events -- parent failure events dictionary 
+	failure_events -- parent failure event store
 	capacity_reduction -- reduction in cycle capacity if component fails (fraction)
 	efficiency_reduction -- reduction in cycle capacity if component fails (fraction)
     repair_cost -- dollar cost of repairs, not including revenue lost ($)
     repair_mode -- indicator of in which modes the component may be repaired
-	failure_event_labels -- keys to parent failure events dictionary
 	reset_hazard_rate -- true if a repair resets the hazard rate, false o.w.
+
+	The component's state is held by its parent plant; it is usable once 
+	SetParentState() has been called.
     */
 
     if( name == "MAINTENANCE" )
@@ -61,38 +465,64 @@ Component::Component(std::string name, std::string type,
 	m_failure_types = {};
     m_name = name;
     m_type = type;
+	m_type_code = ComponentTypeFromString(type);
     m_repair_cost = repair_cost;
 	m_capacity_reduction = capacity_reduction;
 	m_efficiency_reduction = efficiency_reduction;
-	m_repair_mode = repair_mode;
+	m_repair_mode = RepairModeFromString(repair_mode);
 	m_mean_repair_time = mean_repair_time;
-	m_new_failure = false;
-	m_new_repair = false;
 	m_reset_hazard_rate = reset_hazard_rate;
 
-	m_status.hazard_rate = 1.0;
-    m_status.downtime_remaining = 0.0;
-	m_status.operational = true;
-	m_status.repair_event_time = 0.0;
-	m_status.age = 0.0;
-	m_status.lifetimes = {};
-
 	Distribution *edist = new ExponentialDist(mean_repair_time, repair_cooldown_time, "exponential");
 	m_repair_dist = (ExponentialDist *) edist;
 
     m_parent_failure_events = failure_events;
-	m_parent_failure_event_labels = failure_event_labels;
+	m_state = NULL;
+	m_index = -1;
 }
 
 
 void Component::ReadStatus( ComponentStatus &status )
 {
-	m_status.hazard_rate =  status.hazard_rate;
-    m_status.downtime_remaining = status.downtime_remaining;
-	m_status.operational = (m_status.downtime_remaining < 1e-8);
-	m_status.repair_event_time = status.repair_event_time;
-	m_status.age = status.age;
-	m_status.lifetimes = status.lifetimes;
+	m_state->hazard_rate[m_index] =  status.hazard_rate;
+    m_state->downtime_remaining[m_index] = status.downtime_remaining;
+	m_state->operational[m_index] = (m_state->downtime_remaining[m_index] < 1e-8);
+	m_state->repair_event_time[m_index] = status.repair_event_time;
+	m_state->age[m_index] = status.age;
+	size_t n = std::min(m_failure_types.size(), status.lifetimes.size());
+	for (size_t j = 0; j < n; j++)
+		Lifetime(j) = status.lifetimes.at(j);
+}
+
+void Component::SetParentState(
+	FailureEventStore *failure_events, 
+	ComponentStateArrays *state, 
+	int index
+)
+{
+	/*
+	Points the component at the failure event store and component state 
+	arrays of its parent plant, and sets its position in the plant.  Required 
+	when the component is added to a plant, and whenever the parent plant is 
+	copied, as the copy must use its own containers.
+	*/
+	m_parent_failure_events = failure_events;
+	m_state = state;
+	m_index = index;
+}
+
+double &Component::Lifetime(size_t j)
+{
+	/* reference to the lifetime or probability of failure type j. */
+	if (j >= m_failure_types.size())
+		throw std::out_of_range("failure type index out of range.");
+	return m_state->lifetimes[m_state->life_offset[m_index] + j];
+}
+
+int Component::GetIndex()
+{
+	/* accessor for the component's position in the parent plant. */
+	return m_index;
 }
         
 std::string Component::GetName()
@@ -108,6 +538,18 @@ std::string Component::GetType()
 	return m_type;
 }
 
+component_type Component::GetTypeCode()
+{
+	/* accessor for the component's type code. */
+	return m_type_code;
+}
+
+repair_mode Component::GetRepairMode()
+{
+	/* accessor for the modes in which the component may be repaired. */
+	return m_repair_mode;
+}
+
 std::vector<FailureType> Component::GetFailureTypes()
 {
 	/* accessor for vector of failure types/modes for the component. */
@@ -142,14 +584,16 @@ void Component::AddFailureMode(
 	alpha -- numeric parameter for distribution
 	beta -- numeric parameter for distribution
 	*/
+	if (m_state == NULL)
+		throw std::runtime_error("Failure modes may only be added to a component within a plant.");
 	m_failure_types.push_back(FailureType(component, id, failure_mode, dist_type, alpha, beta));
-	m_status.lifetimes.push_back(1.);
+	m_state->AddFailureType(m_index, m_failure_types.back().GetFailureModeEnum());
 }
         
 double Component::GetHazardRate()
 {
 	/* Acessor to component's current hazard rate. */
-	return m_status.hazard_rate;
+	return m_state->hazard_rate[m_index];
 }
 
     
@@ -185,29 +629,23 @@ double Component::GetEfficiencyReduction()
 double Component::GetEfficiency(bool override)
 {
 	/*
-	returns impact of turbine aging on efficiency.  Source:
-	Staffel 2014 (notes that previous studies and techincal 
-	reports indicate a decrease in efficiency of 0.15%-0.55%
-	per year of operation.) and anecdotal evidence from a 
-	partner that the manufacturer specs indicate a decrease
-	of about 0.2% per year.  
+	returns impact of turbine aging on efficiency; see 
+	ComponentStateArrays::AgeEfficiency().
 	*/
 	if (!IsOperational() && !override)
 		throw std::runtime_error("Efficiency checked for a non-operating component");
-	return 1.0 - (m_status.age * 0.002 / 5000);  //source: anecdotal; Staffel 2014 cites 0.15%-0.55% decline in efficiency per year.
+	return m_state->AgeEfficiency(m_index);
 }
 
 double Component::GetCapacity(bool override)
 {
 	/*
-	returns impact of turbine aging on capacity.  Source:
-	Diakunchuk 1992; this is for gas engines, but cites
-	a 1% decrease in efficiency = ~2.5% decrease in power.
-	Need to verify if this makes sense for a steam turbine too.
+	returns impact of turbine aging on capacity; see 
+	ComponentStateArrays::AgeCapacity().
 	*/
 	if (!IsOperational() && !override)
 		throw std::runtime_error("Capacity checked for a non-operating component");
-	return 1.0 - (m_status.age * 0.005 / 5000); 
+	return m_state->AgeCapacity(m_index);
 }
 
 double Component::GetCooldownTime()
@@ -223,17 +661,17 @@ bool Component::IsOperational()
 	/*
 	Accessor to boolean indicator of a component being operational.
 	*/
-	return m_status.operational;
+	return m_state->operational[m_index];
 }
 
 bool Component::IsNewFailure()
 {
-	return m_new_failure;
+	return m_state->new_failure[m_index] != 0;
 }
 
 bool Component::IsNewRepair()
 {
-	return m_new_repair;
+	return m_state->new_repair[m_index] != 0;
 }
 
 void Component::SetResetHazardRatePolicy(bool reset_hazard)
@@ -241,10 +679,16 @@ void Component::SetResetHazardRatePolicy(bool reset_hazard)
 	m_reset_hazard_rate = reset_hazard;
 }
 
+bool Component::GetResetHazardRatePolicy()
+{
+	/* retval -- true if a repair resets the hazard rate, false o.w. */
+	return m_reset_hazard_rate;
+}
+
 void Component::ResetFailureAndRepairFlags()
 {
-	m_new_repair = false;
-	m_new_failure = false;
+	m_state->new_repair[m_index] = 0;
+	m_state->new_failure[m_index] = 0;
 }
         
 void Component::Shutdown(double time)
@@ -255,10 +699,10 @@ void Component::Shutdown(double time)
     time -- required downtime for maintenance
     retval -- None 
     */
-	m_status.operational = false;
-	m_new_failure = true;
-    m_status.downtime_remaining = time;
-	m_status.repair_event_time = time;
+	m_state->operational[m_index] = 0;
+	m_state->new_failure[m_index] = 1;
+    m_state->downtime_remaining[m_index] = time;
+	m_state->repair_event_time[m_index] = time;
 }
 
 void Component::PerformMaintenance(double penalty_reduction)
@@ -269,8 +713,8 @@ void Component::PerformMaintenance(double penalty_reduction)
 
 	penalty_reduction -- maintenance-based hazard rate reduction.
 	*/
-	m_status.hazard_rate = std::max(1.0,
-		m_status.hazard_rate - penalty_reduction
+	m_state->hazard_rate[m_index] = std::max(1.0,
+		m_state->hazard_rate[m_index] - penalty_reduction
 	);
 }
 
@@ -282,32 +726,32 @@ void Component::RestoreComponent(bool reset_age)
 
 	reset_age -- indicator to set age to zero on repair
 	*/
-	m_status.operational = true;
-	m_status.downtime_remaining = 0.0;
-	m_status.repair_event_time = 0.0;
+	m_state->operational[m_index] = 1;
+	m_state->downtime_remaining[m_index] = 0.0;
+	m_state->repair_event_time[m_index] = 0.0;
 	if (reset_age)
-		m_status.age = 0.0;
+		m_state->age[m_index] = 0.0;
 }
 
         
 void Component::ResetHazardRate()
 {
 	/* Sets hazard rate to one, i.e., treats component as good as new. */
-	m_status.hazard_rate = 1.;
+	m_state->hazard_rate[m_index] = 1.;
 }
 
     
 double Component::GetDowntimeRemaining()
 {
 	/* accessor to downtime remaining before a component is online. */
-	return m_status.downtime_remaining;
+	return m_state->downtime_remaining[m_index];
 }
 
         
 void Component::SetDowntimeRemaining(double time)
 {
 	/* mutator for downtime remaining before a component is online. */
-	m_status.downtime_remaining = time;
+	m_state->downtime_remaining[m_index] = time;
 }
 
         
@@ -320,13 +764,19 @@ void Component::GenerateTimeToRepair(WELLFiveTwelve &gen)
     gen -- random U[0,1] generator object
     retval -- lifetime in adjusted hours of operation
     */
-    m_status.downtime_remaining = m_repair_dist->GetVariate(gen);
-	m_status.repair_event_time = m_status.downtime_remaining*1.0;
-	//std::cerr << "NEW FAILURE - DOWNTIME: " << std::to_string(m_status.downtime_remaining) << "\n";
+    m_state->downtime_remaining[m_index] = m_repair_dist->GetVariate(gen);
+	m_state->repair_event_time[m_index] = m_state->downtime_remaining[m_index]*1.0;
+	//std::cerr << "NEW FAILURE - DOWNTIME: " << std::to_string(m_state->downtime_remaining[m_index]) << "\n";
 }
 
         
 double Component::HoursToFailure(double ramp_mult, std::string mode)
+{
+	/* string-based adapter; see HoursToFailure(double, operating_mode). */
+	return HoursToFailure(ramp_mult, OperatingModeFromString(mode));
+}
+
+double Component::HoursToFailure(double ramp_mult, operating_mode mode)
 {
     /* 
     Returns number of hours of operation that would lead to failure 
@@ -336,20 +786,7 @@ double Component::HoursToFailure(double ramp_mult, std::string mode)
 	mode -- operating mode
     retval - floating point number indicating hours of operation to failure
     */
-    if( ramp_mult == 0 )
-        return INFINITY;
-	double hours = INFINITY;
-	for (size_t j = 0; j < m_failure_types.size(); j++)
-	{
-		if (m_failure_types.at(j).GetFailureMode() == mode)
-		{
-			hours = std::min(hours, 
-				m_status.lifetimes.at(j) / 
-				(m_status.hazard_rate * ramp_mult)
-				);
-		}
-	}
-    return hours;
+	return m_state->HoursToFailure(m_index, ramp_mult, mode);
 }
 
 
@@ -361,6 +798,20 @@ void Component::TestForBinaryFailure(
 	WELLFiveTwelve &binary_gen,
 	int scen_index
 )
+{
+	/* string-based adapter; see TestForBinaryFailure(operating_mode, ...). */
+	TestForBinaryFailure(OperatingModeFromString(mode), t, life_gen, 
+		repair_gen, binary_gen, scen_index);
+}
+
+void Component::TestForBinaryFailure(
+	operating_mode mode, 
+	int t,
+	WELLFiveTwelve &life_gen,
+	WELLFiveTwelve &repair_gen,
+	WELLFiveTwelve &binary_gen,
+	int scen_index
+)
 {
 	/*
 	Tests for failures of components for the start of online mode
@@ -376,13 +827,14 @@ void Component::TestForBinaryFailure(
 	failure events
 	*/
 	double var = 0.0;
+	size_t off = m_state->life_offset[m_index];
 	for (int j = 0; j < m_failure_types.size(); j++)
 	{
-		if (m_failure_types.at(j).GetFailureMode() == mode)
+		if (m_state->fail_mode[off + j] == mode)
 		{
 			var = binary_gen.getVariate();
-			if (var <= m_status.lifetimes.at(j)
-				* m_status.hazard_rate)
+			if (var <= m_state->lifetimes[off + j]
+				* m_state->hazard_rate[m_index])
 			{
 				GenerateFailure(life_gen, repair_gen, t, j, scen_index);
 			}
@@ -401,6 +853,23 @@ void Component::TestForFailure(
 	std::string mode, 
 	int scen_index
 )
+{
+	/* string-based adapter; see TestForFailure(..., operating_mode, ...). */
+	TestForFailure(time, ramp_mult, life_gen, repair_gen, binary_gen, t,
+		hazard_increase, OperatingModeFromString(mode), scen_index);
+}
+
+void Component::TestForFailure(
+	double time, 
+	double ramp_mult,
+	WELLFiveTwelve &life_gen,
+	WELLFiveTwelve &repair_gen,
+	WELLFiveTwelve &binary_gen,
+	int t, 
+	double hazard_increase, 
+	operating_mode mode, 
+	int scen_index
+)
 {
 	/*
 	Generates failure events under the provided dispatch, if there is not  
@@ -409,34 +878,36 @@ void Component::TestForFailure(
 	*/
 	if (!IsOperational())
 		throw std::runtime_error("Testing a non-operational component for failure.");
-	if (mode == "OFF")
+	if (mode == MODE_OFF)
 		return;
-	std::string opmode;
-	if (mode == "OS")
+	operating_mode opmode;
+	if (mode == MODE_OS)
 	// if starting standby or online, test for fail on start, 
 	// then operate as if in the first hour of that mode to test
 	// for failures during the time period.
 	{
 		TestForBinaryFailure(mode, t, life_gen, repair_gen, binary_gen, scen_index);
-		opmode = "OF";
+		opmode = MODE_OF;
 	}
-	else if (mode == "SS")
+	else if (mode == MODE_SS)
 	{
 		TestForBinaryFailure(mode, t, life_gen, repair_gen, binary_gen, scen_index);
-		opmode = "SF";
+		opmode = MODE_SF;
 	}
 	else
 		opmode = mode;
+	size_t off = m_state->life_offset[m_index];
 	for (int j = 0; j < m_failure_types.size(); j++)
 	{
-		if (m_failure_types.at(j).GetFailureMode() == opmode || m_failure_types.at(j).GetFailureMode() == "ALL")
+		operating_mode fmode = m_state->fail_mode[off + j];
+		if (fmode == opmode || fmode == MODE_ALL)
 		{
-			if (time * (m_status.hazard_rate + hazard_increase) * ramp_mult > m_status.lifetimes.at(j))
+			if (time * (m_state->hazard_rate[m_index] + hazard_increase) * ramp_mult > m_state->lifetimes[off + j])
 				GenerateFailure(life_gen, repair_gen, t, j, scen_index);
 		}
-		if (m_failure_types.at(j).GetFailureMode() == "O" && (opmode == "OO" || opmode == "OF" ) )
+		if (fmode == MODE_O && (opmode == MODE_OO || opmode == MODE_OF ) )
 		{
-			if (time * (m_status.hazard_rate + hazard_increase) * ramp_mult > m_status.lifetimes.at(j))
+			if (time * (m_state->hazard_rate[m_index] + hazard_increase) * ramp_mult > m_state->lifetimes[off + j])
 				GenerateFailure(life_gen, repair_gen, t, j, scen_index);
 		}
 	}
@@ -451,56 +922,26 @@ void Component::Operate(
 	double hazard_increase, 
 	std::string mode
 )
+{
+	/* string-based adapter; see Operate(..., operating_mode). */
+	Operate(duration, ramp_mult, read_only, hazard_increase, 
+		OperatingModeFromString(mode));
+}
+
+void Component::Operate(
+	double duration, 
+	double ramp_mult, 
+	bool read_only, 
+	double hazard_increase, 
+	operating_mode mode
+)
 {
     /* 
     assumes operation for a given period of time, with 
-    no permanent change to the hazard rate.
-    duration -- length of time of operation
-    ramp_mult -- degradation multiplier due to ramping
-    gen -- random U[0,1] variate generator object
-    read_only -- indicates whether to generate a failure event if 
-        life_remaining falls below 0 during operation
-    t -- period index
-    retval -- None
+    no permanent change to the hazard rate; see 
+	ComponentStateArrays::Operate().
     */
-    if( ! IsOperational() )
-        throw std::runtime_error("can't operate a plant in downtime.");
-	m_status.hazard_rate += hazard_increase;
-	std::string opmode;
-	//if starting a mode, operate as if
-	//in the first hour of operation for that mode to degrade lifetimes.
-	if (mode == "OS")
-		// if starting standby or online, test for fail on start, 
-		// then operate as if in the first hour of that mode to test
-		// for failures during the time period.
-	{
-		//TestForBinaryFailure(mode, t, gen, scen_index);
-		opmode = "OF";
-	}
-	else if (mode == "SS")
-	{
-		//TestForBinaryFailure(mode, t, gen, scen_index);
-		opmode = "SF";
-	}
-	else
-		opmode = mode;
-	for (size_t j = 0; j < m_failure_types.size(); j++)
-	{
-		if (m_failure_types.at(j).GetFailureMode() == opmode || (opmode != "OFF" && m_failure_types.at(j).GetFailureMode() == "ALL"))
-		{
-			if (duration * m_status.hazard_rate * ramp_mult > m_status.lifetimes.at(j) && !read_only)
-				throw std::runtime_error("failure should be thrown.");
-			m_status.lifetimes.at(j) -= (duration * m_status.hazard_rate * ramp_mult);
-		}
-		if (m_failure_types.at(j).GetFailureMode() == "O" && (opmode == "OO" || opmode == "OF"))
-		{
-			if (duration * m_status.hazard_rate * ramp_mult > m_status.lifetimes.at(j) && !read_only)
-				throw std::runtime_error("failure should be thrown.");
-			m_status.lifetimes.at(j) -= (duration * m_status.hazard_rate * ramp_mult);
-		}
-	}		
-	if (opmode == "OO" || opmode == "OF")
-		m_status.age += duration;
+	m_state->Operate(m_index, duration, ramp_mult, read_only, hazard_increase, mode);
 }
          
 void Component::ReadFailure(double downtime, double life_remaining, 
@@ -514,9 +955,9 @@ void Component::ReadFailure(double downtime, double life_remaining,
 	reset_hazard -- true if the repair resets the hazard rate, false o.w.
     retval -- none
     */
-	m_status.operational = false;
+	m_state->operational[m_index] = 0;
     SetDowntimeRemaining(downtime);
-	m_status.lifetimes.at(fail_idx) = (life_remaining);
+	Lifetime(fail_idx) = (life_remaining);
 	if (m_reset_hazard_rate)
 	{
 		ResetHazardRate();
@@ -540,53 +981,49 @@ void Component::GenerateFailure(
 	fail_idx -- failure type (mode/part combination) that caused failure
     retval -- None
     */
-    m_status.operational = false;
-	m_new_failure = true;
+    m_state->operational[m_index] = 0;
+	m_state->new_failure[m_index] = 1;
     GenerateTimeToRepair(repair_gen);
-	double labor = m_status.downtime_remaining - GetCooldownTime();
-	m_status.lifetimes.at(fail_idx) = m_failure_types.at(fail_idx).GenerateFailureVariate(life_gen);
+	double labor = m_state->downtime_remaining[m_index] - GetCooldownTime();
+	Lifetime(fail_idx) = m_failure_types.at(fail_idx).GenerateFailureVariate(
+		life_gen, m_state->log_likelihood_ratio
+	);
 	/* in a single special case, superheaters have an additional cooldown 
 	time of 48 hours more than other heat exchangers in the salt-to-steam train.
 	*/
-	if (m_type == "Salt-to-steam train" && fail_idx == 3)
+	if (m_type_code == COMPONENT_SALT_STEAM_TRAIN && fail_idx == 3)
 	{
-		m_status.downtime_remaining += 48.;
-		m_status.repair_event_time += 48.;
+		m_state->downtime_remaining[m_index] += 48.;
+		m_state->repair_event_time[m_index] += 48.;
 	}
 	if (m_reset_hazard_rate)
 	{
 		ResetHazardRate();
 	}
     //add a new failure to the parent (CSPPlant) failure queue
-	std::string label = "S"+std::to_string(scen_index)+"T"+std::to_string(t)+GetName()+"F"+std::to_string(fail_idx);
-    (*m_parent_failure_events)[label] = failure_event(
-		t, GetName(), fail_idx, m_status.downtime_remaining, labor,
-		m_status.lifetimes.at(fail_idx), scen_index
-		);
-	(*m_parent_failure_event_labels).push_back(label);
-	//std::cerr << "FAILURE EVENT GENERATED. downtime: " << std::to_string(m_status.downtime_remaining) << " life_rem: " << std::to_string(m_failure_types.at(fail_idx).GetLifeOrProb()) << " fail idx: " << std::to_string(fail_idx) << " reset hazard rate: " << std::to_string(true) << "\n";
+	m_parent_failure_events->Add(
+		FailureEventStore::FailureKey(scen_index, t, m_index, fail_idx),
+		failure_event(
+			t, m_name, fail_idx, m_state->downtime_remaining[m_index], labor,
+			Lifetime(fail_idx), scen_index
+		)
+	);
+	//std::cerr << "FAILURE EVENT GENERATED. downtime: " << std::to_string(m_state->downtime_remaining[m_index]) << " life_rem: " << std::to_string(m_failure_types.at(fail_idx).GetLifeOrProb()) << " fail idx: " << std::to_string(fail_idx) << " reset hazard rate: " << std::to_string(true) << "\n";
 }
 
 bool Component::CanBeRepaired(std::string mode)
 {
-	/*
-	determines whether or not the component can be repaired.
-	if the plant is off, or the component can be repaired for any mode,
-	then return true.
+	/* string-based adapter; see CanBeRepaired(operating_mode). */
+	return CanBeRepaired(OperatingModeFromString(mode));
+}
 
-	mode -- operating mode indicator
+bool Component::CanBeRepaired(operating_mode mode)
+{
+	/*
+	determines whether or not the component can be repaired; see
+	ComponentStateArrays::CanBeRepaired().
 	*/
-	if (mode == "OFF" || m_repair_mode == "A")
-	{
-		return true;
-	}
-	//if the plant is in standby and the component may be repaired in standby,
-	//return true.
-	if (m_repair_mode == "S" && (mode == "SS" || mode == "SF" || mode == "SO") )
-	{
-		return true;
-	}		
-	return false;
+	return m_state->CanBeRepaired(m_index, mode);
 }
 
 void Component::ResetDowntime()
@@ -595,31 +1032,29 @@ void Component::ResetDowntime()
 	Resets downtime; used if plant comes online before repair is completed 
 	and component cannot be repaired while the plant is online.
 	*/
-	m_status.downtime_remaining = m_status.repair_event_time*1.0;
+	m_state->downtime_remaining[m_index] = m_state->repair_event_time[m_index]*1.0;
 }
         
 void Component::AdvanceDowntime(double time, std::string mode)
+{
+	/* string-based adapter; see AdvanceDowntime(double, operating_mode). */
+	AdvanceDowntime(time, OperatingModeFromString(mode));
+}
+
+void Component::AdvanceDowntime(double time, operating_mode mode)
 {
     //moves forward in time while the plant is down, or on standby
 	//if the repair mode is "S".
-	if (m_status.operational)
-		return;
-	if (CanBeRepaired(mode))
-	{
-		m_status.downtime_remaining -= time;
-		if (m_status.downtime_remaining <= 0.0)
-		{
-			m_status.downtime_remaining = 0.0;
-			m_status.operational = true;
-			m_new_repair = true;
-		}
-	}
+	m_state->AdvanceDowntime(m_index, time, mode);
 }
 
 std::vector<double> Component::GetLifetimesAndProbs()
 {
 	//returns a vector of component lifetimes/probabilities.
-	return m_status.lifetimes;
+	return std::vector<double>(
+		m_state->lifetimes.begin() + m_state->life_offset[m_index],
+		m_state->lifetimes.begin() + m_state->life_offset[m_index + 1]
+	);
 }
             
 void Component::GenerateInitialLifesAndProbs(WELLFiveTwelve &gen)
@@ -636,14 +1071,80 @@ void Component::GenerateInitialLifesAndProbs(WELLFiveTwelve &gen)
 	}
 }
 
+void Component::SampleLifesAndProbs(WELLFiveTwelve &gen, int sample, int num_samples, 
+	uint32_t design)
+{
+	/*
+	Draws new lifetimes and failure probabilities for a component of a 
+	scenario, as if it were brand new, with importance sampling of the 
+	failure types set up for it.  The component's hazard 
+	rate, age and downtime are kept.
+	gen -- RNG Engine
+	sample -- index of the scenario in a Latin hypercube sample of the 
+		lifetimes of all failure types of the plant, each failure type being 
+		a dimension; negative for no stratification
+	num_samples -- size of the Latin hypercube sample
+	design -- key of the Latin hypercube design; see LatinHypercubeStratum()
+	*/
+	for (int i = 0; i < (int)m_failure_types.size(); i++)
+	{
+		double life_prob;
+		if (sample < 0)
+			life_prob = m_failure_types.at(i).GenerateFailureVariate(
+				gen, m_state->log_likelihood_ratio
+			);
+		else
+			life_prob = m_failure_types.at(i).GenerateStratifiedVariate(
+				gen, 
+				LatinHypercubeStratum(sample, (int)m_state->life_offset[m_index] + i, 
+					num_samples, design),
+				num_samples, m_state->log_likelihood_ratio
+			);
+		SetFailLifeOrProb(i, life_prob);
+	}
+}
+
+double Component::GetRareFailureProbability(double horizon, double max_prob)
+{
+	/*
+	retval -- sum of the probabilities of failing within 'horizon' hours of
+		the failure types for which it is more than zero and at most 
+		max_prob; see FailureType::GetHorizonProbability()
+	*/
+	double sum = 0.;
+	for (size_t i = 0; i < m_failure_types.size(); i++)
+	{
+		double p = m_failure_types.at(i).GetHorizonProbability(horizon);
+		if (p > 0. && p <= max_prob)
+			sum += p;
+	}
+	return sum;
+}
+
+void Component::SetImportanceSampling(double scale, double horizon, double max_prob)
+{
+	/*
+	Sets up importance sampling of the lifetimes of the failure types with 
+	a probability of failing within 'horizon' hours of at most max_prob, 
+	and turns it off for the others; see 
+	FailureType::SetImportanceSampling().
+	*/
+	for (size_t i = 0; i < m_failure_types.size(); i++)
+	{
+		FailureType &f = m_failure_types.at(i);
+		bool rare = f.GetHorizonProbability(horizon) <= max_prob;
+		f.SetImportanceSampling(rare ? scale : 1., horizon);
+	}
+}
+
 ComponentStatus Component::GetState()
 {
     //returns current state as a ComponentStatus.
 	return (
 		ComponentStatus(
-			GetLifetimesAndProbs(), m_status.hazard_rate*1.0,
-			m_status.downtime_remaining*1.0, m_status.repair_event_time*1.0,
-			m_status.age * 1.0
+			GetLifetimesAndProbs(), m_state->hazard_rate[m_index]*1.0,
+			m_state->downtime_remaining[m_index]*1.0, m_state->repair_event_time[m_index]*1.0,
+			m_state->age[m_index] * 1.0
 			)
 		); 
 }
@@ -656,11 +1157,11 @@ void Component::Reset(WELLFiveTwelve &gen)
 
 	gen -- RNG Engine
 	*/
-	m_status.downtime_remaining = 0.;
-	m_status.hazard_rate = 1.;
-	m_status.operational = true;
-	m_status.repair_event_time = 0.;
-	m_status.age = 0.;
+	m_state->downtime_remaining[m_index] = 0.;
+	m_state->hazard_rate[m_index] = 1.;
+	m_state->operational[m_index] = 1;
+	m_state->repair_event_time[m_index] = 0.;
+	m_state->age[m_index] = 0.;
 	GenerateInitialLifesAndProbs(gen);
 	ResetFailureAndRepairFlags();
 }
@@ -673,6 +1174,6 @@ fail_idx -- index of failure to mutate
 life_prob -- value to assign to given lifetime / probability of failure
 */
 {
-	m_status.lifetimes.at(fail_idx) = life_prob;
+	Lifetime(fail_idx) = life_prob;
 }
 
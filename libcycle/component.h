@@ -4,10 +4,12 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
 
 #include "well512.h"
 #include "distributions.h"
 #include "failure.h"
+#include "modes.h"
 
 //##################################################################################
 
@@ -25,7 +27,49 @@ struct failure_event
 	failure_event(int time, std::string component, int fail_idx, double duration,
 		double labor, double new_life, int scen_index);
 
-    std::string print();
+    std::string print() const;
+};
+
+//##################################################################################
+
+/*
+Failure events recorded over a simulation, in order of occurrence.  Events are
+indexed by a packed 64-bit key built from the scenario, period, component index
+and failure index, so that the simulation never builds string labels to look
+up an event; labels are generated on request for file output only.
+*/
+class FailureEventStore
+{
+	std::vector< failure_event > m_events;
+	std::vector< uint64_t > m_keys;
+	std::unordered_map< uint64_t, size_t > m_index;
+	std::unordered_map< uint64_t, int > m_period_counts;
+
+	static uint64_t PackKey(int scenario, int t, int component_slot, int event_slot);
+
+public:
+
+	static uint64_t FailureKey(int scenario, int t, int component_idx, int fail_idx);
+
+	static uint64_t SwitchKey(int scenario, int t, int component_idx);
+
+	static uint64_t MaintenanceKey(int scenario, int t, bool planned);
+
+	void Add(uint64_t key, const failure_event &e);
+
+	const failure_event *Find(uint64_t key) const;
+
+	bool HasEventsInPeriod(int scenario, int t) const;
+
+	size_t Size() const;
+
+	const failure_event &At(size_t i) const;
+
+	std::string GetLabel(size_t i) const;
+
+	void Truncate(size_t n);
+
+	void Clear();
 };
 
 //##################################################################################
@@ -45,6 +89,82 @@ struct ComponentStatus
 			double _downtime, double _repair_event_time, double _age);
 };
 
+//##################################################################################
+
+enum component_type
+{
+	COMPONENT_OTHER,
+	COMPONENT_CONDENSER_TRAIN,
+	COMPONENT_CONDENSER_FAN,
+	COMPONENT_SALT_STEAM_TRAIN,
+	COMPONENT_FEEDWATER_HEATER,
+	COMPONENT_SALT_PUMP,
+	COMPONENT_BOILER_PUMP,
+	COMPONENT_WATER_PUMP,
+	COMPONENT_TURBINE
+};
+
+component_type ComponentTypeFromString(const std::string &type);
+
+bool IsPumpType(component_type type);
+
+//##################################################################################
+
+/*
+State of all components in a plant, stored as parallel arrays indexed by
+component position (or, for lifetimes and failure modes, by failure type, with
+the failure types of component i stored in [life_offset[i], life_offset[i+1])).
+The per-period loops of the power cycle iterate over these arrays directly;
+each Component refers to its entries by index.
+*/
+struct ComponentStateArrays
+{
+	std::vector< component_type > type;
+	std::vector< repair_mode > repair;
+	std::vector< double > capacity_reduction;
+	std::vector< double > efficiency_reduction;
+	std::vector< unsigned char > operational;
+	std::vector< unsigned char > new_failure;
+	std::vector< unsigned char > new_repair;
+	std::vector< double > hazard_rate;
+	std::vector< double > downtime_remaining;
+	std::vector< double > repair_event_time;
+	std::vector< double > age;
+	std::vector< size_t > life_offset;
+	std::vector< double > lifetimes;
+	std::vector< operating_mode > fail_mode;
+	double log_likelihood_ratio; //of the lifetimes drawn under importance sampling; 0 otherwise
+
+	ComponentStateArrays();
+
+	int AddComponent(component_type ctype, repair_mode rmode,
+		double cap_reduction, double eff_reduction);
+
+	void AddFailureType(int i, operating_mode mode);
+
+	size_t Size() const;
+
+	void Clear();
+
+	void SaveState(std::vector< double > &values, std::vector< unsigned char > &flags) const;
+
+	void RestoreState(const std::vector< double > &values, 
+		const std::vector< unsigned char > &flags);
+
+	bool CanBeRepaired(int i, operating_mode mode) const;
+
+	double HoursToFailure(int i, double ramp_mult, operating_mode mode) const;
+
+	void Operate(int i, double duration, double ramp_mult, bool read_only,
+		double hazard_increase, operating_mode mode);
+
+	void AdvanceDowntime(int i, double time, operating_mode mode);
+
+	double AgeEfficiency(int i) const;
+
+	double AgeCapacity(int i) const;
+};
+
 
 
 
@@ -61,20 +181,22 @@ class Component
     double m_repair_cost;
     std::string m_name;
     std::string m_type;
+	component_type m_type_code;
 	double m_capacity_reduction;
 	double m_efficiency_reduction;
-	bool m_new_repair;
-	bool m_new_failure;
 	bool m_reset_hazard_rate;
 	double m_mean_repair_time;
-	std::string m_repair_mode; // "A"=Anytime; "S"=standby or downtime; "D"=downtime only
-    ComponentStatus m_status;
+	repair_mode m_repair_mode; // "A"=Anytime; "S"=standby or downtime; "D"=downtime only
 
-	std::unordered_map< std::string, failure_event > *m_parent_failure_events;
-	std::vector< std::string > *m_parent_failure_event_labels;
+	//state is held by the parent plant, at position m_index
+	FailureEventStore *m_parent_failure_events;
+	ComponentStateArrays *m_state;
+	int m_index;
 
 	Distribution *m_repair_dist;
 
+	double &Lifetime(size_t j);
+
 public:
 
     Component();
@@ -83,21 +205,32 @@ public:
 		std::string type, 
 		double mean_repair_time, 
 		double repair_cooldown_time,
-		std::unordered_map< std::string, failure_event > *failure_events, 
+		FailureEventStore *failure_events, 
 		double availability_reduction = 1.0, 
 		double efficiency_reduction = 1.0, 
 		double repair_cost = 0.0,
 		std::string repair_mode = "D", 
-		std::vector< std::string > *failure_event_labels = {},
 		bool reset_hazard_rate = true
 		);
 
     void ReadStatus( ComponentStatus &status );
+
+	void SetParentState(
+		FailureEventStore *failure_events, 
+		ComponentStateArrays *state, 
+		int index
+	);
+
+	int GetIndex();
         
     std::string GetName();
         
 	std::string GetType();
 
+	component_type GetTypeCode();
+
+	repair_mode GetRepairMode();
+
 	std::vector<FailureType> GetFailureTypes();
         
 	void AddFailureMode(
@@ -133,6 +266,8 @@ public:
 
 	void SetResetHazardRatePolicy(bool reset_hazard);
 
+	bool GetResetHazardRatePolicy();
+
 	void ResetFailureAndRepairFlags();
         
     void Shutdown(double time);
@@ -151,6 +286,8 @@ public:
         
     double HoursToFailure(double ramp_mult, std::string mode);
 
+	double HoursToFailure(double ramp_mult, operating_mode mode);
+
 	void TestForBinaryFailure(
 		std::string mode, 
 		int t,
@@ -159,6 +296,15 @@ public:
 		WELLFiveTwelve &binary_gen,
 		int scen_index
 	);
+
+	void TestForBinaryFailure(
+		operating_mode mode, 
+		int t,
+		WELLFiveTwelve &life_gen,
+		WELLFiveTwelve &repair_gen,
+		WELLFiveTwelve &binary_gen,
+		int scen_index
+	);
 	
 	void TestForFailure(
 		double time,
@@ -171,6 +317,18 @@ public:
 		std::string mode,
 		int scen_index
 	);
+
+	void TestForFailure(
+		double time,
+		double ramp_mult,
+		WELLFiveTwelve &life_gen,
+		WELLFiveTwelve &repair_gen,
+		WELLFiveTwelve &binary_gen,
+		int t,
+		double hazard_increase,
+		operating_mode mode,
+		int scen_index
+	);
          
     void Operate(
 		double duration,
@@ -179,6 +337,14 @@ public:
 		double hazard_increase, 
 		std::string mode
 	);
+
+	void Operate(
+		double duration,
+		double ramp_mult,
+		bool read_only,
+		double hazard_increase, 
+		operating_mode mode
+	);
         
     void ReadFailure(double downtime, double life_remaining, int fail_idx);
                 
@@ -192,13 +358,24 @@ public:
 
 	bool CanBeRepaired(std::string mode);
 
+	bool CanBeRepaired(operating_mode mode);
+
 	void ResetDowntime();
 
     void AdvanceDowntime(double time, std::string mode);
 
+	void AdvanceDowntime(double time, operating_mode mode);
+
 	std::vector<double> GetLifetimesAndProbs();
 
 	void GenerateInitialLifesAndProbs(WELLFiveTwelve &gen);
+
+	void SampleLifesAndProbs(WELLFiveTwelve &gen, int sample, int num_samples, 
+		uint32_t design);
+
+	double GetRareFailureProbability(double horizon, double max_prob);
+
+	void SetImportanceSampling(double scale, double horizon, double max_prob);
             
 	ComponentStatus GetState();
 
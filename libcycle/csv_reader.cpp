@@ -0,0 +1,315 @@
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <stdexcept>
+
+#include "csv_reader.h"
+
+static inline bool IsBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline bool IsDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+//exact powers of ten representable as doubles
+static const double EXACT_POWERS_OF_TEN[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+//##################################################################################
+
+CsvReader::CsvReader(char delimiter)
+{
+	m_delimiter = delimiter;
+	m_next = NULL;
+	m_end = NULL;
+	m_field = NULL;
+	m_line_end = NULL;
+}
+
+void CsvReader::Open(const std::string &filename)
+{
+	/*
+	Opens a file for reading, positioned before its first line.
+	filename -- path of the file
+	*/
+	Close();
+	m_file.Open(filename);
+	m_next = m_file.GetData();
+	m_end = m_next + m_file.GetSize();
+}
+
+void CsvReader::Close()
+{
+	m_file.Close();
+	m_next = NULL;
+	m_end = NULL;
+	m_field = NULL;
+	m_line_end = NULL;
+}
+
+bool CsvReader::NextLine()
+{
+	/*
+	Moves to the next line of the file.
+	retval -- false if there are no lines left
+	*/
+	m_field = NULL;
+	if (m_next == NULL || m_next >= m_end)
+		return false;
+	const char *nl = (const char*)std::memchr(m_next, '\n', m_end - m_next);
+	m_line_end = nl == NULL ? m_end : nl;
+	m_field = m_next;
+	m_next = nl == NULL ? m_end : nl + 1;
+	return true;
+}
+
+size_t CsvReader::CountFields() const
+{
+	/* retval -- number of fields left in the current line */
+	if (m_field == NULL)
+		return 0;
+	size_t n = 1;
+	for (const char *p = m_field; p < m_line_end; p++)
+		if (*p == m_delimiter)
+			n++;
+	return n;
+}
+
+bool CsvReader::HasField() const
+{
+	return m_field != NULL;
+}
+
+bool CsvReader::NextField(const char *&first, const char *&last)
+{
+	/*
+	Consumes the next field of the current line.
+	first, last -- set to the bounds of the field, without surrounding blanks
+	retval -- false if there are no fields left
+	*/
+	if (m_field == NULL)
+		return false;
+	const char *p = (const char*)std::memchr(m_field, m_delimiter, m_line_end - m_field);
+	first = m_field;
+	last = p == NULL ? m_line_end : p;
+	m_field = p == NULL ? NULL : p + 1;
+	while (first < last && IsBlank(*first))
+		first++;
+	while (last > first && IsBlank(last[-1]))
+		last--;
+	return true;
+}
+
+void CsvReader::SkipField()
+{
+	const char *first, *last;
+	if (!NextField(first, last))
+		throw std::runtime_error("too few fields in line of " + m_file.GetFilename());
+}
+
+std::string CsvReader::GetString()
+{
+	/* retval -- the next field of the current line, as text */
+	const char *first, *last;
+	if (!NextField(first, last))
+		throw std::runtime_error("too few fields in line of " + m_file.GetFilename());
+	return std::string(first, last);
+}
+
+double CsvReader::GetDouble()
+{
+	/* retval -- the next field of the current line, as a number */
+	const char *first, *last;
+	double x;
+	if (!NextField(first, last))
+		throw std::runtime_error("too few fields in line of " + m_file.GetFilename());
+	if (ParseDouble(first, last, x) == first)
+		throw std::runtime_error("invalid number \"" + std::string(first, last) +
+			"\" in " + m_file.GetFilename());
+	return x;
+}
+
+int CsvReader::GetInt()
+{
+	/* retval -- the next field of the current line, as an integer */
+	const char *first, *last;
+	int x;
+	if (!NextField(first, last))
+		throw std::runtime_error("too few fields in line of " + m_file.GetFilename());
+	if (ParseInt(first, last, x) == first)
+		throw std::runtime_error("invalid integer \"" + std::string(first, last) +
+			"\" in " + m_file.GetFilename());
+	return x;
+}
+
+size_t CsvReader::ReadColumns(const std::vector< std::vector<double>* > &columns,
+	size_t max_lines)
+{
+	/*
+	Reads the leading fields of the remaining lines into numeric columns,
+	one value per line and column.  Lines with fewer fields than columns
+	(e.g., blank lines) are skipped.
+	columns -- columns to append to, in the order of the fields
+	max_lines -- maximum number of lines to read, including skipped lines
+	retval -- number of lines read
+	*/
+	size_t ncol = columns.size();
+	//size the columns for the lines to be read
+	size_t nlines = 0;
+	for (const char *p = m_next; p != NULL && p < m_end && nlines < max_lines; nlines++)
+	{
+		p = (const char*)std::memchr(p, '\n', m_end - p);
+		if (p != NULL)
+			p++;
+	}
+	for (size_t j = 0; j < ncol; j++)
+		columns[j]->reserve(columns[j]->size() + nlines);
+
+	size_t n = 0;
+	while (n < max_lines && NextLine())
+	{
+		n++;
+		if (CountFields() < ncol)
+			continue;
+		for (size_t j = 0; j < ncol; j++)
+			columns[j]->push_back(GetDouble());
+	}
+	return n;
+}
+
+const char *CsvReader::ParseDouble(const char *first, const char *last, double &x)
+{
+	/*
+	Parses a decimal number at the start of [first, last), in the manner of
+	std::from_chars.  Numbers of up to 19 significant digits with a decimal
+	exponent the double type holds exactly are converted directly, which is
+	correctly rounded; others (and infinities and NaNs) are passed to strtod.
+	retval -- end of the number parsed, or first if there is none
+	*/
+	const char *p = first;
+	bool negative = false;
+	if (p < last && (*p == '-' || *p == '+'))
+	{
+		negative = *p == '-';
+		p++;
+	}
+	unsigned long long mantissa = 0;
+	int digits = 0, exponent = 0;
+	bool any = false;
+	while (p < last && IsDigit(*p))
+	{
+		any = true;
+		if (digits > 0 || *p != '0')
+		{
+			if (digits < 19)
+				mantissa = mantissa * 10 + (*p - '0');
+			else
+				exponent++;
+			digits++;
+		}
+		p++;
+	}
+	if (p < last && *p == '.')
+	{
+		p++;
+		while (p < last && IsDigit(*p))
+		{
+			any = true;
+			if (digits > 0 || *p != '0')
+			{
+				if (digits < 19)
+				{
+					mantissa = mantissa * 10 + (*p - '0');
+					exponent--;
+				}
+				digits++;
+			}
+			else
+				exponent--;
+			p++;
+		}
+	}
+	bool fast = any;
+	if (any && p < last && (*p == 'e' || *p == 'E'))
+	{
+		const char *q = p + 1;
+		bool eneg = false;
+		if (q < last && (*q == '-' || *q == '+'))
+		{
+			eneg = *q == '-';
+			q++;
+		}
+		if (q < last && IsDigit(*q))
+		{
+			int e = 0;
+			while (q < last && IsDigit(*q))
+			{
+				if (e < 100000)
+					e = e * 10 + (*q - '0');
+				q++;
+			}
+			exponent += eneg ? -e : e;
+			p = q;
+		}
+	}
+	if (fast && digits <= 19 && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22)
+	{
+		x = (double)mantissa;
+		if (exponent < 0)
+			x /= EXACT_POWERS_OF_TEN[-exponent];
+		else
+			x *= EXACT_POWERS_OF_TEN[exponent];
+		if (negative)
+			x = -x;
+		return p;
+	}
+
+	//general case, on a terminated copy of the field
+	char buffer[128];
+	size_t len = (size_t)(last - first);
+	if (len >= sizeof(buffer))
+		len = sizeof(buffer) - 1;
+	std::memcpy(buffer, first, len);
+	buffer[len] = '\0';
+	char *end;
+	x = std::strtod(buffer, &end);
+	return first + (end - buffer);
+}
+
+const char *CsvReader::ParseInt(const char *first, const char *last, int &x)
+{
+	/*
+	Parses a decimal integer at the start of [first, last), in the manner of
+	std::from_chars; throws if it is out of the range of int.
+	retval -- end of the integer parsed, or first if there is none
+	*/
+	const char *p = first;
+	bool negative = false;
+	if (p < last && (*p == '-' || *p == '+'))
+	{
+		negative = *p == '-';
+		p++;
+	}
+	if (p >= last || !IsDigit(*p))
+		return first;
+	long long v = 0;
+	while (p < last && IsDigit(*p))
+	{
+		v = v * 10 + (*p - '0');
+		if (v > (long long)INT_MAX + 1)
+			throw std::runtime_error("integer out of range: " + std::string(first, last));
+		p++;
+	}
+	if (negative)
+		v = -v;
+	if (v > INT_MAX)
+		throw std::runtime_error("integer out of range: " + std::string(first, last));
+	x = (int)v;
+	return p;
+}
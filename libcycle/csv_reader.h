@@ -0,0 +1,58 @@
+#ifndef _CSV_READER_
+#define _CSV_READER_
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+
+#include "mapped_file.h"
+
+/*
+Single-pass reader of delimited text files, read in place through a memory
+mapping.  Lines are visited in order with NextLine, and the fields of the
+current line are consumed in order with the Get methods, which parse numbers
+directly from the mapped text without building intermediate strings.
+ReadColumns fills numeric columns from all remaining lines at once.  Fields
+may be surrounded by spaces, and lines may end in "\n" or "\r\n".
+*/
+class CsvReader
+{
+	MappedFile m_file;
+	char m_delimiter;
+	const char *m_next;       //start of the next line
+	const char *m_end;        //end of the file
+	const char *m_field;      //start of the next field of the current line; NULL if none left
+	const char *m_line_end;   //end of the current line
+
+	bool NextField(const char *&first, const char *&last);
+
+public:
+	CsvReader(char delimiter = ',');
+
+	void Open(const std::string &filename);
+
+	void Close();
+
+	bool NextLine();
+
+	size_t CountFields() const;
+
+	bool HasField() const;
+
+	void SkipField();
+
+	std::string GetString();
+
+	double GetDouble();
+
+	int GetInt();
+
+	size_t ReadColumns(const std::vector< std::vector<double>* > &columns,
+		size_t max_lines);
+
+	static const char *ParseDouble(const char *first, const char *last, double &x);
+
+	static const char *ParseInt(const char *first, const char *last, int &x);
+};
+
+#endif
@@ -4,6 +4,167 @@
 #include <string>
 #include <sstream>
 #include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+	const size_t GAMMA_BLOCK = 64;
+
+	double regularized_gamma(double a, double x, bool upper)
+	{
+		/*
+		Regularized lower (P) or upper (Q) incomplete gamma function of shape
+		a at x, from its series for x < a + 1 and from its continued fraction
+		(modified Lentz) otherwise, so that the smaller of P and Q is always 
+		computed directly.  Source: Press et al. "Numerical Recipes", 6.2.
+		*/
+		if (x <= 0.)
+			return upper ? 1. : 0.;
+		const double tiny = std::numeric_limits<double>::min();
+		double lead = exp(a * log(x) - x - lgamma(a));
+		//far in either tail, the smaller of P and Q underflows
+		if (lead == 0.)
+			return (x < a + 1.) == upper ? 1. : 0.;
+		if (x < a + 1.)
+		{
+			double ap = a;
+			double del = 1. / a;
+			double sum = del;
+			for (int n = 0; n < 1000 && fabs(del) >= fabs(sum) * 1.e-15; n++)
+			{
+				ap += 1.;
+				del *= x / ap;
+				sum += del;
+			}
+			return upper ? 1. - sum * lead : sum * lead;
+		}
+		double b = x + 1. - a;
+		double c = 1. / tiny;
+		double d = 1. / b;
+		double h = d;
+		for (int i = 1; i < 1000; i++)
+		{
+			double an = -i * (i - a);
+			b += 2.;
+			d = an * d + b;
+			if (fabs(d) < tiny)
+				d = tiny;
+			c = b + an / c;
+			if (fabs(c) < tiny)
+				c = tiny;
+			d = 1. / d;
+			double del = d * c;
+			h *= del;
+			if (fabs(del - 1.) < 1.e-15)
+				break;
+		}
+		return upper ? h * lead : 1. - h * lead;
+	}
+
+	void gamma_variates(double alpha, double beta, WELLFiveTwelve &gen, 
+		double *variates, size_t n)
+	{
+		/*
+		Generates n gamma distributed random variables with shape alpha and
+		scale beta.  Algorithm source:  George S. Fishman "Monte Carlo:  
+		Concepts, Algorithms, and Applications" pgs 194, 197.
+		Note for alpha = 1, uses exponential distribution.
+
+		Each candidate uses a pair of uniforms.  Candidates are drawn in blocks
+		of no more than the number of variates still needed, and accepted 
+		candidates are compacted into 'variates' without branching on the 
+		outcome.  The stream is therefore consumed exactly as by n single 
+		draws, with the same results.
+		*/
+		if (alpha == 1)
+		{
+			gen.fill(variates, n);
+			for (size_t i = 0; i < n; i++)
+				variates[i] = beta * (-log(1 - variates[i]));
+			return;
+		}
+		if (!(alpha < 1) && !(alpha > 1 && alpha < 2.5) && !(alpha > 2.5))
+		{
+			//no sampler covers alpha = 2.5
+			std::fill(variates, variates + n, 0.0);
+			return;
+		}
+
+		double u[2 * GAMMA_BLOCK];
+		size_t k = 0;
+
+		// For alpha less than 1  //////////////////////
+		if (alpha < 1)
+		{
+			double b = (alpha + exp(1)) / exp(1);
+			while (k < n)
+			{
+				size_t m = std::min(n - k, GAMMA_BLOCK);
+				gen.fill(u, 2 * m);
+				for (size_t j = 0; j < m; j++)
+				{
+					double Y = b * u[2 * j];
+					double Z, W;
+					bool low = Y <= 1;
+					if (low)
+					{
+						Z = pow(Y, (1 / alpha));
+						W = -log(1 - u[2 * j + 1]);
+					}
+					else
+					{
+						Z = -log((b - Y) / alpha);
+						W = pow(u[2 * j + 1], 1 / (alpha - 1));
+					}
+					variates[k] = beta * Z;
+					k += low ? (W >= Z) : (W <= Z);
+				}
+			}
+			return;
+		}
+
+		double a = alpha - 1;
+		double b = (alpha - 1 / (6 * alpha)) / a;
+		double m = 2 / a;
+		double d = m + 2;
+
+		// For alpha greater than 1 and less than 2.5 //////////////////////
+		if (alpha < 2.5)
+		{
+			while (k < n)
+			{
+				size_t mb = std::min(n - k, GAMMA_BLOCK);
+				gen.fill(u, 2 * mb);
+				for (size_t j = 0; j < mb; j++)
+				{
+					double X = u[2 * j];
+					double V = b * u[2 * j + 1] / X;
+					variates[k] = a * V*beta;
+					k += (m*X - d + V + pow(V, -1) <= 0) || (m*log(X) - log(V) + V - 1 <= 0);
+				}
+			}
+			return;
+		}
+
+		// For large alpha      //////////////////////
+		double f = sqrt(alpha);
+		while (k < n)
+		{
+			size_t mb = std::min(n - k, GAMMA_BLOCK);
+			gen.fill(u, 2 * mb);
+			for (size_t j = 0; j < mb; j++)
+			{
+				double Y = u[2 * j + 1];
+				double Z = Y + (1 - 1.857764 * u[2 * j]) / f;
+				double V = b * Y / Z;
+				variates[k] = a * V*beta;
+				k += (Z > 0 && Z < 1) &&
+					((m*Z - d + V + pow(V, -1) <= 0) || (m*log(Z) - log(V) + V - 1 <= 0));
+			}
+		}
+	}
+}
 
 //##################################################################################
 
@@ -26,6 +187,38 @@ double Distribution::GetVariate(WELLFiveTwelve &)
 	return -1.0;
 }
 
+void Distribution::GetVariates(WELLFiveTwelve &gen, double *variates, size_t n)
+{
+	/*
+	Writes n variates to 'variates'.  Derived classes with a batched kernel
+	override this; the default draws them one at a time.  In all cases, the
+	values and the generator state afterwards are the same as for n 
+	successive calls to GetVariate.
+	*/
+	for (size_t i = 0; i < n; i++)
+		variates[i] = GetVariate(gen);
+}
+
+
+bool Distribution::HasInverseCDF()
+{
+	/*
+	retval -- true if GetVariate is the inverse CDF of a single uniform 
+		variate, so that GetInverseCDF(u) of the next variate u of a stream 
+		is the value GetVariate would return.
+	*/
+	return false;
+}
+
+double Distribution::GetInverseCDF(double)
+{
+	throw std::runtime_error("inverse CDF not available for distribution type " + m_type);
+}
+
+double Distribution::GetCDF(double)
+{
+	throw std::runtime_error("CDF not available for distribution type " + m_type);
+}
 
 std::string Distribution::GetType()
 {
@@ -69,6 +262,81 @@ double ExponentialDist::GetVariate(WELLFiveTwelve &gen)
 	return (-1.0 * log(1. - unif) * GetAlpha()) + GetBeta();
 }
 
+void ExponentialDist::GetVariates(WELLFiveTwelve &gen, double *variates, size_t n)
+{
+	double alpha = GetAlpha();
+	double beta = GetBeta();
+	gen.fill(variates, n);
+	for (size_t i = 0; i < n; i++)
+		variates[i] = (-1.0 * log(1. - variates[i]) * alpha) + beta;
+}
+
+bool ExponentialDist::HasInverseCDF()
+{
+	return true;
+}
+
+double ExponentialDist::GetInverseCDF(double u)
+{
+	return (-1.0 * log(1. - u) * GetAlpha()) + GetBeta();
+}
+
+double ExponentialDist::GetCDF(double x)
+{
+	/* scale alpha, location beta */
+	if (x <= GetBeta())
+		return 0.;
+	return 1. - exp(-(x - GetBeta()) / GetAlpha());
+}
+
+//##################################################################################
+
+WeibullDist::WeibullDist() {}
+
+WeibullDist::WeibullDist(double alpha, double beta, std::string type) :
+	Distribution(alpha, beta, type) {}
+
+bool WeibullDist::IsBinary()
+{
+	return false;
+}
+
+double WeibullDist::GetVariate(WELLFiveTwelve &gen)
+{
+	/*
+	returns the inverse CDF of a U[0,1] random variate, 
+	beta * (-ln(1-u))^(1/alpha).
+	*/
+	double unif = gen.getVariate();
+	return GetBeta() * pow(-log(1. - unif), 1. / GetAlpha());
+}
+
+void WeibullDist::GetVariates(WELLFiveTwelve &gen, double *variates, size_t n)
+{
+	double inv_alpha = 1. / GetAlpha();
+	double beta = GetBeta();
+	gen.fill(variates, n);
+	for (size_t i = 0; i < n; i++)
+		variates[i] = beta * pow(-log(1. - variates[i]), inv_alpha);
+}
+
+bool WeibullDist::HasInverseCDF()
+{
+	return true;
+}
+
+double WeibullDist::GetInverseCDF(double u)
+{
+	return GetBeta() * pow(-log(1. - u), 1. / GetAlpha());
+}
+
+double WeibullDist::GetCDF(double x)
+{
+	if (x <= 0.)
+		return 0.;
+	return 1. - exp(-pow(x / GetBeta(), GetAlpha()));
+}
+
 
 //##################################################################################
 
@@ -90,110 +358,37 @@ double GammaDist::GetVariate(WELLFiveTwelve &gen)
 	(here, alpha denotes the shape parameter and
 	beta denotes the scale.)
 	*/
-	double W, X, Y, Z;
-	double random1;
-	double random2;
-	bool success = false;
-
-	int iterations = 0;
-
-	// For alpha = 1, use exponential distrubution
-	if (GetAlpha() == 1)
-	{
-		random1 = gen.getVariate();
-		return GetBeta() * (-log(1 - random1));
-	}
-
-	// For alpha less than 1  //////////////////////
-	if (GetAlpha() < 1)
-	{
-		double b = (GetAlpha() + exp(1)) / exp(1);
-
-		while (!success)
-		{
-			iterations++;
-			random1 = gen.getVariate();
-			random2 = gen.getVariate();
-
-			Y = b * random1;
-			if (Y <= 1)
-			{
-				Z = pow(Y, (1 / GetAlpha()));
-				W = -log(1 - random2);
-				if (W >= Z)
-				{
-					return GetBeta()*Z;
-				}
-			}
-			else {
-				Z = -log((b - Y) / GetAlpha());
-				W = pow(random2, 1 / (GetAlpha() - 1));
-				if (W <= Z)
-				{
-					return GetBeta()*Z;
-				}
-			}
-		}
-	}
-
-	// For alpha greater than 1 and less than 2.5 //////////////////////
-	else if (GetAlpha() > 1 && GetAlpha() < 2.5)
-	{
-		double a = GetAlpha() - 1;
-		double b = (GetAlpha() - 1 / (6 * GetAlpha())) / a;
-		double m = 2 / a;
-		double d = m + 2;
-
-		while (!success)
-		{
-			iterations++;
-			X = gen.getVariate();
-			Y = gen.getVariate();
-			double V = b*Y / X;
+	double var;
+	gamma_variates(GetAlpha(), GetBeta(), gen, &var, 1);
+	return var;
+}
 
-			if (m*X - d + V + pow(V, -1) <= 0)
-			{
-				return a*V*GetBeta();
-			}
-			if (m*log(X) - log(V) + V - 1 <= 0)
-			{
-				return a*V*GetBeta();
-			}
-		}
-	}
+void GammaDist::GetVariates(WELLFiveTwelve &gen, double *variates, size_t n)
+{
+	gamma_variates(GetAlpha(), GetBeta(), gen, variates, n);
+}
 
-	// For large alpha      //////////////////////
-	else if (GetAlpha() > 2.5)
-	{
-		double a = GetAlpha() - 1;
-		double b = (GetAlpha() - 1 / (6 * GetAlpha())) / a;
-		double m = 2 / a;
-		double d = m + 2;
-		double f = sqrt(GetAlpha());
-
-		while (!success) {
-			Z = -1;
-			Y = 0;
-			while (!(Z > 0 && Z < 1)) {
-				iterations++;
-				X = gen.getVariate();
-				Y = gen.getVariate();
-				Z = Y + (1 - 1.857764 * X) / f;
-			}
-			double V = b*Y / Z;
+bool GammaDist::HasInverseCDF()
+{
+	/* only the exponential case is sampled by inversion */
+	return GetAlpha() == 1;
+}
 
-			if (m*Z - d + V + pow(V, -1) <= 0)
-			{
-				return a*V*GetBeta();
-			}
-			if (m*log(Z) - log(V) + V - 1 <= 0)
-			{
-				return a*V*GetBeta();
-			}
-		}
-	}
+double GammaDist::GetInverseCDF(double u)
+{
+	if (GetAlpha() != 1)
+		return Distribution::GetInverseCDF(u);
+	return GetBeta() * (-log(1 - u));
+}
 
-	return 0.0;
+double GammaDist::GetCDF(double x)
+{
+	/* shape alpha, scale beta; from the incomplete gamma function unless exponential */
+	if (x <= 0.)
+		return 0.;
+	if (GetAlpha() != 1)
+		return regularized_gamma(GetAlpha(), x / GetBeta(), false);
+	return 1. - exp(-x / GetBeta());
 }
 
 //##################################################################################
@@ -246,6 +441,11 @@ double BoundedJohnsonDist::NormalCDFInverse(double p)
 	}
 }
 
+bool BoundedJohnsonDist::HasInverseCDF()
+{
+	return true;
+}
+
 double BoundedJohnsonDist::GetInverseCDF(double u)
 {
 	double z = NormalCDFInverse(u);
@@ -259,6 +459,25 @@ double BoundedJohnsonDist ::GetVariate(WELLFiveTwelve &gen)
 	return GetInverseCDF(unif);
 }
 
+void BoundedJohnsonDist::GetVariates(WELLFiveTwelve &gen, double *variates, size_t n)
+{
+	/*
+	Batched GetInverseCDF: the branches of NormalCDFInverse are folded into
+	selects so that the loop body is straight-line code.
+	*/
+	gen.fill(variates, n);
+	for (size_t i = 0; i < n; i++)
+	{
+		double p = variates[i];
+		if (p <= 0.0 || p >= 1.0)
+			NormalCDFInverse(p);  //throws
+		bool lower = p < 0.5;
+		double r = RationalApproximation(sqrt(-2.0*log(lower ? p : 1 - p)));
+		double e = ((lower ? -r : r) - m_gamma) / m_delta;
+		variates[i] = m_lambda * ( exp(e) / (1 + exp(e)) ) + m_xi;
+	}
+}
+
 //##################################################################################
 
 BetaDist::BetaDist() {}
@@ -282,6 +501,44 @@ double BetaDist::GetVariate(WELLFiveTwelve &gen)
 	return x / (x + y);
 }
 
+void BetaDist::GetVariates(WELLFiveTwelve &gen, double *variates, size_t n)
+{
+	/*
+	Each variate is x / (x + y) for gamma variates x (shape alpha) then y
+	(shape beta), drawn in that order as by GetVariate.  Both are drawn from 
+	the shared gamma sampler without going through the GammaDist members.
+	When both shapes are 1, x and y are exponential and a block of pairs 
+	is filled at once.  Otherwise the two rejection samplers must alternate 
+	per variate, since drawing all x ahead of all y would consume the stream 
+	in a different order than single draws.
+	*/
+	double alpha = GetAlpha();
+	double beta = GetBeta();
+	if (alpha == 1 && beta == 1)
+	{
+		double u[2 * GAMMA_BLOCK];
+		for (size_t k = 0; k < n; k += GAMMA_BLOCK)
+		{
+			size_t m = std::min(n - k, GAMMA_BLOCK);
+			gen.fill(u, 2 * m);
+			for (size_t j = 0; j < m; j++)
+			{
+				double x = -log(1 - u[2 * j]);
+				double y = -log(1 - u[2 * j + 1]);
+				variates[k + j] = x / (x + y);
+			}
+		}
+		return;
+	}
+	for (size_t i = 0; i < n; i++)
+	{
+		double x, y;
+		gamma_variates(alpha, 1, gen, &x, 1);
+		gamma_variates(beta, 1, gen, &y, 1);
+		variates[i] = x / (x + y);
+	}
+}
+
 
 GammaProcessDist::GammaProcessDist()
 {
@@ -349,126 +606,176 @@ double GammaProcessDist::GetMean(double t, double delta_t)
 double GammaProcessDist::GetVariate(double alpha, WELLFiveTwelve &gen)
 {
 	/*
-	generates a gamma distributed random variable for alpha < 1 and
-	alpha > 1.  Algorithm source:  George S. Fishman "Monte Carlo:  Concepts,
-	Algorithms, and Applications" pgs 194, 197.
-	Note for alpha = 1, uses exponential distribution.
-
-	(here, alpha denotes the shape parameter and
-	beta denotes the scale.)
+	generates a gamma distributed random variable, with the sampler used
+	by GammaDist.
 
 	alpha -- shape parameter of the distribution. 
 	*/
-	double W, X, Y, Z;
-	double random1;
-	double random2;
-	bool success = false;
-
-	int iterations = 0;
+	double var;
+	gamma_variates(alpha, GetBeta(), gen, &var, 1);
+	return var;
+}
 
-	// For alpha = 1, use exponential distrubution
-	if (alpha == 1)
-	{
-		random1 = gen.getVariate();
-		return GetBeta() * (-log(1 - random1));
-	}
+void GammaProcessDist::GetVariates(double alpha, WELLFiveTwelve &gen, 
+	double *variates, size_t n)
+{
+	/*
+	Generates n variates with the same shape parameter, e.g., the wear of 
+	each heliostat over an interval of the same length.
 
-	// For alpha less than 1  //////////////////////
-	if (alpha < 1)
-	{
-		double b = (alpha + exp(1)) / exp(1);
+	alpha -- shape parameter of the distribution
+	variates -- output, length n
+	*/
+	gamma_variates(alpha, GetBeta(), gen, variates, n);
+}
 
-		while (!success)
-		{
-			iterations++;
-			random1 = gen.getVariate();
-			random2 = gen.getVariate();
+void GammaProcessDist::GetVariates(const double *alpha, WELLFiveTwelve &gen,
+	double *variates, size_t n)
+{
+	/*
+	Generates one variate for each of n shape parameters, in order.
 
-			Y = b * random1;
-			if (Y <= 1)
-			{
-				Z = pow(Y, (1 / alpha));
-				W = -log(1 - random2);
-				if (W >= Z)
-				{
-					return GetBeta()*Z;
-				}
-			}
-			else {
-				Z = -log((b - Y) / alpha);
-				W = pow(random2, 1 / (alpha - 1));
-				if (W <= Z)
-				{
-					return GetBeta()*Z;
-				}
-			}
-		}
-	}
+	alpha -- shape parameters, length n
+	variates -- output, length n
+	*/
+	for (size_t i = 0; i < n; i++)
+		gamma_variates(alpha[i], GetBeta(), gen, variates + i, 1);
+}
 
-	// For alpha greater than 1 and less than 2.5 //////////////////////
-	else if (alpha > 1 && alpha < 2.5)
+int LatinHypercubeStratum(int index, int dimension, int num_strata, uint32_t design)
+{
+	/*
+	Permutation of Kensler, "Correlated Multi-Jittered Sampling" (Pixar 
+	technical memo 13-01, 2013): a hash that is invertible on the smallest 
+	power of two covering num_strata, iterated until it lands in range, and 
+	keyed by the dimension and the design.  Different design keys give 
+	independent pairings of the strata across dimensions.
+	index -- sample index, in [0, num_strata)
+	dimension -- dimension index
+	num_strata -- number of samples and strata
+	design -- key of the Latin hypercube design
+	retval -- stratum, in [0, num_strata)
+	*/
+	if (num_strata <= 0 || index < 0 || index >= num_strata)
+		throw std::runtime_error("Latin hypercube sample index out of range.");
+	uint32_t l = (uint32_t)num_strata;
+	uint32_t p = (uint32_t)dimension * 0x9e3779b9u + 0x68bc21ebu;
+	p ^= design;
+	uint32_t w = l - 1;
+	w |= w >> 1;
+	w |= w >> 2;
+	w |= w >> 4;
+	w |= w >> 8;
+	w |= w >> 16;
+	uint32_t i = (uint32_t)index;
+	do
 	{
-		double a = alpha - 1;
-		double b = (alpha - 1 / (6 * alpha)) / a;
-		double m = 2 / a;
-		double d = m + 2;
+		i ^= p;
+		i *= 0xe170893du;
+		i ^= p >> 16;
+		i ^= (i & w) >> 4;
+		i ^= p >> 8;
+		i *= 0x0929eb3fu;
+		i ^= p >> 23;
+		i ^= (i & w) >> 1;
+		i *= 1 | p >> 27;
+		i *= 0x6935fa69u;
+		i ^= (i & w) >> 11;
+		i *= 0x74dcb303u;
+		i ^= (i & w) >> 2;
+		i *= 0x9e501cc3u;
+		i ^= (i & w) >> 2;
+		i *= 0xc860a3dfu;
+		i &= w;
+		i ^= i >> 5;
+	} while (i >= l);
+	return (int)((i + p) % l);
+}
 
-		while (!success)
+double StudentTCDFInverse(double p, int dof)
+{
+	/*
+	Newton's method on the probability A(t) = P(|T| <= t) from its closed 
+	form for integer degrees of freedom (Abramowitz and Stegun 26.7.3 and 
+	26.7.4).  A is concave for t > 0, so the iterates reach the root 
+	monotonically from the first step on, starting from the normal quantile.
+	p -- probability, in (0, 1)
+	dof -- degrees of freedom, at least 1
+	retval -- t such that P(T <= t) = p
+	*/
+	if (!(p > 0. && p < 1.) || dof < 1)
+		throw std::invalid_argument("Student's t quantile requires a probability in (0, 1) and at least one degree of freedom.");
+	if (p < 0.5)
+		return -StudentTCDFInverse(1. - p, dof);
+	double level = 2. * p - 1.;
+	if (level <= 0.)
+		return 0.;
+	const double pi = 3.14159265358979323846;
+	double nu = (double)dof;
+	double density = exp(lgamma(0.5 * (nu + 1.)) - lgamma(0.5 * nu)) / sqrt(nu * pi);
+	BoundedJohnsonDist normal;
+	double t = normal.NormalCDFInverse(p);
+	for (int it = 0; it < 200; it++)
+	{
+		double theta = atan(t / sqrt(nu));
+		double c = cos(theta);
+		double sum, term;
+		if (dof % 2 == 1)
 		{
-			iterations++;
-			X = gen.getVariate();
-			Y = gen.getVariate();
-			double V = b * Y / X;
-
-			if (m*X - d + V + pow(V, -1) <= 0)
-			{
-				return a * V*GetBeta();
-			}
-			if (m*log(X) - log(V) + V - 1 <= 0)
+			sum = 0.;
+			term = c;
+			for (int k = 3; k <= dof; k += 2)
 			{
-				return a * V*GetBeta();
+				sum += term;
+				term *= c * c * (k - 1) / k;
 			}
+			sum = 2. / pi * (theta + sin(theta) * sum);
 		}
-	}
-
-	// For large alpha      //////////////////////
-	else if (alpha > 2.5)
-	{
-		double a = alpha - 1;
-		double b = (alpha - 1 / (6 * alpha)) / a;
-		double m = 2 / a;
-		double d = m + 2;
-		double f = sqrt(alpha);
-
-		while (!success) {
-			Z = -1;
-			Y = 0;
-			while (!(Z > 0 && Z < 1)) {
-				iterations++;
-				X = gen.getVariate();
-				Y = gen.getVariate();
-				Z = Y + (1 - 1.857764 * X) / f;
-			}
-			double V = b * Y / Z;
-
-			if (m*Z - d + V + pow(V, -1) <= 0)
-			{
-				return a * V*GetBeta();
-			}
-			if (m*log(Z) - log(V) + V - 1 <= 0)
+		else
+		{
+			sum = 0.;
+			term = 1.;
+			for (int k = 2; k <= dof; k += 2)
 			{
-				return a * V*GetBeta();
+				sum += term;
+				term *= c * c * (k - 1) / k;
 			}
+			sum = sin(theta) * sum;
 		}
+		double dt = (sum - level) / (2. * density * pow(1. + t * t / nu, -0.5 * (nu + 1.)));
+		t -= dt;
+		if (fabs(dt) <= 1.e-12 * t)
+			break;
 	}
-
-	return 0.0;
+	return t;
 }
 
+//##################################################################################
+
 InvGammaDist::InvGammaDist() {}
 
 double InvGammaDist::GetVariate(WELLFiveTwelve &gen)
 {
 	double var = GammaDist::GetVariate(gen);
 	return 1.0 / var;
-}
\ No newline at end of file
+}
+
+void InvGammaDist::GetVariates(WELLFiveTwelve &gen, double *variates, size_t n)
+{
+	GammaDist::GetVariates(gen, variates, n);
+	for (size_t i = 0; i < n; i++)
+		variates[i] = 1.0 / variates[i];
+}
+
+bool InvGammaDist::HasInverseCDF()
+{
+	return false;
+}
+
+double InvGammaDist::GetCDF(double x)
+{
+	/* the reciprocal of a gamma variate with shape alpha and scale beta is below x if the variate is above 1/x */
+	if (x <= 0.)
+		return 0.;
+	return regularized_gamma(GetAlpha(), 1. / (x * GetBeta()), true);
+}
@@ -14,6 +14,10 @@ public:
 	Distribution(double alpha, double beta, std::string type);
 	virtual bool IsBinary();
 	virtual double GetVariate(WELLFiveTwelve &gen);
+	virtual void GetVariates(WELLFiveTwelve &gen, double *variates, size_t n);
+	virtual bool HasInverseCDF();
+	virtual double GetInverseCDF(double u);
+	virtual double GetCDF(double x);
 	std::string GetType();
 	double GetAlpha();
 	double GetBeta();
@@ -31,10 +35,31 @@ public:
 	ExponentialDist(double alpha, double beta, std::string type);
 	bool IsBinary() override;
 	double GetVariate(WELLFiveTwelve &gen) override;
+	void GetVariates(WELLFiveTwelve &gen, double *variates, size_t n) override;
+	bool HasInverseCDF() override;
+	double GetInverseCDF(double u) override;
+	double GetCDF(double x) override;
 	//using Distribution::GetType;
 };
 //##################################################################################
 /*
+This is an object that performs inverse CDF's of the Weibull distribution, 
+with shape alpha and scale beta.
+*/
+class WeibullDist : public Distribution
+{
+public:
+	WeibullDist();
+	WeibullDist(double alpha, double beta, std::string type);
+	bool IsBinary() override;
+	double GetVariate(WELLFiveTwelve &gen) override;
+	void GetVariates(WELLFiveTwelve &gen, double *variates, size_t n) override;
+	bool HasInverseCDF() override;
+	double GetInverseCDF(double u) override;
+	double GetCDF(double x) override;
+};
+//##################################################################################
+/*
 This is an object that performs inverse CDF's of the gamma
 distribution, using an algorithm found in Fishman's book 'Monte Carlo...'.
 */
@@ -46,6 +71,10 @@ public:
 		Distribution::Distribution(alpha, beta, type) {}
 	bool IsBinary() override;
 	double GetVariate(WELLFiveTwelve &gen) override;
+	void GetVariates(WELLFiveTwelve &gen, double *variates, size_t n) override;
+	bool HasInverseCDF() override;
+	double GetInverseCDF(double u) override;
+	double GetCDF(double x) override;
 	//using Distribution::GetType;
 };
 
@@ -70,8 +99,10 @@ public:
 	bool IsBinary() override;
 	double RationalApproximation(double u);
 	double NormalCDFInverse(double p);
-	double GetInverseCDF(double u);
+	bool HasInverseCDF() override;
+	double GetInverseCDF(double u) override;
 	double GetVariate(WELLFiveTwelve &gen) override;
+	void GetVariates(WELLFiveTwelve &gen, double *variates, size_t n) override;
 	//using Distribution::GetType;
 };
 
@@ -90,6 +121,7 @@ public:
 	BetaDist(double alpha, double beta, std::string type);
 	bool IsBinary() override;
 	double GetVariate(WELLFiveTwelve &gen) override;
+	void GetVariates(WELLFiveTwelve &gen, double *variates, size_t n) override;
 	//using Distribution::GetType;
 };
 
@@ -106,12 +138,31 @@ public:
 	bool IsBinary();
 	double GetAlpha(double t, double delta_t);
 	double GetVariate(double alpha, WELLFiveTwelve &gen);
+	void GetVariates(double alpha, WELLFiveTwelve &gen, double *variates, size_t n);
+	void GetVariates(const double *alpha, WELLFiveTwelve &gen, double *variates, size_t n);
 	std::string GetType();
 	double GetBeta();
 	double GetMean(double t, double delta_t);
 };
 
 
+/*
+Stratum of sample 'index' in dimension 'dimension' of a Latin hypercube
+sample of size num_strata: for each dimension, a pseudo-random 
+permutation of the strata over the samples, so that the samples of a 
+dimension fall in distinct strata of [0,1).  The permutations are fixed 
+by the design key; each design should get its own key, so that repeated 
+designs are independent.  Computed from its arguments alone, so each 
+sample can be drawn independently, e.g., on its own thread.
+*/
+int LatinHypercubeStratum(int index, int dimension, int num_strata, uint32_t design);
+
+/*
+Quantile of Student's t distribution with dof degrees of freedom at p, in 
+(0, 1), e.g., for confidence intervals of the mean of dof + 1 samples.
+*/
+double StudentTCDFInverse(double p, int dof);
+
 class InvGammaDist : public GammaDist
 {
 public:
@@ -119,6 +170,9 @@ public:
 	InvGammaDist(double alpha, double beta, std::string type) :
 		GammaDist::GammaDist(alpha, beta, type) {}
 	double GetVariate(WELLFiveTwelve &gen) override;
+	void GetVariates(WELLFiveTwelve &gen, double *variates, size_t n) override;
+	bool HasInverseCDF() override;
+	double GetCDF(double x) override;
 };
 
 #endif
@@ -2,7 +2,9 @@
 #include <cmath>
 
 //##################################################################################
-FailureType::FailureType() {}
+FailureType::FailureType()
+	: m_failure_mode_enum(MODE_OFF), m_failure_dist(0), m_horizon_prob(0.), m_biased_prob(0.)
+{}
 
 FailureType::FailureType(std::string component, std::string id,
 	std::string failure_mode, std::string dist_type, double alpha, double beta)
@@ -10,6 +12,9 @@ FailureType::FailureType(std::string component, std::string id,
 	m_component = component;
 	m_id = id;
 	m_failure_mode = failure_mode;
+	m_failure_mode_enum = OperatingModeFromString(failure_mode);
+	m_horizon_prob = 0.;
+	m_biased_prob = 0.;
 	if (dist_type == "beta")
 	{
 		Distribution *bdist = new BetaDist(alpha, beta, dist_type);
@@ -25,6 +30,11 @@ FailureType::FailureType(std::string component, std::string id,
 		Distribution *edist = new ExponentialDist(alpha, beta, dist_type);
 		m_failure_dist = (ExponentialDist *) edist;
 	}
+	else if (dist_type == "weibull")
+	{
+		Distribution *wdist = new WeibullDist(alpha, beta, dist_type);
+		m_failure_dist = (WeibullDist *)wdist;
+	}
 	else if (dist_type == "inv-gamma")
 	{
 		Distribution *gdist = new InvGammaDist(alpha, 1./beta, dist_type);
@@ -51,6 +61,11 @@ std::string FailureType::GetFailureMode()
 	return m_failure_mode;
 }
 
+operating_mode FailureType::GetFailureModeEnum()
+{
+	return m_failure_mode_enum;
+}
+
 Distribution *FailureType::GetFailureDist()
 {
 	return m_failure_dist;
@@ -92,3 +107,128 @@ double FailureType::GenerateFailureVariate(WELLFiveTwelve &gen)
 	else
 		return GenerateTimeToFailure(gen);
 }
+
+double FailureType::GetHorizonProbability(double horizon)
+{
+	/*
+	horizon -- lifetime, in hours
+	retval -- probability of a lifetime shorter than 'horizon'; -1 for 
+		failure probabilities and lifetimes not sampled by inversion, which
+		are not importance sampled
+	*/
+	if (m_failure_dist->IsBinary() || !m_failure_dist->HasInverseCDF())
+		return -1.;
+	return m_failure_dist->GetCDF(horizon);
+}
+
+void FailureType::SetImportanceSampling(double scale, double horizon)
+{
+	/*
+	Sets up importance sampling of the lifetimes of this failure type by 
+	failure biasing: a lifetime shorter than 'horizon', i.e., a failure 
+	within the run, is drawn with 'scale' times its probability under the 
+	failure distribution, and the lifetime is then drawn from the failure 
+	distribution conditional on its side of the horizon.  Only failure 
+	types with a horizon probability (see GetHorizonProbability()) of 
+	more than zero and less than one over 'scale' are importance sampled.
+	scale -- factor of at least one; one disables importance sampling
+	horizon -- lifetime at which lifetimes are split, e.g., the length of 
+		the run in hours
+	*/
+	if (!(scale >= 1.))
+		throw std::runtime_error("importance sampling scale must be at least one.");
+	m_horizon_prob = m_biased_prob = 0.;
+	if (scale == 1.)
+		return;
+	double p = GetHorizonProbability(horizon);
+	if (p > 0. && scale * p < 1.)
+	{
+		m_horizon_prob = p;
+		m_biased_prob = scale * p;
+	}
+}
+
+bool FailureType::IsImportanceSampled()
+{
+	return m_biased_prob != m_horizon_prob;
+}
+
+double FailureType::GenerateFailureVariate(WELLFiveTwelve &gen, double &log_weight)
+{
+	/*
+	Generates a lifetime or failure probability as GenerateFailureVariate(gen)
+	does, unless the lifetimes of this failure type are importance sampled
+	(see SetImportanceSampling()); the log of the likelihood ratio of the 
+	lifetime drawn, its probability under the failure distribution over 
+	that under the biased one, is then added to log_weight.
+	gen -- random U[0,1] generator object
+	log_weight -- log likelihood ratio of the scenario, updated
+	retval -- lifetime or failure probability
+	*/
+	if (!IsImportanceSampled())
+		return GenerateFailureVariate(gen);
+	return BiasedLifetime(gen.getVariate(), log_weight);
+}
+
+double FailureType::GenerateStratifiedVariate(WELLFiveTwelve &gen, int stratum, 
+	int num_strata, double &log_weight)
+{
+	/*
+	Generates a lifetime as GenerateFailureVariate(gen, log_weight) does, 
+	from a uniform variate confined to one of num_strata equal strata of 
+	[0,1), for Latin hypercube sampling.  Distributions that are not 
+	sampled by inversion of a single uniform variate, and failure 
+	probabilities, are drawn without stratification.
+	stratum -- stratum index, in [0, num_strata)
+	num_strata -- number of strata
+	*/
+	if (m_failure_dist->IsBinary() || !m_failure_dist->HasInverseCDF())
+		return GenerateFailureVariate(gen, log_weight);
+	double u = (stratum + gen.getVariate()) / num_strata;
+	if (IsImportanceSampled())
+		return BiasedLifetime(u, log_weight);
+	return m_failure_dist->GetInverseCDF(u);
+}
+
+double FailureType::GetCumulativeHazard(double life)
+{
+	/*
+	life -- lifetime consumed, in adjusted hours of operation
+	retval -- cumulative hazard -ln(1 - F(life)) of the lifetime 
+		distribution, the expected number of failures within 'life' if 
+		each failure is followed by a lifetime as old as the failed one
+	*/
+	if (m_failure_dist->IsBinary())
+		throw std::runtime_error("cumulative hazard requested for a failure probability.");
+	return -std::log1p(-m_failure_dist->GetCDF(life));
+}
+
+double FailureType::GetMeanFailureProbability()
+{
+	/* retval -- mean of the (beta) distribution of the probability of failure on start */
+	if (!m_failure_dist->IsBinary())
+		throw std::runtime_error("mean failure probability requested for a lifetime distribution.");
+	double alpha = m_failure_dist->GetAlpha();
+	return alpha / (alpha + m_failure_dist->GetBeta());
+}
+
+double FailureType::BiasedLifetime(double u, double &log_weight)
+{
+	/*
+	Maps a uniform variate through the inverse CDF of the biased lifetime 
+	distribution, which puts probability m_biased_prob below the horizon, 
+	and adds the log likelihood ratio of the result to log_weight.
+	*/
+	double p = m_horizon_prob, q = m_biased_prob;
+	if (u < q)
+	{
+		log_weight += log(p / q);
+		u *= p / q;
+	}
+	else
+	{
+		log_weight += log((1. - p) / (1. - q));
+		u = p + (u - q) * ((1. - p) / (1. - q));
+	}
+	return m_failure_dist->GetInverseCDF(u);
+}
@@ -4,6 +4,7 @@
 #include <string>
 #include "distributions.h"
 #include "well512.h"
+#include "modes.h"
 #include <stdexcept>
 
 class FailureType
@@ -11,8 +12,13 @@ class FailureType
 	std::string m_component;
 	std::string m_id;
 	std::string m_failure_mode;
+	operating_mode m_failure_mode_enum;
 	Distribution *m_failure_dist;
 	double m_duration;
+	//importance sampling: probability of a lifetime under the horizon, under
+	//the failure distribution and as sampled; equal if not importance sampled
+	double m_horizon_prob;
+	double m_biased_prob;
 	//double m_probability;
 	//double m_life_remaining;
 
@@ -29,6 +35,8 @@ public:
 	
 	std::string GetFailureMode();
 
+	operating_mode GetFailureModeEnum();
+
 	Distribution *GetFailureDist();
 
 	double GenerateTimeToFailure(WELLFiveTwelve &gen);
@@ -37,6 +45,23 @@ public:
 
 	double GenerateFailureVariate(WELLFiveTwelve &gen);
 
+	double GetHorizonProbability(double horizon);
+
+	void SetImportanceSampling(double scale, double horizon);
+
+	bool IsImportanceSampled();
+
+	double GenerateFailureVariate(WELLFiveTwelve &gen, double &log_weight);
+
+	double GenerateStratifiedVariate(WELLFiveTwelve &gen, int stratum, int num_strata,
+		double &log_weight);
+
+	double GetCumulativeHazard(double life);
+
+	double GetMeanFailureProbability();
+
+private:
+	double BiasedLifetime(double u, double &log_weight);
 };
 
 #endif
\ No newline at end of file
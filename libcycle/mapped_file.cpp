@@ -0,0 +1,173 @@
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "mapped_file.h"
+
+MappedFile::MappedFile()
+{
+	m_writable = false;
+	m_data = NULL;
+	m_size = 0;
+#ifdef _WIN32
+	m_file = INVALID_HANDLE_VALUE;
+	m_mapping = NULL;
+#else
+	m_fd = -1;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+void MappedFile::Map(bool writable)
+{
+	/* maps m_size bytes of the open file; empty files are not mapped. */
+	m_writable = writable;
+	if (m_size == 0)
+		return;
+#ifdef _WIN32
+	m_mapping = CreateFileMappingA(m_file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY,
+		(DWORD)((unsigned long long)m_size >> 32), (DWORD)(m_size & 0xffffffff), NULL);
+	if (m_mapping != NULL)
+		m_data = (char*)MapViewOfFile(m_mapping,
+			writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, m_size);
+#else
+	void *p = mmap(NULL, m_size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+		MAP_SHARED, m_fd, 0);
+	if (p != MAP_FAILED)
+		m_data = (char*)p;
+#endif
+	if (m_data == NULL)
+	{
+		Close();
+		throw std::runtime_error("could not map file " + m_filename);
+	}
+}
+
+void MappedFile::Create(const std::string &filename, size_t size)
+{
+	/*
+	Creates (or overwrites) a zero-filled file and maps it for writing.
+	filename -- path of the file
+	size -- size of the file in bytes
+	*/
+	Close();
+	m_filename = filename;
+	m_size = size;
+#ifdef _WIN32
+	m_file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL,
+		CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (m_file == INVALID_HANDLE_VALUE)
+		throw std::runtime_error("could not create file " + filename);
+#else
+	m_fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (m_fd < 0)
+		throw std::runtime_error("could not create file " + filename);
+	if (ftruncate(m_fd, (off_t)m_size) != 0)
+	{
+		Close();
+		throw std::runtime_error("could not size file " + filename);
+	}
+#endif
+	Map(true);
+}
+
+void MappedFile::Open(const std::string &filename, bool writable)
+{
+	/*
+	Opens and maps an existing file.
+	filename -- path of the file
+	writable -- true to map the file for writing as well as reading
+	*/
+	Close();
+	m_filename = filename;
+#ifdef _WIN32
+	m_file = CreateFileA(filename.c_str(),
+		writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+		writable ? 0 : FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (m_file == INVALID_HANDLE_VALUE)
+		throw std::runtime_error("could not open file " + filename);
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_file, &size))
+	{
+		Close();
+		throw std::runtime_error("could not read size of file " + filename);
+	}
+	m_size = (size_t)size.QuadPart;
+#else
+	m_fd = open(filename.c_str(), writable ? O_RDWR : O_RDONLY);
+	if (m_fd < 0)
+		throw std::runtime_error("could not open file " + filename);
+	struct stat st;
+	if (fstat(m_fd, &st) != 0)
+	{
+		Close();
+		throw std::runtime_error("could not read size of file " + filename);
+	}
+	m_size = (size_t)st.st_size;
+#endif
+	Map(writable);
+}
+
+void MappedFile::Close()
+{
+	/* unmaps and closes the file, if open; written data is kept. */
+#ifdef _WIN32
+	if (m_data != NULL)
+		UnmapViewOfFile(m_data);
+	if (m_mapping != NULL)
+		CloseHandle(m_mapping);
+	if (m_file != INVALID_HANDLE_VALUE)
+		CloseHandle(m_file);
+	m_mapping = NULL;
+	m_file = INVALID_HANDLE_VALUE;
+#else
+	if (m_data != NULL)
+		munmap(m_data, m_size);
+	if (m_fd >= 0)
+		close(m_fd);
+	m_fd = -1;
+#endif
+	m_data = NULL;
+	m_size = 0;
+	m_writable = false;
+}
+
+bool MappedFile::IsOpen() const
+{
+#ifdef _WIN32
+	return m_file != INVALID_HANDLE_VALUE;
+#else
+	return m_fd >= 0;
+#endif
+}
+
+bool MappedFile::IsWritable() const
+{
+	return m_writable;
+}
+
+char *MappedFile::GetData() const
+{
+	return m_data;
+}
+
+size_t MappedFile::GetSize() const
+{
+	return m_size;
+}
+
+const std::string &MappedFile::GetFilename() const
+{
+	return m_filename;
+}
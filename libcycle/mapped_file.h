@@ -0,0 +1,52 @@
+#ifndef _MAPPED_FILE_
+#define _MAPPED_FILE_
+
+#include <string>
+#include <stddef.h>
+
+/*
+A file mapped into memory in full, read-only or read/write.  Files created
+here are sized up front and start zero-filled, so that writes through the
+mapping never reallocate.  Empty files are opened but not mapped, and have 
+no data.  Used by the binary trace and state files and the CSV reader.
+*/
+class MappedFile
+{
+	std::string m_filename;
+	bool m_writable;
+	char *m_data;
+	size_t m_size;
+#ifdef _WIN32
+	void *m_file;
+	void *m_mapping;
+#else
+	int m_fd;
+#endif
+
+	void Map(bool writable);
+
+	MappedFile(const MappedFile &);
+	MappedFile &operator=(const MappedFile &);
+
+public:
+	MappedFile();
+	~MappedFile();
+
+	void Create(const std::string &filename, size_t size);
+
+	void Open(const std::string &filename, bool writable = false);
+
+	void Close();
+
+	bool IsOpen() const;
+
+	bool IsWritable() const;
+
+	char *GetData() const;
+
+	size_t GetSize() const;
+
+	const std::string &GetFilename() const;
+};
+
+#endif
@@ -0,0 +1,116 @@
+#include "modes.h"
+#include <stdexcept>
+
+operating_mode OperatingModeFromString(const std::string &mode)
+{
+	/*
+	Converts an operating mode identifier to its enumeration.
+	mode -- operating (or failure) mode string, e.g., "OO"
+	*/
+	if (mode == "OFF")
+		return MODE_OFF;
+	if (mode == "OS")
+		return MODE_OS;
+	if (mode == "OF")
+		return MODE_OF;
+	if (mode == "OO")
+		return MODE_OO;
+	if (mode == "SS")
+		return MODE_SS;
+	if (mode == "SF")
+		return MODE_SF;
+	if (mode == "SO")
+		return MODE_SO;
+	if (mode == "ALL")
+		return MODE_ALL;
+	if (mode == "O")
+		return MODE_O;
+	throw std::runtime_error("invalid operating mode: " + mode);
+}
+
+std::string OperatingModeToString(operating_mode mode)
+{
+	/* Converts an operating mode enumeration to its string identifier. */
+	switch (mode)
+	{
+	case MODE_OFF:
+		return "OFF";
+	case MODE_OS:
+		return "OS";
+	case MODE_OF:
+		return "OF";
+	case MODE_OO:
+		return "OO";
+	case MODE_SS:
+		return "SS";
+	case MODE_SF:
+		return "SF";
+	case MODE_SO:
+		return "SO";
+	case MODE_ALL:
+		return "ALL";
+	case MODE_O:
+		return "O";
+	}
+	throw std::runtime_error("invalid operating mode.");
+}
+
+start_mode StartModeFromString(const std::string &start)
+{
+	/*
+	Converts a start mode identifier to its enumeration.  Any identifier other
+	than a hot, warm or cold start is treated as no start.
+	start -- start mode string, e.g., "HotStart"
+	*/
+	if (start == "HotStart")
+		return START_HOT;
+	if (start == "WarmStart")
+		return START_WARM;
+	if (start == "ColdStart")
+		return START_COLD;
+	return START_NONE;
+}
+
+std::string StartModeToString(start_mode start)
+{
+	/* Converts a start mode enumeration to its string identifier. */
+	switch (start)
+	{
+	case START_HOT:
+		return "HotStart";
+	case START_WARM:
+		return "WarmStart";
+	case START_COLD:
+		return "ColdStart";
+	default:
+		return "None";
+	}
+}
+
+repair_mode RepairModeFromString(const std::string &mode)
+{
+	/*
+	Converts a repair mode identifier to its enumeration.  Any identifier
+	other than "A" or "S" is treated as downtime only.
+	mode -- "A" (anytime), "S" (standby or downtime) or "D" (downtime only)
+	*/
+	if (mode == "A")
+		return REPAIR_ANYTIME;
+	if (mode == "S")
+		return REPAIR_STANDBY;
+	return REPAIR_DOWNTIME;
+}
+
+std::string RepairModeToString(repair_mode mode)
+{
+	/* Converts a repair mode enumeration to its string identifier. */
+	switch (mode)
+	{
+	case REPAIR_ANYTIME:
+		return "A";
+	case REPAIR_STANDBY:
+		return "S";
+	default:
+		return "D";
+	}
+}
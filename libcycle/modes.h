@@ -0,0 +1,46 @@
+#ifndef _CYCLE_MODES_
+#define _CYCLE_MODES_
+
+#include <string>
+
+/*
+Compact identifiers for the power cycle operating, start and repair modes.
+The string identifiers ("OO", "HotStart", "D", ...) remain the external
+representation for inputs, files and the string-based API; these enumerations
+are used internally so that the hourly simulation loop does no string 
+comparisons or allocations.
+*/
+
+enum operating_mode {
+	MODE_OFF,	// "OFF" - plant offline
+	MODE_OS,	// "OS" - start of online mode
+	MODE_OF,	// "OF" - first hour of online mode
+	MODE_OO,	// "OO" - ongoing (2nd hour forward) online mode
+	MODE_SS,	// "SS" - start of standby mode
+	MODE_SF,	// "SF" - first hour of standby mode
+	MODE_SO,	// "SO" - ongoing (2nd hour forward) standby mode
+	MODE_ALL,	// "ALL" - all non-downtime modes (failure modes only)
+	MODE_O		// "O" - online mode (failure modes only)
+};
+
+enum start_mode {
+	START_NONE,		// "None"
+	START_HOT,		// "HotStart"
+	START_WARM,		// "WarmStart"
+	START_COLD		// "ColdStart"
+};
+
+enum repair_mode {
+	REPAIR_ANYTIME,		// "A" - anytime
+	REPAIR_STANDBY,		// "S" - standby or downtime
+	REPAIR_DOWNTIME		// "D" - downtime only
+};
+
+operating_mode OperatingModeFromString(const std::string &mode);
+std::string OperatingModeToString(operating_mode mode);
+start_mode StartModeFromString(const std::string &start);
+std::string StartModeToString(start_mode start);
+repair_mode RepairModeFromString(const std::string &mode);
+std::string RepairModeToString(repair_mode mode);
+
+#endif
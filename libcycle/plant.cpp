@@ -3,11 +3,20 @@
 #include <iostream>
 #include <fstream>
 #include <float.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cstring>
+#include <sstream>
 #include "plant.h"
+#include "state_bundle.h"
+#include "csv_reader.h"
 
 
 PowerCycle::PowerCycle()
 {
+	m_file_writer = std::make_shared< AsyncFileWriter >();
 	SetSimulationParameters();
 	SetPlantAttributes();
 	GeneratePlantComponents();
@@ -31,6 +40,8 @@ void PowerCycle::Initialize(double age, int scen_idx)
 	{
 		m_results.period_of_last_failure[i] = -1;
 		m_results.period_of_last_repair[i] = -1;
+		if (!m_sim_params.retain_scenario_results)
+			continue;
 		m_results.cycle_capacity[i] = std::vector<double>(m_sim_params.sim_length,1.);
 		m_results.cycle_efficiency[i] = std::vector<double>(m_sim_params.sim_length, 1.);
 	}
@@ -137,6 +148,8 @@ void PowerCycle::SetSimulationParameters(
 	{
 		m_results.period_of_last_failure[i] = -1;
 		m_results.period_of_last_repair[i] = -1;
+		if (!m_sim_params.retain_scenario_results)
+			continue;
 		m_results.cycle_capacity[i] = std::vector<double>(m_sim_params.sim_length, 1.);
 		m_results.cycle_efficiency[i] = std::vector<double>(m_sim_params.sim_length, 1.);
 	}
@@ -148,12 +161,7 @@ void PowerCycle::SetCondenserEfficienciesCold(std::vector<double> eff_cold)
 	Mutator for condenser efficiencies when ambient temperature is lower than the
 	threshold.
 	*/
-	int num_streams = 0;
-	for (size_t i = 0; i < m_components.size(); i++)
-	{
-		if (m_components.at(i).GetType() == "Condenser train")
-			num_streams++;
-	}
+	int num_streams = (int)m_condenser_idx.size();
 	if (num_streams != m_num_condenser_trains)
 	{
 		throw std::runtime_error("condenser trains not created correctly");
@@ -169,12 +177,7 @@ void PowerCycle::SetCondenserEfficienciesHot(std::vector<double> eff_hot)
 	Mutator for condenser efficiencies when ambient temperature is lower than the
 	threshold.
 	*/
-	int num_streams = 0;
-	for (size_t i = 0; i < m_components.size(); i++)
-	{
-		if (m_components.at(i).GetType() == "Condenser train")
-			num_streams++;
-	}
+	int num_streams = (int)m_condenser_idx.size();
 	if ((int)eff_hot.size() != num_streams+1)
 		throw std::runtime_error("efficiencies must be equal to one plus number of streams");
 	m_condenser_efficiencies_hot = eff_hot;
@@ -186,11 +189,15 @@ void PowerCycle::ClearComponents()
 	Clears components, component index references, and any stored component status.
 	*/
 	m_components.clear();
+	m_component_state.Clear();
 	m_condenser_idx.clear();
 	m_turbine_idx.clear();
 	m_sst_idx.clear();
 	m_salt_pump_idx.clear();
-	m_start_component_status.clear();
+	m_water_pump_idx.clear();
+	m_boiler_pump_idx.clear();
+	m_start_component_values.clear();
+	m_start_component_flags.clear();
 	m_num_condenser_trains = 0;
 	m_fans_per_condenser_train = 0;
 	m_radiators_per_condenser_train = 0;
@@ -212,62 +219,41 @@ void PowerCycle::ReadComponentStatus(
 )
 {
 	/*
-	Mutator for component status for all components in the plant.
-	Used at initialization.
+	Sets the status of the components named in dstat, and stores the 
+	component state as the start state to which scenarios revert.  Other 
+	components keep their status.  Used at initialization.
 	*/
-	m_start_component_status = dstat;
-}
-
-void PowerCycle::ClearComponentStatus()
-{
-	/* clears stored status of all components. */
-	m_start_component_status.clear();
+	for (std::vector< Component >::iterator it = m_components.begin(); 
+			it != m_components.end(); it++)
+	{
+		std::unordered_map< std::string, ComponentStatus >::iterator status = 
+			dstat.find(it->GetName());
+		if (status != dstat.end())
+			it->ReadStatus(status->second);
+	}
+	StoreComponentState();
 }
 
 void PowerCycle::ReadCycleStateFromResults()
 {
 	/*
-	Reads cycle and component state from results stored in memory from previous run.
+	Reads cycle, component and RNG state from results stored in memory from 
+	previous run.  If the current scenario has no stored state, the current
+	state is kept and the scenario's RNG streams are assigned.
 	*/
-	m_current_cycle_state = m_results.plant_status[m_current_scenario];
-	m_begin_cycle_state = m_results.plant_status[m_current_scenario];
-	m_start_component_status = m_results.component_status[m_current_scenario];
-	SetStartComponentStatus();
-
-	m_life_gen->assignStates(3 * m_current_scenario);
-	m_repair_gen->assignStates(3 * m_current_scenario + 1);
-	m_binary_gen->assignStates(3 * m_current_scenario + 2);
-
 	m_failure_events = m_results.failure_events[m_current_scenario];
-	m_failure_event_labels = m_results.failure_event_labels[m_current_scenario];
-}
 
-void PowerCycle::SetStartComponentStatus()
-{
-	/*
-	Sets the status of all components to what is stored in
-	m_start_component_status. Any components not stored in the status dictionary
-	are currently skipped.
-	*/
-	for (std::vector< Component >::iterator it = m_components.begin(); 
-			it != m_components.end(); it++)
+	std::unordered_map< int, cycle_checkpoint >::const_iterator it = 
+		m_results.final_state.find(m_current_scenario);
+	if (it == m_results.final_state.end())
 	{
-		if (m_start_component_status.find(it->GetName()) != 
-			m_start_component_status.end())
-		{
-			it->ReadStatus(m_start_component_status.at(it->GetName()));
-			for (int i = 0; i < it->GetFailureTypes().size(); i++)
-			{
-				it->SetFailLifeOrProb(i, m_start_component_status.at(it->GetName()).lifetimes.at(i));
-			}
-		}
-		/*
-		else
-		{
-			it->GenerateInitialLifesAndProbs(*m_gen);
-		}
-		*/
+		m_life_gen->assignStates(3 * m_current_scenario);
+		m_repair_gen->assignStates(3 * m_current_scenario + 1);
+		m_binary_gen->assignStates(3 * m_current_scenario + 2);
+		return;
 	}
+	RestoreCheckpoint(it->second);
+	m_begin_cycle_state = m_current_cycle_state;
 }
 
 void PowerCycle::StoreComponentState()
@@ -277,14 +263,7 @@ void PowerCycle::StoreComponentState()
 	component state.  Done either right after the initialization
 	or after a simulation run generates no new failures.
 	*/
-	for (
-		std::vector< Component >::iterator it = m_components.begin();
-		it != m_components.end();
-		it++
-		)
-	{
-		m_start_component_status[it->GetName()] = it->GetState();
-	}
+	m_component_state.SaveState(m_start_component_values, m_start_component_flags);
 }
 
 void PowerCycle::StorePlantParamsState()
@@ -329,8 +308,7 @@ void PowerCycle::RecordFinalState()
 	Assigns current power cycle state to the beginning component state.  
 	Done if no failures are found in the run.
 	*/
-	m_results.plant_status[m_current_scenario] = m_current_cycle_state;
-	m_results.component_status[m_current_scenario] = GetComponentStates();
+	SaveCheckpoint(m_results.final_state[m_current_scenario]);
 
 	m_life_gen->saveStates(3 * m_current_scenario);
 	m_repair_gen->saveStates(3 * m_current_scenario + 1);
@@ -364,7 +342,7 @@ void PowerCycle::RevertToStartState(bool reset_rng)
 	m_current_cycle_state.boiler_pump_switch_time = m_begin_cycle_state.boiler_pump_switch_time*1.0;
 	m_current_cycle_state.water_pump_switch_time = m_begin_cycle_state.water_pump_switch_time*1.0;
 
-	SetStartComponentStatus();
+	m_component_state.RestoreState(m_start_component_values, m_start_component_flags);
 	if (reset_rng)
 	{
 		m_life_gen->assignStates(3 * m_current_scenario);
@@ -374,10 +352,211 @@ void PowerCycle::RevertToStartState(bool reset_rng)
 		
 }
 
+void PowerCycle::SaveCheckpoint(cycle_checkpoint &cp, int t)
+{
+	/*
+	Captures the simulation state of the plant in the current scenario: 
+	cycle state, component state, RNG positions and the number of failure
+	events recorded.  Only flat arrays are copied, and 'cp' keeps its 
+	allocations when overwritten, so this can be done as often as needed.
+
+	cp -- checkpoint to overwrite
+	t -- first period to simulate when the checkpoint is restored
+	*/
+	cp.scenario = m_current_scenario;
+	cp.period = t;
+	cp.plant_state = m_current_cycle_state;
+	cp.cycle_capacity = m_cycle_capacity;
+	cp.cycle_efficiency = m_cycle_efficiency;
+	cp.new_failure_occurred = m_new_failure_occurred;
+	cp.new_repair_occurred = m_new_repair_occurred;
+	m_component_state.SaveState(cp.component_values, cp.component_flags);
+	m_life_gen->getState(cp.rng_states[0], cp.rng_state_is[0]);
+	m_repair_gen->getState(cp.rng_states[1], cp.rng_state_is[1]);
+	m_binary_gen->getState(cp.rng_states[2], cp.rng_state_is[2]);
+	cp.num_failure_events = m_failure_events.Size();
+}
+
+void PowerCycle::RestoreCheckpoint(const cycle_checkpoint &cp)
+{
+	/*
+	Returns the plant to the state captured by SaveCheckpoint(); failure 
+	events recorded after the checkpoint are dropped.  The plant must have 
+	the same components as when the checkpoint was taken.
+
+	cp -- checkpoint to restore
+	*/
+	if (m_failure_events.Size() < cp.num_failure_events)
+		throw std::runtime_error("failure event history is shorter than at the checkpoint.");
+	m_current_scenario = cp.scenario;
+	RestorePlantState(cp);
+	m_life_gen->setState(cp.rng_states[0], cp.rng_state_is[0]);
+	m_repair_gen->setState(cp.rng_states[1], cp.rng_state_is[1]);
+	m_binary_gen->setState(cp.rng_states[2], cp.rng_state_is[2]);
+	m_failure_events.Truncate(cp.num_failure_events);
+}
+
+void PowerCycle::RestorePlantState(const cycle_checkpoint &cp)
+{
+	/*
+	Restores the cycle and component state of a checkpoint, leaving the RNG
+	streams and the failure event history as they are.
+	cp -- checkpoint to restore
+	*/
+	m_current_cycle_state = cp.plant_state;
+	m_cycle_capacity = cp.cycle_capacity;
+	m_cycle_efficiency = cp.cycle_efficiency;
+	m_new_failure_occurred = cp.new_failure_occurred;
+	m_new_repair_occurred = cp.new_repair_occurred;
+	m_component_state.RestoreState(cp.component_values, cp.component_flags);
+}
+
+uint64_t PowerCycle::HashDispatch(int t0, int t1, uint64_t h)
+{
+	/*
+	Extends a 64-bit FNV-1a hash of the dispatch inputs read by RunDispatch()
+	over periods [t0, t1).  Starting from t0 = 0, the hash also covers the 
+	simulation length and step length, so that the hash of [0, t) identifies
+	the inputs that a run sees before period t.
+	t0 -- first period to add
+	t1 -- period after the last period to add
+	h -- hash of the periods before t0 (ignored if t0 == 0)
+	retval -- hash of the periods before t1
+	*/
+	const uint64_t prime = 1099511628211ULL;
+	uint64_t bits;
+	if (t0 == 0)
+	{
+		h = 14695981039346656037ULL;
+		h = (h ^ (uint64_t)m_sim_params.sim_length) * prime;
+		std::memcpy(&bits, &m_sim_params.steplength, sizeof(bits));
+		h = (h ^ bits) * prime;
+	}
+	const std::vector<double> *inputs[4] = {
+		&m_dispatch.at("cycle_power"),
+		&m_dispatch.at("thermal_power"),
+		&m_dispatch.at("standby"),
+		&m_dispatch.at("ambient_temperature")
+	};
+	for (int t = t0; t < t1; t++)
+	{
+		for (int k = 0; k < 4; k++)
+		{
+			std::memcpy(&bits, &inputs[k]->at(t), sizeof(bits));
+			h = (h ^ bits) * prime;
+		}
+	}
+	return h;
+}
+
+void PowerCycle::RecordRunCheckpoint(int t, int period_of_last_failure, 
+	int period_of_last_repair)
+{
+	/*
+	Appends a checkpoint at the start of period t to the run checkpoints of
+	the current scenario.  Called by RunDispatch() only while no period of the
+	run so far has generated events or drawn random numbers.
+	t -- first period to simulate when resuming from the checkpoint
+	period_of_last_failure -- period of last failure at the start of the run
+	period_of_last_repair -- period of last repair at the start of the run
+	*/
+	std::vector< cycle_run_checkpoint > &checkpoints = 
+		m_results.run_checkpoints[m_current_scenario];
+	uint64_t h = checkpoints.empty() ? HashDispatch(0, t, 0) : 
+		HashDispatch(checkpoints.back().state.period, t, checkpoints.back().dispatch_hash);
+	checkpoints.push_back(cycle_run_checkpoint());
+	cycle_run_checkpoint &cp = checkpoints.back();
+	SaveCheckpoint(cp.state, t);
+	cp.period_of_last_failure = period_of_last_failure;
+	cp.period_of_last_repair = period_of_last_repair;
+	cp.dispatch_hash = h;
+}
+
+int PowerCycle::ResumeFromRunCheckpoint(std::vector<double> &cycle_capacities,
+	std::vector<double> &cycle_efficiencies)
+{
+	/*
+	Restores the latest run checkpoint of the current scenario that this run
+	would reach in the same state, and copies the cycle capacities and 
+	efficiencies of the previous run for the periods before it.  That holds 
+	if the periods before the checkpoint are treated alike in both runs, i.e.,
+	the periods of last failure and repair of each run are either equal or 
+	both at or after the period before the checkpoint, and the dispatch in 
+	those periods is the same.  Since checkpoints are only taken before any 
+	event or random draw of a run, the RNG streams and the failure event 
+	history are left as they are.  Checkpoints that do not apply to this run
+	are discarded.
+
+	This assumes the run starts from the stored state that the previous run
+	of the scenario reverted to; see SingleScen().
+
+	cycle_capacities -- cycle capacity by period (updated)
+	cycle_efficiencies -- cycle efficiency by period (updated)
+	retval -- first period to simulate
+	*/
+	int s = m_current_scenario;
+	std::vector< cycle_run_checkpoint > &checkpoints = m_results.run_checkpoints[s];
+	std::unordered_map< int, std::vector< double > >::const_iterator cap = 
+		m_results.cycle_capacity.find(s);
+	std::unordered_map< int, std::vector< double > >::const_iterator eff = 
+		m_results.cycle_efficiency.find(s);
+	if (cap == m_results.cycle_capacity.end() || eff == m_results.cycle_efficiency.end() ||
+		(int)cap->second.size() != m_sim_params.sim_length ||
+		(int)eff->second.size() != m_sim_params.sim_length)
+	{
+		checkpoints.clear();
+		return 0;
+	}
+	int plf = m_results.period_of_last_failure[s];
+	int plr = m_results.period_of_last_repair[s];
+	uint64_t h = 0;
+	int t0 = 0;
+	size_t k = 0;
+	for (; k < checkpoints.size(); k++)
+	{
+		const cycle_run_checkpoint &cp = checkpoints.at(k);
+		int t = cp.state.period;
+		if (t > m_sim_params.sim_length)
+			break;
+		if (plf != cp.period_of_last_failure && (plf < t - 1 || cp.period_of_last_failure < t - 1))
+			break;
+		if (plr != cp.period_of_last_repair && (plr < t - 1 || cp.period_of_last_repair < t - 1))
+			break;
+		h = HashDispatch(t0, t, h);
+		t0 = t;
+		if (h != cp.dispatch_hash)
+			break;
+	}
+	checkpoints.resize(k);
+	if (k == 0)
+		return 0;
+
+	const cycle_checkpoint &cp = checkpoints.back().state;
+	RestorePlantState(cp);
+	std::copy(cap->second.begin(), cap->second.begin() + cp.period, cycle_capacities.begin());
+	std::copy(eff->second.begin(), eff->second.begin() + cp.period, cycle_efficiencies.begin());
+	return cp.period;
+}
+
 void PowerCycle::WriteStateToFiles()
 {
 	/*
-	Writes the current state of the plant to output files, one for all components and one for the plant.
+	Writes the current state of the plant to output files: the binary state 
+	bundle if use_state_bundle is set, and the text files otherwise.
+	*/
+	if (m_file_settings.use_state_bundle)
+		WriteStateBundle();
+	else
+		WriteStateTextFiles();
+	FlushOutputFiles();
+}
+
+void PowerCycle::WriteStateTextFiles()
+{
+	/*
+	Writes the current state of the plant to text files: the plant layout, 
+	components, plant state, simulation parameters, RNG streams, and cycle 
+	capacity and efficiency.  Also used to export a state read from a bundle.
 	*/
 	WritePlantLayoutFile();
 	WriteComponentFile();
@@ -404,6 +583,106 @@ void PowerCycle::WriteStateToFiles()
 	WriteCapEffFile();
 }
 
+void PowerCycle::WriteStateBundle()
+{
+	/*
+	Writes the state written by WriteStateTextFiles to a single binary state 
+	bundle (see StateBundle), with full precision.  The component section 
+	holds the complete component state arrays, including ages and flags.
+	*/
+	std::vector< StateBundleSection > sections;
+
+	sections.push_back(StateBundleSection(BUNDLE_SIM_PARAMS));
+	StateBundleSection &sp = sections.back();
+	sp.PutInt(m_sim_params.read_periods);
+	sp.PutInt(m_sim_params.sim_length);
+	sp.PutDouble(m_sim_params.steplength);
+	sp.PutInt(m_sim_params.print_output);
+	sp.PutInt(m_sim_params.num_scenarios);
+	sp.PutDouble(m_sim_params.hourly_labor_cost);
+	sp.PutInt(m_sim_params.stop_at_first_repair);
+	sp.PutInt(m_sim_params.stop_at_first_failure);
+
+	sections.push_back(StateBundleSection(BUNDLE_LAYOUT));
+	StateBundleSection &layout = sections.back();
+	layout.PutInt(m_num_condenser_trains);
+	layout.PutInt(m_fans_per_condenser_train);
+	layout.PutInt(m_radiators_per_condenser_train);
+	layout.PutInt(m_num_salt_steam_trains);
+	layout.PutInt(m_num_feedwater_heaters);
+	layout.PutInt(m_num_salt_pumps);
+	layout.PutInt(m_num_salt_pumps_required);
+	layout.PutInt(m_num_water_pumps);
+	layout.PutInt(m_num_water_pumps_required);
+	layout.PutInt(m_num_boiler_pumps);
+	layout.PutInt(m_num_boiler_pumps_required);
+	layout.PutInt(m_num_turbines);
+	layout.PutDoubles(m_condenser_efficiencies_cold);
+	layout.PutDoubles(m_condenser_efficiencies_hot);
+
+	//as in the component file, report the start state if the run is to be repeated
+	sections.push_back(StateBundleSection(BUNDLE_COMPONENTS));
+	StateBundleSection &comp = sections.back();
+	if (m_results.period_of_last_failure[m_current_scenario] == -1 &&
+		m_results.period_of_last_repair[m_current_scenario] == -1)
+	{
+		std::vector< double > values;
+		std::vector< unsigned char > flags;
+		m_component_state.SaveState(values, flags);
+		comp.PutDoubles(values);
+		comp.PutBytes(flags);
+	}
+	else
+	{
+		comp.PutDoubles(m_start_component_values);
+		comp.PutBytes(m_start_component_flags);
+	}
+
+	sections.push_back(StateBundleSection(BUNDLE_PLANT_STATE));
+	StateBundleSection &ps = sections.back();
+	ps.PutDouble(m_current_cycle_state.capacity);
+	ps.PutDouble(m_current_cycle_state.cold_start_penalty);
+	ps.PutDouble(m_current_cycle_state.warm_start_penalty);
+	ps.PutDouble(m_current_cycle_state.hot_start_penalty);
+	ps.PutDouble(m_current_cycle_state.downtime);
+	ps.PutDouble(m_current_cycle_state.downtime_threshold);
+	ps.PutInt(m_current_cycle_state.is_online);
+	ps.PutInt(m_current_cycle_state.is_on_standby);
+	ps.PutDouble(m_current_cycle_state.maintenance_duration);
+	ps.PutDouble(m_current_cycle_state.maintenance_interval);
+	ps.PutDouble(m_current_cycle_state.hours_to_maintenance);
+	ps.PutDouble(m_current_cycle_state.temp_threshold);
+	ps.PutDouble(m_current_cycle_state.time_in_standby);
+	ps.PutDouble(m_current_cycle_state.time_online);
+	ps.PutDouble(m_current_cycle_state.power_output);
+	ps.PutDouble(m_current_cycle_state.thermal_output);
+	ps.PutDouble(m_current_cycle_state.salt_pump_switch_time);
+	ps.PutDouble(m_current_cycle_state.boiler_pump_switch_time);
+	ps.PutDouble(m_current_cycle_state.water_pump_switch_time);
+
+	sections.push_back(StateBundleSection(BUNDLE_CAP_EFF));
+	StateBundleSection &ce = sections.back();
+	ce.PutInt(m_results.period_of_last_failure[m_current_scenario]);
+	ce.PutInt(m_results.period_of_last_repair[m_current_scenario]);
+	ce.PutDoubles(m_results.cycle_capacity[m_current_scenario]);
+	ce.PutDoubles(m_results.cycle_efficiency[m_current_scenario]);
+
+	sections.push_back(StateBundleSection(BUNDLE_RNG));
+	StateBundleSection &rng = sections.back();
+	rng.PutInt(m_current_scenario);
+	WELLFiveTwelve *gens[3] = { m_life_gen, m_repair_gen, m_binary_gen };
+	for (int k = 0; k < 3; k++)
+	{
+		int stream = 3 * m_current_scenario + k;
+		if (gens[k]->m_stored_states.find(stream) == gens[k]->m_stored_states.end())
+			throw std::runtime_error("no stored RNG state for the current scenario.");
+		rng.PutWords(&gens[k]->m_stored_states[stream][0], 16);
+		rng.PutInt(gens[k]->m_stored_state_is[stream]);
+	}
+
+	StateBundle::Write(m_file_settings.state_bundle_filename + ".bin", sections);
+}
+
 void PowerCycle::WritePlantLayoutFile()
 { 
 	std::string filename = (
@@ -455,7 +734,15 @@ void PowerCycle::WriteComponentFile()
 		m_results.period_of_last_repair[m_current_scenario] == -1)
 		component_status = GetComponentStates();
 	else
-		component_status = m_start_component_status;
+	{
+		//report the start state, then return to the current one
+		std::vector< double > values;
+		std::vector< unsigned char > flags;
+		m_component_state.SaveState(values, flags);
+		m_component_state.RestoreState(m_start_component_values, m_start_component_flags);
+		component_status = GetComponentStates();
+		m_component_state.RestoreState(values, flags);
+	}
 	cfile.open(component_filename);
 	cfile << "name,hazard_rate,downtime_remaining,repair_event_time,lifesprobs\n";
 	ComponentStatus status;
@@ -537,28 +824,21 @@ void PowerCycle::WriteFailuresFile()
 		//std::to_string(m_current_scenario) + 
 		".csv"
 		);
-	std::ofstream ofile;
-	if (m_file_settings.day_idx == 0)
-	{
-		ofile.open(failure_filename);
-	}
-	else
-	{
-		ofile.open(failure_filename, std::ios::app);
-	}
-	for (size_t i = 0; i < m_failure_event_labels.size(); i++)
+	std::ostringstream ofile;
+	for (size_t i = 0; i < m_failure_events.Size(); i++)
 	{
-		ofile << m_failure_event_labels.at(i) << ","
-			<< m_failure_events[m_failure_event_labels.at(i)].time << ","
-			<< m_failure_events[m_failure_event_labels.at(i)].component << ","
-			<< m_failure_events[m_failure_event_labels.at(i)].fail_idx << ","
-			<< m_failure_events[m_failure_event_labels.at(i)].duration << ","
-			<< m_failure_events[m_failure_event_labels.at(i)].labor << ","
-			<< m_failure_events[m_failure_event_labels.at(i)].new_life << ","
-			<< m_failure_events[m_failure_event_labels.at(i)].scen_index
+		const failure_event &e = m_failure_events.At(i);
+		ofile << m_failure_events.GetLabel(i) << ","
+			<< e.time << ","
+			<< e.component << ","
+			<< e.fail_idx << ","
+			<< e.duration << ","
+			<< e.labor << ","
+			<< e.new_life << ","
+			<< e.scen_index
 			<< "\n";
 	}
-	ofile.close();
+	m_file_writer->Write(failure_filename, ofile.str(), m_file_settings.day_idx != 0);
 }
 
 
@@ -580,8 +860,7 @@ void PowerCycle::WriteAMPLParams(int extra_periods)
 	}
 	filename += std::to_string(m_file_settings.day_idx); */
 	filename += ".dat";
-	std::ofstream outfile;
-	outfile.open(filename);
+	std::ostringstream outfile;
 	int period = -1;
 	if (m_sim_params.stop_at_first_failure &&
 		!m_sim_params.stop_at_first_repair && NewFailureOccurred())
@@ -645,10 +924,8 @@ void PowerCycle::WriteAMPLParams(int extra_periods)
 		outfile << (i + 1) << "  " << "1.0" << "\n";
 	}
 	outfile << ";\n\n";
-
-
-	outfile.close();
 	*/
+	m_file_writer->Write(filename, outfile.str());
 }
 
 void PowerCycle::WriteAMPLParamsToDefault()
@@ -670,8 +947,7 @@ void PowerCycle::WriteAMPLParamsToDefault()
 		m_file_settings.ampl_param_file
 		);
 	filename += ".dat";
-	std::ofstream outfile;
-	outfile.open(filename);
+	std::ostringstream outfile;
 	outfile << "param Feff := \n";
 	//for (int i = 0; i < m_sim_params.sim_length; i++)
 	//{
@@ -704,6 +980,7 @@ void PowerCycle::WriteAMPLParamsToDefault()
 		ctr++;
 	}
 	outfile << ";\n\n";
+	m_file_writer->Write(filename, outfile.str());
 }
 
 void PowerCycle::WriteCapEffFile()
@@ -719,8 +996,7 @@ void PowerCycle::WriteCapEffFile()
 		//+ m_current_scenario
 		+".csv"
 		);
-	std::ofstream ofile;
-	ofile.open(cap_eff_file);
+	std::ostringstream ofile;
 	//period of last failure
 	ofile << m_results.period_of_last_failure[m_current_scenario] << ",";
 	//period of last repair
@@ -737,7 +1013,7 @@ void PowerCycle::WriteCapEffFile()
 		ofile << m_results.cycle_efficiency[m_current_scenario].at(i) << ",";
 	}
 	ofile << m_results.cycle_efficiency[m_current_scenario].at(m_results.cycle_efficiency[m_current_scenario].size() - 1) << "\n";
-	ofile.close();
+	m_file_writer->Write(cap_eff_file, ofile.str());
 }
 
 void PowerCycle::WriteFinalEffFile()
@@ -748,36 +1024,43 @@ void PowerCycle::WriteFinalEffFile()
 	*/
 	
 	std::string final_cap_eff_file = ("final_eff.csv");
-	std::ofstream ofile;
-	if (m_file_settings.day_idx == 0){
-		ofile.open(final_cap_eff_file, std::ofstream::trunc);
-	} else ofile.open(final_cap_eff_file, std::ofstream::app);
+	std::ostringstream ofile;
 	
 	//capacity and efficiency time series
 	for (size_t i = 0; i < m_results.cycle_efficiency[m_current_scenario].size(); i++)
 	{
 		ofile << m_results.cycle_efficiency[m_current_scenario].at(i) << ",";
 	}
-	ofile.close();
+	m_file_writer->Write(final_cap_eff_file, ofile.str(), m_file_settings.day_idx != 0);
 }
 
 void PowerCycle::WriteFailureStats()
 {
-	std::ofstream ofile;
-	if (m_file_settings.day_idx == 0) 
-	{
-		ofile.open(m_file_settings.num_failures_file+".csv", std::ofstream::trunc);
-	}
-	else 
-	{
-		ofile.open(m_file_settings.num_failures_file + ".csv", std::ofstream::app);
-	}
-	ofile << m_file_settings.day_idx << "," << m_failure_event_labels.size() << "\n";
-	ofile.close();
+	std::ostringstream ofile;
+	ofile << m_file_settings.day_idx << "," << m_failure_events.Size() << "\n";
+	m_file_writer->Write(m_file_settings.num_failures_file + ".csv", ofile.str(), 
+		m_file_settings.day_idx != 0);
+}
+
+void PowerCycle::FlushOutputFiles()
+{
+	/*
+	Waits until all output files queued by the Write methods are written.
+	Called at the end of Simulate() and WriteStateToFiles(), and before the
+	state is read from files; call it before reading an output file written
+	by a direct call to one of the Write methods.
+	*/
+	m_file_writer->Flush();
 }
 
 void PowerCycle::ReadStateFromFiles(bool init)
 {
+	FlushOutputFiles();
+	if (m_file_settings.use_state_bundle && !init)
+	{
+		ReadStateBundle();
+		return;
+	}
 	ReadSimParamsFile();
 	ReadPolicyFile();
 	ReadDayIDXFile();
@@ -813,6 +1096,97 @@ void PowerCycle::ReadStateFromFiles(bool init)
 	);
 }
 
+void PowerCycle::ReadStateBundle()
+{
+	/*
+	Reads the plant state written by WriteStateBundle, in place of the text 
+	state files.  The policy, day index and dispatch files are inputs from 
+	the dispatch model, and are read as text as before.
+	*/
+	StateBundle bundle;
+	bundle.Open(m_file_settings.state_bundle_filename + ".bin");
+
+	StateBundleReader sp = bundle.GetSection(BUNDLE_SIM_PARAMS);
+	m_sim_params.read_periods = (int)sp.GetInt();
+	m_sim_params.sim_length = (int)sp.GetInt();
+	m_sim_params.steplength = sp.GetDouble();
+	m_sim_params.print_output = sp.GetInt() != 0;
+	m_sim_params.num_scenarios = (int)sp.GetInt();
+	m_sim_params.hourly_labor_cost = sp.GetDouble();
+	m_sim_params.stop_at_first_repair = sp.GetInt() != 0;
+	m_sim_params.stop_at_first_failure = sp.GetInt() != 0;
+
+	ReadPolicyFile();
+	ReadDayIDXFile();
+
+	StateBundleReader layout = bundle.GetSection(BUNDLE_LAYOUT);
+	int counts[12];
+	for (int i = 0; i < 12; i++)
+		counts[i] = (int)layout.GetInt();
+	std::vector< double > eff_cold, eff_hot;
+	layout.GetDoubles(eff_cold);
+	layout.GetDoubles(eff_hot);
+	GeneratePlantComponents(
+		counts[0], counts[1], counts[2], counts[3], counts[4], counts[5],
+		counts[6], counts[7], counts[8], counts[9], counts[10], counts[11],
+		eff_cold, eff_hot
+	);
+	ReadDispatchFile();
+
+	StateBundleReader comp = bundle.GetSection(BUNDLE_COMPONENTS);
+	std::vector< double > values;
+	std::vector< unsigned char > flags;
+	comp.GetDoubles(values);
+	comp.GetBytes(flags);
+	m_component_state.RestoreState(values, flags);
+	StoreComponentState();
+
+	StateBundleReader ps = bundle.GetSection(BUNDLE_PLANT_STATE);
+	m_current_cycle_state.capacity = ps.GetDouble();
+	m_current_cycle_state.cold_start_penalty = ps.GetDouble();
+	m_current_cycle_state.warm_start_penalty = ps.GetDouble();
+	m_current_cycle_state.hot_start_penalty = ps.GetDouble();
+	m_current_cycle_state.downtime = ps.GetDouble();
+	m_current_cycle_state.downtime_threshold = ps.GetDouble();
+	m_current_cycle_state.is_online = ps.GetInt() != 0;
+	m_current_cycle_state.is_on_standby = ps.GetInt() != 0;
+	m_current_cycle_state.maintenance_duration = ps.GetDouble();
+	m_current_cycle_state.maintenance_interval = ps.GetDouble();
+	m_current_cycle_state.hours_to_maintenance = ps.GetDouble();
+	m_current_cycle_state.temp_threshold = ps.GetDouble();
+	m_current_cycle_state.time_in_standby = ps.GetDouble();
+	m_current_cycle_state.time_online = ps.GetDouble();
+	m_current_cycle_state.power_output = ps.GetDouble();
+	m_current_cycle_state.thermal_output = ps.GetDouble();
+	m_current_cycle_state.salt_pump_switch_time = ps.GetDouble();
+	m_current_cycle_state.boiler_pump_switch_time = ps.GetDouble();
+	m_current_cycle_state.water_pump_switch_time = ps.GetDouble();
+	StorePlantParamsState();
+
+	//as in the capacity/efficiency file, series are all ones unless a run is repeated
+	StateBundleReader ce = bundle.GetSection(BUNDLE_CAP_EFF);
+	m_results.period_of_last_failure[m_current_scenario] = (int)ce.GetInt();
+	m_results.period_of_last_repair[m_current_scenario] = (int)ce.GetInt();
+	if (m_results.period_of_last_failure[m_current_scenario] != -1 ||
+		m_results.period_of_last_repair[m_current_scenario] != -1)
+	{
+		ce.GetDoubles(m_results.cycle_capacity[m_current_scenario]);
+		ce.GetDoubles(m_results.cycle_efficiency[m_current_scenario]);
+	}
+
+	StateBundleReader rng = bundle.GetSection(BUNDLE_RNG);
+	if ((int)rng.GetInt() != m_current_scenario)
+		throw std::runtime_error("state bundle was written for another scenario.");
+	WELLFiveTwelve *gens[3] = { m_life_gen, m_repair_gen, m_binary_gen };
+	for (int k = 0; k < 3; k++)
+	{
+		uint32_t words[16];
+		rng.GetWords(words, 16);
+		gens[k]->setState(words, (int)rng.GetInt());
+		gens[k]->saveStates(3 * m_current_scenario + k);
+	}
+}
+
 void PowerCycle::ReadPlantLayoutFile()
 {
 	std::string filename = (
@@ -1101,115 +1475,61 @@ void PowerCycle::ReadPolicyFile()
 
 void PowerCycle::ReadFailuresFromFile()
 {
+	/*
+	Reads the failure events written by WriteFailuresFile into the failure
+	event store, replacing any events recorded so far.  Each line holds the
+	label, period, component, failure index, duration, labor, new life and
+	scenario of an event.
+	*/
 	std::string failure_filename = (
 		m_file_settings.failure_file +
 		//std::to_string(m_current_scenario) + 
 		".csv"
 		);
-	std::ifstream cfile;
-	size_t pos = 0;
-	std::string delimiter = ",";
-	cfile.open(failure_filename);
-	std::string cline;
-	std::vector<std::string> split_line = {};
-	//getline(cfile, cline);
-	//std::vector <double> lifes_probs;
-	std::string label;
-	int time;
-	std::string component;
-	int fail_idx;
-	double duration; 
-	double labor; 
-	double new_life;
-	int scen_index;
-	//(int time, std::string component, int fail_idx, double duration,
-	//	double labor, double new_life, int scen_index)
-	int cindex = 0;
-	std::string token;
-
-
-	while (!cfile.eof())
+	CsvReader cfile;
+	cfile.Open(failure_filename);
+	m_failure_events.Clear();
+	while (cfile.NextLine())
 	{
-		//lifes_probs.clear();
-		m_failure_events.clear();
-		m_failure_event_labels.clear();
-		pos = 0;
-		getline(cfile, cline);
-		//std::cerr << cline;
-		while (pos != std::string::npos) {
-			pos = cline.find(delimiter);
-			token = cline.substr(0, pos);
-			split_line.push_back(token);
-			cline.erase(0, pos + delimiter.length());
-		}
-		if (split_line.size() > 6)
-		{
-			label = split_line[0];
-			time = std::stoi(split_line[1]);
-			component = split_line[2];
-			fail_idx = std::stoi(split_line[3]);
-			duration = std::stod(split_line[4]);
-			labor = std::stod(split_line[5]);
-			new_life = std::stod(split_line[6]);
-			scen_index = std::stoi(split_line[7]);
-			
-			m_failure_event_labels.push_back(label);
-			m_failure_events[label] = failure_event(
-				time,
-				component,
-				fail_idx,
-				duration,
-				labor,
-				new_life,
-				scen_index
-			);
-		}
-		split_line.clear();
-		cindex++;
+		if (cfile.CountFields() < 8)
+			continue;
+		cfile.SkipField();  //label, rebuilt from the event
+		failure_event e;
+		e.time = cfile.GetInt();
+		e.component = cfile.GetString();
+		e.fail_idx = cfile.GetInt();
+		e.duration = cfile.GetDouble();
+		e.labor = cfile.GetDouble();
+		e.new_life = cfile.GetDouble();
+		e.scen_index = cfile.GetInt();
+		m_failure_events.Add(GetFailureEventKey(e), e);
 	}
 }
 
 void PowerCycle::ReadDispatchFile(int max_rows)
 {
+	/*
+	Reads the dispatch file: a header line, then one line per period with
+	the cycle power, standby indicator, ambient temperature and thermal power.
+	max_rows -- maximum number of lines to read after the header
+	*/
 	std::unordered_map<std::string, std::vector <double> > data = {};
-	data["standby"] = {};
-	data["cycle_power"] = {};
-	data["ambient_temperature"] = {};
-	data["thermal_power"] = {};
+	std::vector< double > &cycle_power = data["cycle_power"];
+	std::vector< double > &standby = data["standby"];
+	std::vector< double > &ambient_temperature = data["ambient_temperature"];
+	std::vector< double > &thermal_power = data["thermal_power"];
 	std::string dispatch_file = (
 		m_file_settings.ampl_dispatch_file +
 		//std::to_string(m_file_settings.day_idx) +
 		".csv"
 		);
-	std::ifstream dfile;
-	size_t pos = 0;
-	std::string delimiter = ",";
-	dfile.open(dispatch_file);
-	std::string dline;
-	std::vector<std::string> split_line = {};
-	std::string token;
-	int cindex = 0;
-	getline(dfile, dline);
-	while (cindex <= max_rows && !dfile.eof())
-	{
-		cindex++;
-		pos = 0;
-		getline(dfile, dline);
-		while (pos != std::string::npos) {
-			pos = dline.find(delimiter);
-			token = dline.substr(0, pos);
-			split_line.push_back(token);
-			dline.erase(0, pos + delimiter.length());
-		}
-		if (split_line.size() > 3)
-		{
-			data["cycle_power"].push_back(std::stod(split_line[0]));
-			data["standby"].push_back(std::stod(split_line[1]));
-			data["ambient_temperature"].push_back(std::stod(split_line[2]));
-			data["thermal_power"].push_back(std::stod(split_line[3]));
-		}
-		split_line.clear();
-	}
+	CsvReader dfile;
+	dfile.Open(dispatch_file);
+	dfile.NextLine();
+	std::vector< std::vector<double>* > columns = { 
+		&cycle_power, &standby, &ambient_temperature, &thermal_power 
+	};
+	dfile.ReadColumns(columns, max_rows > 0 ? (size_t)max_rows : 0);
 
 	SetDispatch(data, true);
 }
@@ -1223,24 +1543,13 @@ void PowerCycle::ReadCapEffFile()
 	and cycle_capacity are overridden to all ones.
 	*/
 	std::string cap_eff_filename = "capeff.csv";
-	std::ifstream pfile;
-	std::string delimiter = ",";
-	size_t pos = 0;
-	std::string pline;
-	std::vector<std::string> split_line = {};
-	std::string token;
-	pfile.open(cap_eff_filename);
+	CsvReader pfile;
+	pfile.Open(cap_eff_filename);
 	//first line: failure and repair periods
-	getline(pfile, pline);
-	while (pos != std::string::npos)
-	{
-		pos = pline.find(delimiter);
-		token = pline.substr(0, pos);
-		split_line.push_back(token);
-		pline.erase(0, pos + delimiter.length());
-	}
-	m_results.period_of_last_failure[m_current_scenario] = std::stoi(split_line[0]);
-	m_results.period_of_last_repair[m_current_scenario] = std::stoi(split_line[1]);
+	if (!pfile.NextLine())
+		throw std::runtime_error(cap_eff_filename + " is empty.");
+	m_results.period_of_last_failure[m_current_scenario] = pfile.GetInt();
+	m_results.period_of_last_repair[m_current_scenario] = pfile.GetInt();
 	if (
 		m_results.period_of_last_failure[m_current_scenario] == -1 &&
 		m_results.period_of_last_repair[m_current_scenario] == -1
@@ -1252,37 +1561,18 @@ void PowerCycle::ReadCapEffFile()
 	}
 	//if the period of last failure/repair is not -1, then read in the 
 	//cycle efficiency and cycle capacity from the file. 
-	split_line.clear();
-	getline(pfile, pline);
-	pos = 0;
-	while (pos != std::string::npos)
-	{
-		pos = pline.find(delimiter);
-		token = pline.substr(0, pos);
-		split_line.push_back(token);
-		pline.erase(0, pos + delimiter.length());
-	}
-	m_results.cycle_capacity[m_current_scenario].clear();
-	m_results.cycle_efficiency[m_current_scenario].clear();
-	for (int i = 0; i < m_sim_params.sim_length; i++)
-	{
-		m_results.cycle_capacity[m_current_scenario].push_back(std::stod(split_line[i]));
-	}
-	split_line.clear();
-	getline(pfile, pline);
-	pos = 0;
-	while (pos != std::string::npos)
+	std::vector< double > *series[2] = {
+		&m_results.cycle_capacity[m_current_scenario],
+		&m_results.cycle_efficiency[m_current_scenario]
+	};
+	for (int k = 0; k < 2; k++)
 	{
-		pos = pline.find(delimiter);
-		token = pline.substr(0, pos);
-		split_line.push_back(token);
-		pline.erase(0, pos + delimiter.length());
+		if (!pfile.NextLine())
+			throw std::runtime_error(cap_eff_filename + " has too few lines.");
+		series[k]->resize(m_sim_params.sim_length);
+		for (int i = 0; i < m_sim_params.sim_length; i++)
+			series[k]->at(i) = pfile.GetDouble();
 	}
-	for (int i = 0; i < m_sim_params.sim_length; i++)
-	{
-		m_results.cycle_efficiency[m_current_scenario].push_back(std::stod(split_line[i]));
-	}
-	pfile.close();
 }
 
 std::vector< Component > &PowerCycle::GetComponents()
@@ -1322,11 +1612,7 @@ std::vector< double >  PowerCycle::GetComponentDowntimes()
 	accessor to component downtimes (zero if component is operational).
 	retval -- linked list of downtime remaining of each component.
 	*/
-    std::vector<double> down;
-
-    for(size_t i=0; i<m_components.size(); i++)
-        down.push_back( m_components.at(i).GetDowntimeRemaining() );
-    return down;
+    return m_component_state.downtime_remaining;
 }
 
 bool PowerCycle::AirstreamOnline()
@@ -1336,8 +1622,8 @@ bool PowerCycle::AirstreamOnline()
 	otherwise  Used to determine cycle Capacity (which is zero if this
 	is false, as the plant can't operate with no airstreams.)
 	*/
-	for (size_t i = 0; i<m_components.size(); i++)
-		if (m_components.at(i).GetType() == "Condenser train" && m_components.at(i).IsOperational())
+	for (size_t i : m_condenser_idx)
+		if (m_component_state.operational[i])
 		{
 			return true;
 		}
@@ -1351,8 +1637,9 @@ bool PowerCycle::FWHOnline()
 	otherwise.  Used to determine cycle Capacity (which is zero if this
 	is false, as the plant can't operate with no feedwater heaters.)
 	*/
-	for (size_t i = 0; i<m_components.size(); i++)
-		if (m_components.at(i).GetType() == "Feedwater heater" && m_components.at(i).IsOperational())
+	const ComponentStateArrays &cs = m_component_state;
+	for (size_t i = 0; i < cs.Size(); i++)
+		if (cs.type[i] == COMPONENT_FEEDWATER_HEATER && cs.operational[i])
 		{
 			return true;
 		}
@@ -1383,11 +1670,10 @@ bool PowerCycle::NewRepairOccurred()
 	/*
 	returns true if a new repair occurred in the current period of dispatch.
 	*/
-	for (size_t i = 0; i < m_components.size(); i++)
+	for (size_t i = 0; i < m_component_state.Size(); i++)
 	{
-		if (m_components.at(i).IsNewRepair())
+		if (m_component_state.new_repair[i])
 		{
-			//std::cerr << m_components.at(i).GetName() << " repair detected." << m_components.at(i).IsNewRepair() << "\n";
 			return true;
 		}
 	}
@@ -1399,11 +1685,10 @@ bool PowerCycle::NewFailureOccurred()
 	/*
 	returns true if a new failure occurred in the current period of dispatch.
 	*/
-	for (size_t i = 0; i < m_components.size(); i++)
+	for (size_t i = 0; i < m_component_state.Size(); i++)
 	{
-		if (m_components.at(i).IsNewFailure())
+		if (m_component_state.new_failure[i])
 		{
-			//std::cerr << m_components.at(i).GetName() << " failure detected." << m_components.at(i).IsNewFailure() << "\n";
 			return true;
 		}
 	}
@@ -1413,10 +1698,8 @@ bool PowerCycle::NewFailureOccurred()
 void PowerCycle::ResetCycleEventFlags()
 {
 	/* resets new failure and new repair flags for components. */
-	for (size_t i = 0; i < m_components.size(); i++)
-	{
-		m_components.at(i).ResetFailureAndRepairFlags();
-	}
+	std::fill(m_component_state.new_failure.begin(), m_component_state.new_failure.end(), 0);
+	std::fill(m_component_state.new_repair.begin(), m_component_state.new_repair.end(), 0);
 }
 
 double PowerCycle::GetTimeInStandby()
@@ -1456,14 +1739,24 @@ double PowerCycle::GetSteplength()
 
 std::unordered_map< std::string, failure_event > PowerCycle::GetFailureEvents()
 {
-	/* accessor to dictionary of failure events. */
-	return m_failure_events;
+	/* 
+	accessor to dictionary of failure events, keyed by their labels; the 
+	labels are generated on each call. 
+	*/
+	std::unordered_map< std::string, failure_event > events;
+	for (size_t i = 0; i < m_failure_events.Size(); i++)
+		events[m_failure_events.GetLabel(i)] = m_failure_events.At(i);
+	return events;
 }
 
 std::vector<std::string> PowerCycle::GetFailureEventLabels()
 {
-	/* accessor to linked list of failure event dictionary keys. */
-	return m_failure_event_labels;
+	/* accessor to the failure event labels, in order of occurrence. */
+	std::vector<std::string> labels;
+	labels.reserve(m_failure_events.Size());
+	for (size_t i = 0; i < m_failure_events.Size(); i++)
+		labels.push_back(m_failure_events.GetLabel(i));
+	return labels;
 }
 
 double PowerCycle::GetHotStartPenalty()
@@ -1588,20 +1881,31 @@ void PowerCycle::AddComponent(
 	*/
 	m_components.push_back(Component(name, type,
 		repair_rate, repair_cooldown_time, &m_failure_events,
-		capacity_reduction, efficiency_reduction, repair_cost, repair_mode,
-		&m_failure_event_labels));
-	if (type == "Turbine")
+		capacity_reduction, efficiency_reduction, repair_cost, repair_mode));
+	RegisterComponent();
+	switch (m_components.back().GetTypeCode())
+	{
+	case COMPONENT_TURBINE:
 		m_turbine_idx.push_back(m_components.size() - 1);
-	else if (type == "Condenser train")
+		break;
+	case COMPONENT_CONDENSER_TRAIN:
 		m_condenser_idx.push_back(m_components.size() - 1);
-	else if (type == "Salt-to-steam train")
+		break;
+	case COMPONENT_SALT_STEAM_TRAIN:
 		m_sst_idx.push_back(m_components.size() - 1);
-	else if (type == "Molten salt pump")
+		break;
+	case COMPONENT_SALT_PUMP:
 		m_salt_pump_idx.push_back(m_components.size() - 1);
-	else if (type == "Water pump")
+		break;
+	case COMPONENT_WATER_PUMP:
 		m_water_pump_idx.push_back(m_components.size() - 1);
-	else if (type == "Boiler pump")
+		break;
+	case COMPONENT_BOILER_PUMP:
 		m_boiler_pump_idx.push_back(m_components.size() - 1);
+		break;
+	default:
+		break;
+	}
 }
 
 void PowerCycle::AddFailureType(std::string component, std::string id, std::string failure_mode,
@@ -1654,6 +1958,7 @@ void PowerCycle::CreateComponentsFromFile(std::string component_data)
         //                                  name	  component_type  dist_type failure_alpha failure_beta repair_rate repair_cooldown_time hot_start_penalty warm_start_penalty cold_start_penalty
         m_components.push_back( Component( entry.at(0), entry.at(1), //entry.at(2), dat.at(0),   dat.at(1),  
 			dat.at(2),  dat.at(3),          &m_failure_events ) );
+		RegisterComponent();
         
     }
     
@@ -1984,8 +2289,8 @@ int PowerCycle::NumberOfAirstreamsOnline()
 	returns the number of condenser airstreams that are online.
 	*/
 	int num_streams = 0;
-	for (size_t i = 0; i<m_components.size(); i++)
-		if (m_components.at(i).GetType() == "Condenser train" && m_components.at(i).IsOperational())
+	for (size_t i : m_condenser_idx)
+		if (m_component_state.operational[i])
 		{
 			num_streams++;
 		}
@@ -1997,24 +2302,12 @@ double PowerCycle::GetCondenserEfficiency(double)
 	return 1.0;
 }
 
-double PowerCycle::GetCondenserCapacity(double temp)
+double PowerCycle::CondenserCapacity(int num_streams, double temp)
 {
 	/*
-	Returns the condener efficiency according to any fans and trains are down,
-	as well as the ambient temperature.
-
-	temp -- ambient temperature (Celsius)
-	retval -- efficiency of power cycle condenser (fraction)
+	Returns the condenser capacity given the number of airstreams online
+	and the ambient temperature.
 	*/
-	int num_streams = 0;
-	for (size_t i : m_condenser_idx)
-	{
-		//std::cerr << i << " " << GetComponents().at(i).GetType() << "\n";
-		if (m_components.at(i).IsOperational())
-		{
-			num_streams++;
-		}
-	}
 	if (num_streams == 0)
 		return 0.0;
 	if (temp < m_condenser_temp_threshold)
@@ -2022,6 +2315,18 @@ double PowerCycle::GetCondenserCapacity(double temp)
 	return double(num_streams) / double(m_num_condenser_trains);
 }
 
+double PowerCycle::GetCondenserCapacity(double temp)
+{
+	/*
+	Returns the condener efficiency according to any fans and trains are down,
+	as well as the ambient temperature.
+
+	temp -- ambient temperature (Celsius)
+	retval -- efficiency of power cycle condenser (fraction)
+	*/
+	return CondenserCapacity(NumberOfAirstreamsOnline(), temp);
+}
+
 double PowerCycle::GetTurbineEfficiency(bool age, bool include_failures)
 {
 	/*
@@ -2032,16 +2337,17 @@ double PowerCycle::GetTurbineEfficiency(bool age, bool include_failures)
 	age -- true if aging model is included, false o.w.
 	include_failures -- include failed turbines in calculation, false o.w.
 	*/
+	const ComponentStateArrays &cs = m_component_state;
 	double eff = 0.0;
 	double total_cap = 0.0;
 	if (age)
 	{
 		for (size_t i : m_turbine_idx)
 		{
-			if (m_components.at(i).IsOperational() || include_failures)
+			if (cs.operational[i] || include_failures)
 			{
-				eff += m_components.at(i).GetEfficiency(include_failures) * m_components.at(i).GetCapacityReduction();
-				total_cap += m_components.at(i).GetCapacityReduction();
+				eff += cs.AgeEfficiency((int)i) * cs.capacity_reduction[i];
+				total_cap += cs.capacity_reduction[i];
 			}
 		}
 		return eff / total_cap;
@@ -2052,9 +2358,9 @@ double PowerCycle::GetTurbineEfficiency(bool age, bool include_failures)
 		total_cap = 1.0;
 		for (size_t i : m_turbine_idx)
 		{
-			if (!m_components.at(i).IsOperational() && !include_failures)
+			if (!cs.operational[i] && !include_failures)
 			{
-				eff -= 1 * m_components.at(i).GetEfficiencyReduction();
+				eff -= 1 * cs.efficiency_reduction[i];
 			}
 		}
 	}
@@ -2069,17 +2375,18 @@ double PowerCycle::GetTurbineCapacity(bool age, bool include_failures)
 	age -- true if aging model is included, false o.w.
 	include_failures -- include failed turbines in calculation, false o.w.
 	*/
+	const ComponentStateArrays &cs = m_component_state;
 	double cap = 0.0;
 	for (size_t i : m_turbine_idx)
 	{
-		if (include_failures || m_components.at(i).IsOperational())
+		if (include_failures || cs.operational[i])
 		{
 			//The first component is an age-weighted index, while the second is baseline 
 			//relative capacity vs. that of all turbines in the system.
 			if (age)
-				cap += m_components.at(i).GetCapacity(include_failures) * m_components.at(i).GetCapacityReduction();
+				cap += cs.AgeCapacity((int)i) * cs.capacity_reduction[i];
 			else
-				cap += m_components.at(i).GetCapacityReduction();
+				cap += cs.capacity_reduction[i];
 		}
 	}
 	return cap;
@@ -2094,85 +2401,69 @@ double PowerCycle::GetSaltSteamTrainCapacity()
 	double cap = 0.0;
 	for (size_t i : m_sst_idx)
 	{
-		if (m_components.at(i).IsOperational())
+		if (m_component_state.operational[i])
 		{
-			cap += m_components.at(i).GetCapacityReduction();
+			cap += m_component_state.capacity_reduction[i];
 		}
 	}
 	return cap;
 }
 
-double PowerCycle::GetSaltPumpCapacity()
+double PowerCycle::PumpCapacity(double num_pumps_operational, double switch_time, 
+	int num_pumps_required)
 {
 	/*
-	Returns the relative capacity of all salt pumps that
-	are operational.  If switching is currently taking place, 
+	Returns the relative capacity of a pump type given the number of pumps
+	that are operational.  If switching is currently taking place, 
 	remove one operational pump.
 	*/
-	double num_pumps_operational = 0.;
-	for (size_t i : m_salt_pump_idx)
-	{
-		if (m_components.at(i).IsOperational())
-		{
-			num_pumps_operational += 1;
-		}
-	}
-	if (m_current_cycle_state.salt_pump_switch_time > DBL_EPSILON)
+	if (switch_time > DBL_EPSILON)
 	{
 		return std::max(
 			0.0,
 			std::min(
-				1.0, (num_pumps_operational - 1) / (double)m_num_salt_pumps_required
+				1.0, (num_pumps_operational - 1) / (double)num_pumps_required
 			)
 		);
 	}
-	return std::min(1.0, num_pumps_operational / (double)m_num_salt_pumps_required);
+	return std::min(1.0, num_pumps_operational / (double)num_pumps_required);
 }
 
-double PowerCycle::GetWaterPumpCapacity()
+double PowerCycle::CountOperational(const std::vector<size_t> &idx)
 {
-	double num_pumps_operational = 0.;
-	for (size_t i : m_water_pump_idx)
+	/* returns the number of operational components among those indexed. */
+	double n = 0.;
+	for (size_t i : idx)
 	{
-		if (m_components.at(i).IsOperational())
+		if (m_component_state.operational[i])
 		{
-			num_pumps_operational += 1;
+			n += 1;
 		}
 	}
-	if (m_current_cycle_state.water_pump_switch_time > DBL_EPSILON)
-	{
-		return std::max(
-			0.0,
-			std::min(
-				1.0, (num_pumps_operational - 1) / (double)m_num_water_pumps_required
-			)
-		);
-	}
-	return std::min(1.0, num_pumps_operational / (double)m_num_water_pumps_required);
+	return n;
 }
 
-double PowerCycle::GetBoilerPumpCapacity()
+double PowerCycle::GetSaltPumpCapacity()
 {
-	double num_pumps_operational = 0.;
-	for (size_t i : m_boiler_pump_idx)
-	{
-		if (m_components.at(i).IsOperational())
-		{
-			num_pumps_operational += 1;
-		}
-	}
+	/*
+	Returns the relative capacity of all salt pumps that
+	are operational.  If switching is currently taking place, 
+	remove one operational pump.
+	*/
+	return PumpCapacity(CountOperational(m_salt_pump_idx), 
+		m_current_cycle_state.salt_pump_switch_time, m_num_salt_pumps_required);
+}
 
-	if (m_current_cycle_state.boiler_pump_switch_time > DBL_EPSILON)
-	{
-		return std::max(
-			0.0,
-			std::min(
-				1.0, (num_pumps_operational - 1) / (double)m_num_boiler_pumps_required
-			)
-		);
-	}
+double PowerCycle::GetWaterPumpCapacity()
+{
+	return PumpCapacity(CountOperational(m_water_pump_idx), 
+		m_current_cycle_state.water_pump_switch_time, m_num_water_pumps_required);
+}
 
-	return std::min(1.0, num_pumps_operational / (double)m_num_boiler_pumps_required);
+double PowerCycle::GetBoilerPumpCapacity()
+{
+	return PumpCapacity(CountOperational(m_boiler_pump_idx), 
+		m_current_cycle_state.boiler_pump_switch_time, m_num_boiler_pumps_required);
 }
 
 double PowerCycle::GetSaltPumpEfficiency()
@@ -2217,38 +2508,88 @@ void PowerCycle::SetCycleCapacityAndEfficiency(double temp, bool age)
 	Assumes that when multiple other components are
 	down, the effect on cycle capacity is additive. 
 
+	All quantities are collected in a single pass over the component state 
+	arrays; the totals match those of the individual Get...() methods.
+
 	temp -- ambient temperature (affects condenser efficiency)
 	*/
+	const ComponentStateArrays &cs = m_component_state;
+	int num_streams = 0, num_fwh = 0;
+	double turbine_eff = age ? 0.0 : 1.0, turbine_total_cap = 0.0, turbine_cap = 0.0;
+	double sst_cap = 0.0;
+	double num_salt_pumps = 0., num_water_pumps = 0., num_boiler_pumps = 0.;
+	double rem_eff = 1.0;
+	double rem_cap = 1.0;
+	for (size_t i = 0; i < cs.Size(); i++)
+	{
+		bool ok = cs.operational[i] != 0;
+		switch (cs.type[i])
+		{
+		case COMPONENT_CONDENSER_TRAIN:
+			num_streams += ok;
+			break;
+		case COMPONENT_FEEDWATER_HEATER:
+			num_fwh += ok;
+			break;
+		case COMPONENT_TURBINE:
+			if (ok)
+			{
+				if (age)
+				{
+					turbine_eff += cs.AgeEfficiency((int)i) * cs.capacity_reduction[i];
+					turbine_total_cap += cs.capacity_reduction[i];
+					turbine_cap += cs.AgeCapacity((int)i) * cs.capacity_reduction[i];
+				}
+				else
+					turbine_cap += cs.capacity_reduction[i];
+			}
+			else if (!age)
+				turbine_eff -= 1 * cs.efficiency_reduction[i];
+			break;
+		case COMPONENT_SALT_STEAM_TRAIN:
+			if (ok)
+				sst_cap += cs.capacity_reduction[i];
+			break;
+		case COMPONENT_SALT_PUMP:
+			num_salt_pumps += ok ? 1 : 0;
+			break;
+		case COMPONENT_WATER_PUMP:
+			num_water_pumps += ok ? 1 : 0;
+			break;
+		case COMPONENT_BOILER_PUMP:
+			num_boiler_pumps += ok ? 1 : 0;
+			break;
+		default:
+			break;
+		}
+		if (!ok)
+		{
+			rem_eff -= cs.efficiency_reduction[i];
+			rem_cap -= cs.capacity_reduction[i];
+		}
+	}
 	//if no condensers are online or no feedwater heaters are online,
 	//assume the plant is shut down.
-	if (!AirstreamOnline() || !FWHOnline())
+	if (num_streams == 0 || num_fwh == 0)
 	{
 		m_cycle_capacity = 0.;
 		m_cycle_efficiency = 0.;
 		//std::cerr << "OFF";
 		return;
 	}
+	if (age)
+		turbine_eff = turbine_eff / turbine_total_cap;
 	double condenser_eff = GetCondenserEfficiency(temp);
-	double condenser_cap = GetCondenserCapacity(temp);
-	double turbine_eff = GetTurbineEfficiency(age, false);
-	double turbine_cap = GetTurbineCapacity(age, false);
-	double sst_cap = GetSaltSteamTrainCapacity();
-	double salt_pump_cap = GetSaltPumpCapacity();
+	double condenser_cap = CondenserCapacity(num_streams, temp);
+	double salt_pump_cap = PumpCapacity(num_salt_pumps, 
+		m_current_cycle_state.salt_pump_switch_time, m_num_salt_pumps_required);
 	double salt_pump_eff = GetSaltPumpEfficiency();
-	double water_pump_cap = GetWaterPumpCapacity();
+	double water_pump_cap = PumpCapacity(num_water_pumps, 
+		m_current_cycle_state.water_pump_switch_time, m_num_water_pumps_required);
 	double water_pump_eff = GetWaterPumpEfficiency();
-	double boiler_pump_cap = GetBoilerPumpCapacity();
+	double boiler_pump_cap = PumpCapacity(num_boiler_pumps, 
+		m_current_cycle_state.boiler_pump_switch_time, m_num_boiler_pumps_required);
 	double boiler_pump_eff = GetBoilerPumpEfficiency();
-	double rem_eff = 1.0;
-	double rem_cap = 1.0;
-	for (size_t i = 0; i < m_components.size(); i++)
-	{
-		if (!m_components.at(i).IsOperational())
-		{
-			rem_eff -= m_components.at(i).GetEfficiencyReduction();
-			rem_cap -= m_components.at(i).GetCapacityReduction();
-		}
-	}
 	//efficiency and capacity reductions assumed equal for all components but
 	//turbines and salt-to-steam trains
 	m_cycle_capacity = std::max(0., 
@@ -2282,26 +2623,36 @@ double PowerCycle::GetCycleEfficiency()
 }
 
 void PowerCycle::TestForComponentFailures(double ramp_mult, int t, std::string start, std::string mode)
+{
+	/* string-based adapter; see TestForComponentFailures(double, int, start_mode, operating_mode). */
+	TestForComponentFailures(ramp_mult, t, StartModeFromString(start), 
+		OperatingModeFromString(mode));
+}
+
+void PowerCycle::TestForComponentFailures(double ramp_mult, int t, start_mode start, operating_mode mode)
 {
 	/*
 	Determines whether a component is to fail, based on current dispatch.
 	ramp_mult - ramping penalty used to accelerate component wear
 	t -- time period index
 	start -- indicates plant start (Hot, Warm, Cold, or None)
-	mode -- string indicating operating mode (e.g., Offline, Standby)
+	mode -- operating mode (e.g., Offline, Standby)
 	*/
 	double hazard_increase = 0.;
 	double hazard_multiplier = 100.; // multiplier due to NREL Cycling Cost EFOR being too low
-	if (start == "HotStart")
+	if (start == START_HOT)
 		hazard_increase = m_current_cycle_state.hot_start_penalty*hazard_multiplier;
-	else if (start == "WarmStart")
+	else if (start == START_WARM)
 		hazard_increase = m_current_cycle_state.warm_start_penalty*hazard_multiplier;
-	else if (start == "ColdStart")
+	else if (start == START_COLD)
 		hazard_increase = m_current_cycle_state.cold_start_penalty*hazard_multiplier;
+	const ComponentStateArrays &cs = m_component_state;
 	for (size_t i = 0; i < m_components.size(); i++)
 	{ 
-		if (m_components.at(i).IsOperational())
+		if (cs.operational[i])
 		{
+			if (m_sim_params.instrument)
+				m_results.instrumentation.failures_tested += cs.life_offset[i + 1] - cs.life_offset[i];
 			m_components.at(i).TestForFailure(
 				m_sim_params.steplength, ramp_mult, *m_life_gen,
 				*m_repair_gen, *m_binary_gen, t,
@@ -2309,12 +2660,7 @@ void PowerCycle::TestForComponentFailures(double ramp_mult, int t, std::string s
 			);
 			//if a failure occurred, and the component is a pump, 
 			//create a pump switching event as well.
-			if ( (!m_components.at(i).IsOperational()) && (
-				m_components.at(i).GetType() == "Molten salt pump" ||
-				m_components.at(i).GetType() == "Boiler pump" ||
-				m_components.at(i).GetType() == "Water pump" 
-				)
-			)
+			if (!cs.operational[i] && IsPumpType(cs.type[i]))
 			{
 				AddPumpSwitchingEvent(
 					t,
@@ -2336,12 +2682,11 @@ bool PowerCycle::AllComponentsOperational()
     a failure that has not yet been repaired, and False otherwise.
 	*/
 
-    bool ok = true;
-
-    for( size_t i=0; i<m_components.size(); i++)
-        ok = ok && m_components.at(i).IsOperational();
+    for( size_t i=0; i<m_component_state.Size(); i++)
+        if (!m_component_state.operational[i])
+			return false;
 
-    return ok;
+    return true;
     
 }
 
@@ -2352,9 +2697,9 @@ double PowerCycle::GetMaxComponentDowntime()
 	*/
 	double t = 0;
 
-	for (size_t i = 0; i < m_components.size(); i++)
+	for (size_t i = 0; i < m_component_state.Size(); i++)
 	{
-		t = std::max(t, m_components.at(i).GetDowntimeRemaining());
+		t = std::max(t, m_component_state.downtime_remaining[i]);
 	}
 
 	return t;
@@ -2395,17 +2740,22 @@ void PowerCycle::PlantMaintenanceShutdown(int t, bool reset_time, bool record,
 
 	if (record)
 	{
-		m_failure_events[
-			"S" + std::to_string(m_current_scenario) + "T" + std::to_string(t) + label
-		] = failure_event(t, label, -1, duration, 0., 0., m_current_scenario);
-		m_failure_event_labels.push_back(
-			"S" + std::to_string(m_current_scenario) + "T" + std::to_string(t) + label
+		m_failure_events.Add(
+			FailureEventStore::MaintenanceKey(m_current_scenario, t, label == "MAINTENANCE"),
+			failure_event(t, label, -1, duration, 0., 0., m_current_scenario)
 		);
 	}
 
 	if (reset_time)
 	    m_current_cycle_state.hours_to_maintenance = m_current_cycle_state.maintenance_interval * 1.0;
 
+	if (m_sim_params.instrument)
+	{
+		if (reset_time)
+			m_results.instrumentation.maintenance_shutdowns++;
+		else
+			m_results.instrumentation.unplanned_shutdowns++;
+	}
 }
 
 void PowerCycle::AddPumpSwitchingEvent(
@@ -2463,28 +2813,33 @@ void PowerCycle::AddPumpSwitchingEvent(
 	
 	if (record)
 	{
-		std::string label = component + "-SWITCH";
-		m_failure_events[
-			"S" + std::to_string(m_current_scenario) + "T" + std::to_string(t) + label
-		] = failure_event(t, label, -1, duration, 0., 0., m_current_scenario);
-			m_failure_event_labels.push_back(
-				"S" + std::to_string(m_current_scenario) + "T" + std::to_string(t) + label
-			);
+		if (m_sim_params.instrument)
+			m_results.instrumentation.pump_switches++;
+		m_failure_events.Add(
+			FailureEventStore::SwitchKey(m_current_scenario, t, GetComponentIndex(component)),
+			failure_event(t, component + "-SWITCH", -1, duration, 0., 0., m_current_scenario)
+		);
 	}
 }
 
 void PowerCycle::AdvanceDowntime(std::string mode)
+{
+	/* string-based adapter; see AdvanceDowntime(operating_mode). */
+	AdvanceDowntime(OperatingModeFromString(mode));
+}
+
+void PowerCycle::AdvanceDowntime(operating_mode mode)
 {
 
     /*
 	When the plant is not operational, advances time by a period.  This
     updates the repair time and/or maintenance time remaining in the plant.
-	mode -- string indicating operating mode (e.g., Offline, Standby)
+	mode -- operating mode (e.g., Offline, Standby)
 	*/
-	for (size_t i = 0; i < m_components.size(); i++)
+	for (size_t i = 0; i < m_component_state.Size(); i++)
 	{
-		if (!m_components.at(i).IsOperational())
-			m_components.at(i).AdvanceDowntime(m_sim_params.steplength, mode);
+		if (!m_component_state.operational[i])
+			m_component_state.AdvanceDowntime((int)i, m_sim_params.steplength, mode);
 	}
 }
 
@@ -2515,6 +2870,13 @@ double PowerCycle::GetRampMult(double thermal_out)
 }
 
 void PowerCycle::OperateComponents(double ramp_mult, int t, std::string start, std::string mode, double duration)
+{
+	/* string-based adapter; see OperateComponents(double, int, start_mode, operating_mode, double). */
+	OperateComponents(ramp_mult, t, StartModeFromString(start), 
+		OperatingModeFromString(mode), duration);
+}
+
+void PowerCycle::OperateComponents(double ramp_mult, int t, start_mode start, operating_mode mode, double duration)
 {
 
     /*
@@ -2524,29 +2886,29 @@ void PowerCycle::OperateComponents(double ramp_mult, int t, std::string start, s
     
     ramp_mult -- ramping penalty (multiplier for life degradation)
     t -- period index (indicator of whether read-only or not)
-    mode -- string indicating operating mode (e.g., Offline, Standby)
+    mode -- operating mode (e.g., Offline, Standby)
     
 	*/
     //print t - m_sim_params.read_periods
 	double hazard_increase = 0.;
-	if (start == "HotStart")
+	if (start == START_HOT)
 		hazard_increase = m_current_cycle_state.hot_start_penalty;
-	else if (start == "WarmStart")
+	else if (start == START_WARM)
 		hazard_increase = m_current_cycle_state.warm_start_penalty;
-	else if (start == "ColdStart")
+	else if (start == START_COLD)
 		hazard_increase = m_current_cycle_state.cold_start_penalty;
     //bool read_only = (t < m_sim_params.read_periods);
-	for (size_t i = 0; i < m_components.size(); i++) 
+	bool read_only = t > m_results.period_of_last_repair[m_current_scenario];
+	for (size_t i = 0; i < m_component_state.Size(); i++) 
 	{
-		if (m_components.at(i).IsOperational())
-			m_components.at(i).Operate(
-				duration, ramp_mult,
-				t > m_results.period_of_last_repair[m_current_scenario], 
+		if (m_component_state.operational[i])
+			m_component_state.Operate(
+				(int)i, duration, ramp_mult, read_only, 
 				hazard_increase, mode
 			);
 		else
 		{
-			m_components.at(i).AdvanceDowntime(duration, mode);
+			m_component_state.AdvanceDowntime((int)i, duration, mode);
 		}
 	}
 }
@@ -2557,8 +2919,7 @@ void PowerCycle::ResetHazardRates()
 	resets the plant (restores component hazard rates
 	to "as-good-as-new")
 	*/
-	for (size_t i = 0; i < m_components.size(); i++)
-		m_components.at(i).ResetHazardRate();
+	std::fill(m_component_state.hazard_rate.begin(), m_component_state.hazard_rate.end(), 1.);
 }
 
 std::unordered_map<std::string, ComponentStatus> PowerCycle::GetComponentStates()
@@ -2582,27 +2943,45 @@ std::unordered_map<std::string, ComponentStatus> PowerCycle::GetComponentStates(
 std::string PowerCycle::GetStartMode(int t)
 {
 	/* 
-	returns the start mode as a string, or "none" if there is no start.
+	returns the start mode as a string, or "None" if there is no start.
+	t -- time period index
+	*/
+	return StartModeToString(GetStartModeEnum(t));
+}
+
+std::string PowerCycle::GetOperatingMode(int t)
+{
+	/*
+	Returns the operating mode as a string.
+	t -- time period index
+	*/
+	return OperatingModeToString(GetOperatingModeEnum(t));
+}
+
+start_mode PowerCycle::GetStartModeEnum(int t)
+{
+	/* 
+	returns the start mode, or START_NONE if there is no start.
 	t -- time period index
 	*/
 	double power_out = m_dispatch.at("cycle_power").at(t);
 	if (power_out > DBL_EPSILON)
 	{
 		if (IsOnline())
-			return "None";
+			return START_NONE;
 		if (IsOnStandby())
-			return "HotStart";
+			return START_HOT;
 		else if (m_current_cycle_state.downtime <= m_current_cycle_state.downtime_threshold)
-			return "WarmStart";
-		return "ColdStart";
+			return START_WARM;
+		return START_COLD;
 	}
-	return "None";
+	return START_NONE;
 }
 
-std::string PowerCycle::GetOperatingMode(int t)
+operating_mode PowerCycle::GetOperatingModeEnum(int t)
 {
 	/*
-	Returns the operating mode as a string.
+	Returns the operating mode.
 	t -- time period index
 	*/
 	double power_out = m_dispatch.at("cycle_power").at(t);
@@ -2611,75 +2990,66 @@ std::string PowerCycle::GetOperatingMode(int t)
 	{
 		if (IsOnline())
 			if (m_current_cycle_state.time_online <= 1.0 - DBL_EPSILON)
-				return "OF"; //in the first hour of power cycle operation
+				return MODE_OF; //in the first hour of power cycle operation
 			else
-				return "OO"; //ongoing (>1 hour) power cycle operation
-		return "OS";  //starting power cycle operation
+				return MODE_OO; //ongoing (>1 hour) power cycle operation
+		return MODE_OS;  //starting power cycle operation
 	}
 	else if (standby >= 0.5)
 	{
 		if (IsOnStandby())
 			if (m_current_cycle_state.time_in_standby <= 1.0 - DBL_EPSILON)
-				return "SF"; //in first hour of standby
+				return MODE_SF; //in first hour of standby
 			else
-				return "SO"; // ongoing standby (>1 hour)
-		return "SS";  // if not currently on standby, then starting standby
+				return MODE_SO; // ongoing standby (>1 hour)
+		return MODE_SS;  // if not currently on standby, then starting standby
 	}
-	return "OFF";
+	return MODE_OFF;
 }
 
 void PowerCycle::ReadInComponentFailures(int t)
 {
 	/*
-	Reads in component failures from failure_events dictionary object.
+	Reads in component failures from the failure event store.
 	t -- time period index
 	*/
+	if (!m_failure_events.HasEventsInPeriod(m_current_scenario, t))
+		return;
 	for (size_t j = 0; j < m_components.size(); j++)
 	{
-		for (size_t k = 0; k < m_components.at(j).GetFailureTypes().size(); k++)
+		size_t nk = m_component_state.life_offset[j + 1] - m_component_state.life_offset[j];
+		for (size_t k = 0; k < nk; k++)
 		{
-			if (m_failure_events.find(
-				"S" + std::to_string(m_current_scenario) + "T" + 
-				std::to_string(t) + m_components.at(j).GetName() + 
-				"F" + std::to_string(k)) != m_failure_events.end()
-				)
+			const failure_event *e = m_failure_events.Find(
+				FailureEventStore::FailureKey(m_current_scenario, t, (int)j, (int)k)
+			);
+			if (e != NULL)
 			{
-				std::string label = (
-					"S" + std::to_string(m_current_scenario) + 
-					"T" + std::to_string(t) + m_components.at(j).GetName() + 
-					"F" + std::to_string(k)
-					);
 				m_components.at(j).ReadFailure(
-					m_failure_events[label].duration,
-					m_failure_events[label].new_life,
-					m_failure_events[label].fail_idx
+					e->duration,
+					e->new_life,
+					e->fail_idx
 				);
 
 				if (m_sim_params.print_output)
 					output_log.push_back(util::format(
 						"Failure Read: %d, %d, %s",
 						t, m_sim_params.read_periods, 
-						m_failure_events[label].print().c_str())
+						e->print().c_str())
 					);
 
 				//if the component is a pump, read in the switching event too
-				if (
-					m_components.at(j).GetType() == "Molten salt pump" ||
-					m_components.at(j).GetType() == "Boiler pump" ||
-					m_components.at(j).GetType() == "Water pump"
-					)
+				if (IsPumpType(m_component_state.type[j]))
 				{
-					label = (
-						"S" + std::to_string(m_current_scenario) +
-						"T" + std::to_string(t) + m_components.at(j).GetName() +
-						"-SWITCH"
-						);
+					const failure_event *sw = m_failure_events.Find(
+						FailureEventStore::SwitchKey(m_current_scenario, t, (int)j)
+					);
 					AddPumpSwitchingEvent(
 						t,
 						m_components.at(j).GetName(),
 						m_components.at(j).GetType(),
 						false,
-						m_failure_events[label].duration
+						sw != NULL ? sw->duration : 0.
 					);
 				}
 			}
@@ -2690,29 +3060,47 @@ void PowerCycle::ReadInComponentFailures(int t)
 void PowerCycle::ReadInMaintenanceEvents(int t)
 {
 	/* 
-	Reads in planned maintenance events from failure_events dictionary object.
+	Reads in planned maintenance events from the failure event store.
 	t -- time period index
 	*/
+	if (!m_failure_events.HasEventsInPeriod(m_current_scenario, t))
+		return;
 	if (
-		m_failure_events.find("S" + std::to_string(m_current_scenario) + "T" + std::to_string(t) + "MAINTENANCE")
-		!= m_failure_events.end()
+		m_failure_events.Find(FailureEventStore::MaintenanceKey(m_current_scenario, t, true))
+		!= NULL
 		)
 	{
 		PlantMaintenanceShutdown(t, true, false);
 	}
 	//Read in unplanned maintenance events, if any
-	if (
-		m_failure_events.find("S" + std::to_string(m_current_scenario) + "T" + std::to_string(t) + "UNPLANNEDMAINTENANCE")
-		!= m_failure_events.end()
-		)
+	const failure_event *e = m_failure_events.Find(
+		FailureEventStore::MaintenanceKey(m_current_scenario, t, false)
+	);
+	if (e != NULL)
 	{
-		PlantMaintenanceShutdown(
-			t, false, false,
-			m_failure_events["S" + std::to_string(m_current_scenario) + "T" + std::to_string(t) + "UNPLANNEDMAINTENANCE"].duration
-		);
+		PlantMaintenanceShutdown(t, false, false, e->duration);
 	}
 }
 
+static double PreviousResult(
+	const std::unordered_map< int, std::vector< double > > &results, 
+	int s, 
+	int t
+)
+{
+	/*
+	s -- scenario index
+	t -- time period index
+	retval -- value in period t of the series stored for scenario s, or 1 
+		(full capacity or efficiency, as after initialization) if the 
+		scenario's series are not retained
+	*/
+	std::unordered_map< int, std::vector< double > >::const_iterator it = results.find(s);
+	if (it == results.end())
+		return 1.;
+	return it->second.at(t);
+}
+
 int PowerCycle::FirstPeriodOfDifference(
 	std::vector<double> cycle_efficiencies,
 	std::vector<double> cycle_capacities
@@ -2721,8 +3109,8 @@ int PowerCycle::FirstPeriodOfDifference(
 	for (int i = 0; i < m_sim_params.sim_length; i++)
 	{
 		if (
-			std::abs(cycle_efficiencies.at(i) - m_results.cycle_efficiency[m_current_scenario].at(i)) > DBL_EPSILON ||
-			std::abs(cycle_capacities.at(i) - m_results.cycle_capacity[m_current_scenario].at(i)) > DBL_EPSILON
+			std::abs(cycle_efficiencies.at(i) - PreviousResult(m_results.cycle_efficiency, m_current_scenario, i)) > DBL_EPSILON ||
+			std::abs(cycle_capacities.at(i) - PreviousResult(m_results.cycle_capacity, m_current_scenario, i)) > DBL_EPSILON
 			)
 		{
 			return i;
@@ -2731,15 +3119,22 @@ int PowerCycle::FirstPeriodOfDifference(
 	return -1;
 }
 
-void PowerCycle::RunDispatch()
+void PowerCycle::RunDispatch(bool resume)
 {
     /*
 	runs dispatch for entire time horizon.
     failure_file -- file to output failures
+	resume -- true if the run may resume from a checkpoint taken in an 
+		earlier run of the scenario; only valid if the run starts from the 
+		state the last run of the scenario reverted to.
     retval -- array of binary variables that are equal to 1 if the plant 
         is able to operate (i.e., no maintenance or repair events in 
         progress), and 0 otherwise.  This includes the read-in period.
-    
+
+	Every m_sim_params.checkpoint_interval periods of the read-in stage, 
+	until the run generates its first event, a checkpoint is kept in the 
+	results, so that later runs replaying the same read-in stage can skip 
+	the periods before it.
 	*/
 	m_new_failure_occurred = false;
 	m_new_repair_occurred = false;
@@ -2747,14 +3142,60 @@ void PowerCycle::RunDispatch()
 	std::vector< double > cycle_efficiencies( m_sim_params.sim_length, 0 );
 	double power_output = 0.;
 	double thermal_output = 0.;
-	for( int t = 0; t < m_sim_params.sim_length; t++)
+	int interval = m_sim_params.checkpoint_interval;
+	int start_failure = m_results.period_of_last_failure[m_current_scenario];
+	int start_repair = m_results.period_of_last_repair[m_current_scenario];
+	size_t start_events = m_failure_events.Size();
+	cycle_instrumentation &inst = m_results.instrumentation;
+	bool instrument = m_sim_params.instrument;
+	PhaseTimer dispatch_timer(PhaseTime(inst.dispatch_time));
+	int t_begin = 0;
+	if (resume && interval > 0 && !m_sim_params.print_output)
+	{
+		PhaseTimer resume_timer(PhaseTime(inst.read_in_time));
+		t_begin = ResumeFromRunCheckpoint(cycle_capacities, cycle_efficiencies);
+		if (instrument && t_begin > 0)
+		{
+			inst.checkpoint_restores++;
+			inst.periods_read_in += t_begin;
+		}
+	}
+	else
+		m_results.run_checkpoints[m_current_scenario].clear();
+	for( int t = t_begin; t < m_sim_params.sim_length; t++)
     {
+		//Keep a checkpoint if no period so far has drawn random numbers 
+		//(i.e., all were read-only) or recorded an event.
+		if (interval > 0 && t > t_begin && t % interval == 0 &&
+			t - 1 <= std::max(start_failure, start_repair) &&
+			!m_new_failure_occurred && !m_new_repair_occurred &&
+			m_failure_events.Size() == start_events)
+		{
+			RecordRunCheckpoint(t, start_failure, start_repair);
+		}
+		if (m_sim_params.skip_steady_periods)
+		{
+			PhaseTimer steady_timer(PhaseTime(inst.steady_time));
+			int tn = RunSteadyPeriods(t, cycle_capacities, cycle_efficiencies);
+			if (instrument)
+				inst.periods_skipped += tn - t;
+			if (tn >= m_sim_params.sim_length)
+				break;
+			t = tn;
+		}
+		//read-in periods are timed as a whole, and others by phase
+		bool read_in = t <= m_results.period_of_last_repair[m_current_scenario] ||
+			t <= m_results.period_of_last_failure[m_current_scenario];
+		PhaseTimer read_in_timer(read_in ? PhaseTime(inst.read_in_time) : NULL);
+		if (instrument && read_in)
+			inst.periods_read_in++;
 		ResetCycleEventFlags();
 		//Shut all components down for maintenance if such an event is 
 		//read in inputs, or the hours to maintenance is <= zero.
 		//record the event at the period to be read in next.
 		if( m_current_cycle_state.hours_to_maintenance <= 0  && t > m_results.period_of_last_repair[m_current_scenario] )
         {
+			PhaseTimer maintenance_timer(read_in ? NULL : PhaseTime(inst.maintenance_time));
             PlantMaintenanceShutdown(t, true, true);
         }
 		
@@ -2772,38 +3213,43 @@ void PowerCycle::RunDispatch()
 		power_output = m_dispatch.at("cycle_power").at(t);
 		thermal_output = m_dispatch.at("thermal_power").at(t);
 		SetCycleCapacityAndEfficiency(m_dispatch.at("ambient_temperature").at(t));
-		std::string start = GetStartMode(t);
-		std::string mode = GetOperatingMode(t);
+		start_mode start = GetStartModeEnum(t);
+		operating_mode mode = GetOperatingModeEnum(t);
 		if (m_cycle_capacity < DBL_EPSILON)
 		{
 			power_output = 0.0;
-			mode = "OFF";
+			mode = MODE_OFF;
 		}
 		//ajz: This was formerly for only periods after read-in
 		if (t > m_results.period_of_last_repair[m_current_scenario]  && 
 			t > m_results.period_of_last_failure[m_current_scenario])
 		{
 			double ramp_mult = GetRampMult(thermal_output);
-			TestForComponentFailures(ramp_mult, t, start, mode);
+			{
+				PhaseTimer failure_timer(PhaseTime(inst.failure_test_time));
+				TestForComponentFailures(ramp_mult, t, start, mode);
+			}
 			SetCycleCapacityAndEfficiency(m_dispatch.at("ambient_temperature").at(t));
 			//if the cycle Capacity is set to zero, this means the plant is in maintenace
 			//or a critical failure has occurred, so shut the plant down.
 			if (m_cycle_capacity < DBL_EPSILON)
 			{
 				power_output = 0.0;
-				mode = "OFF";
+				mode = MODE_OFF;
 			}
 			else if (m_cycle_capacity < m_shutdown_capacity || m_cycle_efficiency < m_shutdown_efficiency)
 			{
+				PhaseTimer maintenance_timer(PhaseTime(inst.maintenance_time));
 				PlantMaintenanceShutdown(t, false, true, GetMaxComponentDowntime());
 			}
 			else if (
-				mode == "OFF" && (
+				mode == MODE_OFF && (
 					m_cycle_capacity < m_no_restart_capacity ||
 					m_cycle_efficiency < m_no_restart_efficiency
 					)
 				)
 			{
+				PhaseTimer maintenance_timer(PhaseTime(inst.maintenance_time));
 				PlantMaintenanceShutdown(t, false, true, GetMaxComponentDowntime());
 			}
 			SetCycleCapacityAndEfficiency(m_dispatch.at("ambient_temperature").at(t));
@@ -2813,7 +3259,10 @@ void PowerCycle::RunDispatch()
 				thermal_output = std::min(thermal_output, m_cycle_capacity*m_current_cycle_state.thermal_capacity);
 			}
 		}
-		OperatePlant(power_output, thermal_output, t, start, mode);
+		{
+			PhaseTimer operate_timer(read_in ? NULL : PhaseTime(inst.operate_time));
+			OperatePlant(power_output, thermal_output, t, start, mode);
+		}
 		cycle_capacities[t] = m_cycle_capacity;
 		cycle_efficiencies[t] = m_cycle_efficiency;
 		if (t > m_results.period_of_last_failure[m_current_scenario] &&
@@ -2840,7 +3289,7 @@ void PowerCycle::RunDispatch()
 					//the mean repair time.  Any other components won't be 
 					//repaired for the rest of the day.
 					SetCycleCapacityAndEfficiency(m_dispatch.at("ambient_temperature").at(t));
-					AdvanceDowntime("OO");
+					AdvanceDowntime(MODE_OO);
 					cycle_capacities[tp] = m_cycle_capacity * 1.0;
 					cycle_efficiencies[tp] = m_cycle_efficiency * 1.0;
 				}
@@ -2875,7 +3324,7 @@ void PowerCycle::RunDispatch()
 					//the mean repair time.  Any other components won't be 
 					//repaired for the rest of the day.
 					SetCycleCapacityAndEfficiency(m_dispatch.at("ambient_temperature").at(t));
-					AdvanceDowntime("OO");
+					AdvanceDowntime(MODE_OO);
 					cycle_capacities[tp] = m_cycle_capacity * 1.0;
 					cycle_efficiencies[tp] = m_cycle_efficiency * 1.0;
 				}
@@ -2890,8 +3339,8 @@ void PowerCycle::RunDispatch()
 	//happen if the last periods efficiency/capacity do not match those of the
 	//results from the last run, or there would be a prior event triggered.
 	if (!m_new_failure_occurred && !m_new_repair_occurred && (
-		cycle_efficiencies[m_sim_params.sim_length - 1] != m_results.cycle_efficiency[m_current_scenario].at(m_sim_params.sim_length - 1) ||
-		cycle_capacities[m_sim_params.sim_length - 1] != m_results.cycle_capacity[m_current_scenario].at(m_sim_params.sim_length - 1)
+		cycle_efficiencies[m_sim_params.sim_length - 1] != PreviousResult(m_results.cycle_efficiency, m_current_scenario, m_sim_params.sim_length - 1) ||
+		cycle_capacities[m_sim_params.sim_length - 1] != PreviousResult(m_results.cycle_capacity, m_current_scenario, m_sim_params.sim_length - 1)
 		))
 	{
 		
@@ -2904,9 +3353,176 @@ void PowerCycle::RunDispatch()
 	StoreScenarioResults(cycle_efficiencies, cycle_capacities);
 }
 
+int PowerCycle::RunSteadyPeriods(int t, std::vector<double> &cycle_capacities, 
+	std::vector<double> &cycle_efficiencies)
+{
+	/*
+	Simulates a run of steady periods starting at period t, i.e., periods in 
+	which no component is under a repair that progresses, no pump switch is 
+	in progress, no maintenance is due, and the plant remains offline, on 
+	standby (beyond the first hour) or online (beyond the first hour) with no
+	start.  In such periods the component states change only through wear, 
+	the cycle capacity and efficiency depend only on whether the ambient 
+	temperature is below the condenser threshold, and no RNG draws are made,
+	so only the lifetimes of the failure types that apply to the mode and 
+	the plant's run-time counters need updating.  The updates use 
+	the same arithmetic as TestForComponentFailures() and OperatePlant(), so 
+	results are identical to stepping through each period.  The run ends at 
+	the first period that would produce a failure, a start, a change of mode,
+	or a maintenance event; that period is left to the full update in 
+	RunDispatch().
+
+	t -- first period of the run
+	cycle_capacities -- cycle capacity by period (updated)
+	cycle_efficiencies -- cycle efficiency by period (updated)
+	retval -- first period not simulated
+	*/
+	if (t <= m_results.period_of_last_repair[m_current_scenario] ||
+		t <= m_results.period_of_last_failure[m_current_scenario])
+		return t;
+	if (m_current_cycle_state.salt_pump_switch_time != 0. ||
+		m_current_cycle_state.boiler_pump_switch_time != 0. ||
+		m_current_cycle_state.water_pump_switch_time != 0.)
+		return t;
+	operating_mode mode = GetOperatingModeEnum(t);
+	if (mode != MODE_OO && mode != MODE_SO && mode != MODE_OFF)
+		return t;
+	ComponentStateArrays &cs = m_component_state;
+	for (size_t i = 0; i < cs.Size(); i++)
+	{
+		if (!cs.operational[i] && cs.CanBeRepaired((int)i, mode))
+			return t;
+	}
+
+	//capacity and efficiency below [0] and at or above [1] the condenser 
+	//temperature threshold
+	double cap[2], eff[2];
+	SetCycleCapacityAndEfficiency(m_condenser_temp_threshold - 1.);
+	cap[0] = m_cycle_capacity;
+	eff[0] = m_cycle_efficiency;
+	SetCycleCapacityAndEfficiency(m_condenser_temp_threshold);
+	cap[1] = m_cycle_capacity;
+	eff[1] = m_cycle_efficiency;
+	bool steady[2];
+	for (int k = 0; k < 2; k++)
+	{
+		steady[k] = !(cap[k] < DBL_EPSILON || cap[k] < m_shutdown_capacity || eff[k] < m_shutdown_efficiency);
+		if (mode == MODE_OFF && (cap[k] < m_no_restart_capacity || eff[k] < m_no_restart_efficiency))
+			steady[k] = false;
+	}
+	ResetCycleEventFlags();
+
+	//failure types of operational components whose lifetimes are expended 
+	//in this mode
+	std::vector< size_t > &lives = m_steady_lives;
+	std::vector< size_t > &owner = m_steady_owners;
+	lives.clear();
+	owner.clear();
+	if (mode != MODE_OFF)
+	{
+		for (size_t i = 0; i < cs.Size(); i++)
+		{
+			if (!cs.operational[i])
+				continue;
+			for (size_t j = cs.life_offset[i]; j < cs.life_offset[i + 1]; j++)
+			{
+				operating_mode fmode = cs.fail_mode[j];
+				if (fmode == mode || fmode == MODE_ALL || (fmode == MODE_O && mode == MODE_OO))
+				{
+					lives.push_back(j);
+					owner.push_back(i);
+				}
+			}
+		}
+	}
+
+	const std::vector<double> &cycle_power = m_dispatch.at("cycle_power");
+	const std::vector<double> &thermal_power = m_dispatch.at("thermal_power");
+	const std::vector<double> &standby = m_dispatch.at("standby");
+	const std::vector<double> &temperature = m_dispatch.at("ambient_temperature");
+	double step = m_sim_params.steplength;
+	int tstart = t;
+	int k = 0;
+	for (; t < m_sim_params.sim_length; t++)
+	{
+		//mode is unchanged; see GetOperatingModeEnum()
+		if (mode == MODE_OO ? cycle_power.at(t) <= DBL_EPSILON :
+			(cycle_power.at(t) > DBL_EPSILON || (standby.at(t) >= 0.5) != (mode == MODE_SO)))
+			break;
+		if (m_current_cycle_state.hours_to_maintenance <= 0)
+			break;
+		k = temperature.at(t) < m_condenser_temp_threshold ? 0 : 1;
+		if (!steady[k])
+			break;
+		double power_output = cycle_power.at(t);
+		double thermal_output = thermal_power.at(t);
+
+		//no failures; see Component::TestForFailure()
+		double ramp_mult = GetRampMult(thermal_output);
+		bool failure = false;
+		for (size_t j = 0; j < lives.size() && !failure; j++)
+			failure = step * cs.hazard_rate[owner[j]] * ramp_mult > cs.lifetimes[lives[j]];
+		if (failure)
+			break;
+
+		if (cap[k] <= 1.0 - DBL_EPSILON)
+		{
+			power_output = std::min(power_output, cap[k]*m_current_cycle_state.capacity);
+			thermal_output = std::min(thermal_output, cap[k]*m_current_cycle_state.thermal_capacity);
+		}
+
+		//see OperatePlant() and ComponentStateArrays::Operate()
+		ramp_mult = GetRampMult(thermal_output);
+		m_current_cycle_state.thermal_output = thermal_output;
+		m_current_cycle_state.power_output = power_output;
+		for (size_t j = 0; j < lives.size(); j++)
+			cs.lifetimes[lives[j]] -= (step * cs.hazard_rate[owner[j]] * ramp_mult);
+		if (mode == MODE_OFF)
+		{
+			m_current_cycle_state.is_online = false;
+			m_current_cycle_state.is_on_standby = false;
+			m_current_cycle_state.downtime += step;
+			m_current_cycle_state.time_in_standby = 0.0;
+			m_current_cycle_state.time_online = 0.0;
+		}
+		else if (mode == MODE_SO)
+		{
+			m_current_cycle_state.downtime = 0.0;
+			m_current_cycle_state.time_online = 0.0;
+			m_current_cycle_state.time_in_standby += step;
+		}
+		else
+		{
+			for (size_t i = 0; i < cs.Size(); i++)
+				if (cs.operational[i])
+					cs.age[i] += step;
+			m_current_cycle_state.time_in_standby = 0.0;
+			m_current_cycle_state.downtime = 0.0;
+			m_current_cycle_state.time_online += step;
+			m_current_cycle_state.hours_to_maintenance -= step;
+		}
+		cycle_capacities[t] = cap[k];
+		cycle_efficiencies[t] = eff[k];
+	}
+	if (t > tstart)
+	{
+		m_cycle_capacity = cycle_capacities[t - 1];
+		m_cycle_efficiency = cycle_efficiencies[t - 1];
+	}
+	return t;
+}
+
 void PowerCycle::OperatePlant(double power_out, 
 	double thermal_out, int t, std::string start, std::string mode)
 {
+	/* string-based adapter; see OperatePlant(double, double, int, start_mode, operating_mode). */
+	OperatePlant(power_out, thermal_out, t, StartModeFromString(start), 
+		OperatingModeFromString(mode));
+}
+
+void PowerCycle::OperatePlant(double power_out, 
+	double thermal_out, int t, start_mode start, operating_mode mode)
+{
 
     /*
 	
@@ -2944,17 +3560,17 @@ void PowerCycle::OperatePlant(double power_out,
 			m_sim_params.steplength
 		)
 		);
-	if (mode == "OFF")
+	if (mode == MODE_OFF)
 	{
 		m_current_cycle_state.is_online = false;
 		m_current_cycle_state.is_on_standby = false;
 		m_current_cycle_state.downtime += m_sim_params.steplength;
 		m_current_cycle_state.time_in_standby = 0.0;
 		m_current_cycle_state.time_online = 0.0;
-		AdvanceDowntime("OFF");
+		AdvanceDowntime(MODE_OFF);
 		return;
 	}
-	else if (mode == "SS") //standby - start
+	else if (mode == MODE_SS) //standby - start
 	{
 		m_current_cycle_state.is_online = false;
 		m_current_cycle_state.is_on_standby = true;
@@ -2963,15 +3579,15 @@ void PowerCycle::OperatePlant(double power_out,
 		m_current_cycle_state.time_online = 0.0;
 		if (m_sim_params.steplength >= 1.0 + DBL_EPSILON)
 		{
-			OperateComponents(ramp_mult, t, start, "SS", 1.0);
-			OperateComponents(ramp_mult, t, start, "SO", m_sim_params.steplength-1.0);
+			OperateComponents(ramp_mult, t, start, MODE_SS, 1.0);
+			OperateComponents(ramp_mult, t, start, MODE_SO, m_sim_params.steplength-1.0);
 		}
 		else
 		{
-			OperateComponents(ramp_mult, t, start, "SS", m_sim_params.steplength);
+			OperateComponents(ramp_mult, t, start, MODE_SS, m_sim_params.steplength);
 		}
 	}
-	else if (mode == "SF" || mode == "SO") //standby - first hour; standby ongoing (>1 hour)
+	else if (mode == MODE_SF || mode == MODE_SO) //standby - first hour; standby ongoing (>1 hour)
 	{
 		m_current_cycle_state.is_online = false;
 		m_current_cycle_state.is_on_standby = true;
@@ -2980,9 +3596,9 @@ void PowerCycle::OperatePlant(double power_out,
 		if (m_current_cycle_state.time_in_standby <= 1.0 - DBL_EPSILON &&
 			m_current_cycle_state.time_in_standby + m_sim_params.steplength >= 1.0 + DBL_EPSILON)
 		{
-			OperateComponents(ramp_mult, t, start, "SF", 
+			OperateComponents(ramp_mult, t, start, MODE_SF, 
 				1.0 - m_current_cycle_state.time_in_standby);
-			OperateComponents(ramp_mult, t, start, "SO", 
+			OperateComponents(ramp_mult, t, start, MODE_SO, 
 				m_current_cycle_state.time_in_standby + m_sim_params.steplength - 1.0);
 		}
 		else 
@@ -2991,7 +3607,7 @@ void PowerCycle::OperatePlant(double power_out,
 		}
 		m_current_cycle_state.time_in_standby += m_sim_params.steplength;
 	}
-	else if (mode == "OS") //online - start
+	else if (mode == MODE_OS) //online - start
 	{
 		m_current_cycle_state.is_online = true;
 		m_current_cycle_state.is_on_standby = false;
@@ -3001,15 +3617,15 @@ void PowerCycle::OperatePlant(double power_out,
 		m_current_cycle_state.hours_to_maintenance -= m_sim_params.steplength;
 		if (m_sim_params.steplength >= 1.0 + DBL_EPSILON)
 		{
-			OperateComponents(ramp_mult, t, start, "OS", 1.0);
-			OperateComponents(ramp_mult, t, start, "OO", m_sim_params.steplength - 1.0);
+			OperateComponents(ramp_mult, t, start, MODE_OS, 1.0);
+			OperateComponents(ramp_mult, t, start, MODE_OO, m_sim_params.steplength - 1.0);
 		}
 		else
 		{
-			OperateComponents(ramp_mult, t, start, "OS", m_sim_params.steplength);
+			OperateComponents(ramp_mult, t, start, MODE_OS, m_sim_params.steplength);
 		}
 	}
-	else if (mode == "OF" || mode == "OO") //standby - first hour; standby ongoing (>1 hour)
+	else if (mode == MODE_OF || mode == MODE_OO) //standby - first hour; standby ongoing (>1 hour)
 	{
 		m_current_cycle_state.is_online = true;
 		m_current_cycle_state.is_on_standby = false;
@@ -3018,9 +3634,9 @@ void PowerCycle::OperatePlant(double power_out,
 		if (m_current_cycle_state.time_online <= 1.0 - DBL_EPSILON &&
 			m_current_cycle_state.time_online + m_sim_params.steplength >= 1.0 + DBL_EPSILON)
 		{
-			OperateComponents(ramp_mult, t, start, "OF",
+			OperateComponents(ramp_mult, t, start, MODE_OF,
 				1.0 - m_current_cycle_state.time_online);
-			OperateComponents(ramp_mult, t, start, "OO",
+			OperateComponents(ramp_mult, t, start, MODE_OO,
 				m_current_cycle_state.time_online + m_sim_params.steplength - 1.0);
 		}
 		else
@@ -3042,74 +3658,136 @@ void PowerCycle::SingleScen(bool read_state_from_file, bool read_from_memory,
     /*failure_file = open(
         os.path.join(m_sim_params.print_output_dir,"component_failures.csv"),'w'
         )*/
-	if (read_state_from_file)
-	{
-		ReadStateFromFiles(init);
-	}
-	else if (read_from_memory)
+	cycle_instrumentation &inst = m_results.instrumentation;
+	uint64_t start_variates = m_sim_params.instrument ? GetNumVariates() : 0;
+	PhaseTimer scenario_timer(PhaseTime(inst.scenario_time));
 	{
-		ReadCycleStateFromResults();
-		ReadComponentStatus(m_results.component_status[m_current_scenario]);
+		PhaseTimer state_timer(PhaseTime(inst.state_time));
+		if (read_state_from_file)
+		{
+			ReadStateFromFiles(init);
+		}
+		else if (read_from_memory)
+		{
+			ReadCycleStateFromResults();
+		}
+		StoreComponentState();
 	}
-	m_start_component_status = GetComponentStates();
-	RunDispatch();
+	RunDispatch(read_from_memory && !read_state_from_file);
 	if ((m_new_repair_occurred && m_sim_params.stop_at_first_repair) 
 		|| (m_new_failure_occurred && m_sim_params.stop_at_first_failure) )
 	{
+		PhaseTimer state_timer(PhaseTime(inst.state_time));
 		RevertToStartState(false);
 	}
 	else
 	{
-		StoreCycleState();
+		{
+			PhaseTimer state_timer(PhaseTime(inst.state_time));
+			StoreCycleState();
+		}
 		m_results.period_of_last_failure[m_current_scenario] = -1;
 		m_results.period_of_last_repair[m_current_scenario] = -1;
 		if (m_file_settings.output_to_files)
 		{
+			PhaseTimer output_timer(PhaseTime(inst.output_time));
 			WriteFailureStats();
 			WriteFailuresFile();
 		}
 		ClearFailureEvents();
 	}
 	if (m_file_settings.output_ampl_file)
+	{
+		PhaseTimer output_timer(PhaseTime(inst.output_time));
 		WriteAMPLParams();
-	RecordFinalState();
+	}
+	{
+		PhaseTimer state_timer(PhaseTime(inst.state_time));
+		RecordFinalState();
+	}
+	if (m_sim_params.instrument)
+		inst.variates_drawn += GetNumVariates() - start_variates;
 }
 
 void PowerCycle::GetSummaryResults()
 {
 	/*
 	Calculates the time series of the sample mean 
-	efficiency and capacity of the power cycle.
+	efficiency and capacity of the power cycle, and the confidence intervals
+	of the mean capacity, efficiency and labor cost over scenarios.  Under 
+	importance sampling, the means are weighted by the likelihood ratios of
+	the scenarios and divided by the sum of the ratios.  With retained 
+	scenario results, the estimates and period statistics cover all 
+	scenarios, including those not rerun.
 	*/
 	m_results.avg_cycle_efficiency.clear();
 	m_results.avg_cycle_capacity.clear();
-	double avg_eff = 0.; 
-	double avg_cap = 0.;
+	std::vector<double> weights(m_sim_params.num_scenarios, 1.);
+	double total_weight = 0.;
 	double avg_labor = 0.;
 	double avg_turb_cap = 0.;
 	double avg_turb_eff = 0.;
 	for (int s = 0; s < m_sim_params.num_scenarios; s++)
 	{
-		avg_labor += m_results.labor_costs[s];
-		avg_turb_cap += m_results.turbine_capacity[s];
-		avg_turb_eff += m_results.turbine_efficiency[s];
+		std::unordered_map<int, double>::const_iterator w = m_results.scenario_weights.find(s);
+		if (w != m_results.scenario_weights.end())
+			weights[s] = w->second;
+		total_weight += weights[s];
+		avg_labor += weights[s] * m_results.labor_costs[s];
+		avg_turb_cap += weights[s] * m_results.turbine_capacity[s];
+		avg_turb_eff += weights[s] * m_results.turbine_efficiency[s];
 	}
-	m_results.avg_labor_cost = avg_labor / m_sim_params.num_scenarios;
-	m_results.avg_turbine_capacity = avg_turb_cap / m_sim_params.num_scenarios;
-	m_results.avg_turbine_efficiency = avg_turb_eff / m_sim_params.num_scenarios;
-	for (int t = 0; t < m_sim_params.sim_length; t++)
+	m_results.avg_labor_cost = avg_labor / total_weight;
+	m_results.avg_turbine_capacity = avg_turb_cap / total_weight;
+	m_results.avg_turbine_efficiency = avg_turb_eff / total_weight;
+	if (!m_sim_params.retain_scenario_results)
+	{
+		//all scenarios were added to the statistics and estimates, in order
+		m_results.avg_cycle_efficiency = m_results.efficiency_statistics.GetMean();
+		m_results.avg_cycle_capacity = m_results.capacity_statistics.GetMean();
+		UpdateConfidenceIntervals();
+		return;
+	}
+	//scenarios not rerun from memory keep their previous series; unless every
+	//scenario was added in this run, in order, the period statistics hold 
+	//only those rerun and are rebuilt along with the estimates
+	bool rebuild_statistics = m_results.capacity_statistics.GetCount() != m_sim_params.num_scenarios;
+	if (rebuild_statistics)
+	{
+		m_results.capacity_statistics.Reset(m_sim_params.sim_length, m_sim_params.result_quantiles);
+		m_results.efficiency_statistics.Reset(m_sim_params.sim_length, m_sim_params.result_quantiles);
+	}
+	m_results.capacity_estimate.Reset();
+	m_results.efficiency_estimate.Reset();
+	m_results.labor_cost_estimate.Reset();
+	//sum over scenarios in order, one series at a time
+	m_results.avg_cycle_efficiency.assign(m_sim_params.sim_length, 0.);
+	m_results.avg_cycle_capacity.assign(m_sim_params.sim_length, 0.);
+	for (int s = 0; s < m_sim_params.num_scenarios; s++)
 	{
-		avg_eff = 0;
-		avg_cap = 0;
-		for (int s = 0; s < m_sim_params.num_scenarios; s++)
+		const std::vector<double> &eff = m_results.cycle_efficiency.at(s);
+		const std::vector<double> &cap = m_results.cycle_capacity.at(s);
+		if ((int)eff.size() < m_sim_params.sim_length || (int)cap.size() < m_sim_params.sim_length)
+			throw std::runtime_error("scenario results are shorter than the simulation length.");
+		double w = weights[s];
+		for (int t = 0; t < m_sim_params.sim_length; t++)
 		{
-			avg_eff += m_results.cycle_efficiency[s].at(t);
-			avg_cap += m_results.cycle_capacity[s].at(t);
+			m_results.avg_cycle_efficiency[t] += w * eff[t];
+			m_results.avg_cycle_capacity[t] += w * cap[t];
 		}
-		m_results.avg_cycle_efficiency.push_back(avg_eff / m_sim_params.num_scenarios);
-		m_results.avg_cycle_capacity.push_back(avg_cap / m_sim_params.num_scenarios);
+		if (rebuild_statistics)
+		{
+			m_results.capacity_statistics.Add(cap, w);
+			m_results.efficiency_statistics.Add(eff, w);
+		}
+		AddScenarioEstimates(cap, eff, m_results.labor_costs[s], w, s);
+	}
+	UpdateConfidenceIntervals();
+	for (int t = 0; t < m_sim_params.sim_length; t++)
+	{
+		m_results.avg_cycle_efficiency[t] /= total_weight;
+		m_results.avg_cycle_capacity[t] /= total_weight;
 	}
-	
 }
 
 double PowerCycle::GetLaborCosts(size_t start_fail_idx)
@@ -3119,15 +3797,15 @@ double PowerCycle::GetLaborCosts(size_t start_fail_idx)
 	in the current scenario.
 
 	start_fail_idx -- starting index of failure event labels to check; this value
-	   is the size of m_failure_event_labels at the start of the scenario.
+	   is the size of m_failure_events at the start of the scenario.
 
 	retval - estimated labor costs, in dollars
 	*/
 	double hours = 0;
 	
-	for (size_t i = start_fail_idx; i < m_failure_event_labels.size(); i++)
+	for (size_t i = start_fail_idx; i < m_failure_events.Size(); i++)
 	{
-		hours += m_failure_events[m_failure_event_labels[i]].labor;
+		hours += m_failure_events.At(i).labor;
 	}
 	return hours * m_sim_params.hourly_labor_cost;
 }
@@ -3141,6 +3819,7 @@ void PowerCycle::StoreScenarioResults(std::vector <double> cycle_efficiencies,
 	m_results.cycle_efficiency[m_current_scenario] = cycle_efficiencies;
 	m_results.cycle_capacity[m_current_scenario] = cycle_capacities;
 	m_results.labor_costs[m_current_scenario] = GetLaborCosts(0);
+	m_results.scenario_weights[m_current_scenario] = std::exp(m_component_state.log_likelihood_ratio);
 	m_results.turbine_capacity[m_current_scenario] = GetTurbineCapacity(true, true);
 	m_results.turbine_efficiency[m_current_scenario] = GetTurbineEfficiency(true, true);
 	m_results.expected_time_to_failure = GetEstimatedMinimumLifetime();
@@ -3164,25 +3843,994 @@ void PowerCycle::Simulate(
 	run_only_previous_failures -- only runs scenarios that generated a new 
 			failure in the last iteration if true
 
+	Unless the state is read from file, each scenario starts from the plant 
+	state at the time of the call (or from its own stored state if reading
+	from memory) and uses its own RNG streams, so scenarios are independent
+	and are run on m_sim_params.num_threads worker threads.
+
+	The capacity and efficiency of each scenario run are added, in scenario
+	order, to the per-period statistics in the results, and written to the 
+	trace file if m_file_settings.trace_filename is set.  Unless 
+	m_sim_params.retain_scenario_results is true, the series are then 
+	dropped, so memory does not grow with the number of scenarios; runs from 
+	memory compare against the previous run's series, so they require the 
+	series to be retained.
+
+	Scenarios that do not resume from memory may draw their variates in 
+	ways that reduce the variance of the means over scenarios:
+	- m_sim_params.sample_lifetimes -- each scenario draws new lifetimes of
+	  all failure types at its start, as for new components (hazard rates 
+	  and ages are kept); otherwise, all scenarios start with the lifetimes 
+	  of the plant at the time of the call.
+	- SAMPLING_ANTITHETIC -- scenario 2k+1 uses the streams of scenario 2k,
+	  with every variate u replaced by its complement 1-u, so the members of
+	  each pair are negatively correlated.
+	- SAMPLING_LATIN_HYPERCUBE -- the lifetimes drawn at the start of the 
+	  scenarios form a Latin hypercube sample, with each failure type as a 
+	  dimension, so each stratum of each lifetime distribution is covered 
+	  once; distributions not sampled by inversion are not stratified.
+	- m_sim_params.importance_scale -- lifetimes of rare failure types, 
+	  those with a probability of at most m_sim_params.importance_rare_prob
+	  of falling within the length of the run, do so this many times as 
+	  often, up to a total probability of one half over the rare failure 
+	  types (see FailureType::SetImportanceSampling()).  Results are 
+	  weighted by the likelihood ratio of each scenario, in 
+	  cycle_results::scenario_weights.
+	These options are not available for runs read from files.
+
+	The means over scenarios of the mean capacity and efficiency of each 
+	scenario and of its labor cost are reported with confidence intervals 
+	at level m_sim_params.ci_level.  If m_sim_params.ci_target is positive,
+	runs that do not resume from memory add scenarios, m_sim_params.
+	scenario_batch at a time after the first m_sim_params.num_scenarios, 
+	until the half-widths of all three intervals are at most ci_target 
+	times the means, or m_sim_params.max_scenarios have been run.  Batches 
+	are rounded up to whole antithetic pairs, and each batch forms its own 
+	Latin hypercube sample.  m_sim_params.num_scenarios is then set to the 
+	number of scenarios run, so that later runs from memory continue all of
+	them; the trace file is sized for max_scenarios.
+
+	If m_sim_params.instrument is set, event counts and the wall times of 
+	the phases of the scenarios are kept in m_results.instrumentation.
+
 	Note: labor costs are in aggregate and not scenario-specific.
 	*/
-	for (int i = 0; i < m_sim_params.num_scenarios; i++)
+	if (m_sim_params.sampling_method < SAMPLING_INDEPENDENT || 
+		m_sim_params.sampling_method > SAMPLING_LATIN_HYPERCUBE)
+		throw std::runtime_error("invalid scenario sampling method.");
+	if (m_sim_params.sampling_method == SAMPLING_LATIN_HYPERCUBE && !m_sim_params.sample_lifetimes)
+		throw std::runtime_error("Latin hypercube sampling requires sampled lifetimes.");
+	if (read_state_from_file && (m_sim_params.sampling_method != SAMPLING_INDEPENDENT ||
+		m_sim_params.sample_lifetimes || m_sim_params.importance_scale != 1.))
+		throw std::runtime_error("scenario sampling options are not available for runs read from files.");
+	if (!(m_sim_params.ci_level > 0. && m_sim_params.ci_level < 1.))
+		throw std::runtime_error("confidence level must be between zero and one.");
+	bool adaptive = m_sim_params.ci_target > 0. && 
+		!read_state_from_file && !read_state_from_memory && !run_only_previous_failures;
+	if (adaptive && (m_sim_params.scenario_batch < 1 || 
+		m_sim_params.max_scenarios < m_sim_params.num_scenarios))
+		throw std::runtime_error("sequential runs require a positive scenario batch and "
+			"at least num_scenarios maximum scenarios.");
+	m_results.instrumentation.Reset();
+	PhaseTimer simulate_timer(PhaseTime(m_results.instrumentation.simulate_time));
+	ApplyImportanceSampling();
+	if (!m_sim_params.retain_scenario_results)
 	{
-		m_current_scenario = i;
-		if (!run_only_previous_failures || m_results.period_of_last_failure[i] > -1)
+		if (read_state_from_memory || run_only_previous_failures)
+			throw std::runtime_error("runs from memory require retained scenario results.");
+		m_results.cycle_capacity.clear();
+		m_results.cycle_efficiency.clear();
+	}
+	m_results.capacity_statistics.Reset(m_sim_params.sim_length, m_sim_params.result_quantiles);
+	m_results.efficiency_statistics.Reset(m_sim_params.sim_length, m_sim_params.result_quantiles);
+	m_results.capacity_estimate.Reset();
+	m_results.efficiency_estimate.Reset();
+	m_results.labor_cost_estimate.Reset();
+	int max_scenarios = adaptive ? m_sim_params.max_scenarios : m_sim_params.num_scenarios;
+	ScenarioTraceFile trace;
+	if (!m_file_settings.trace_filename.empty())
+		trace.Create(m_file_settings.trace_filename, max_scenarios, m_sim_params.sim_length);
+
+	if (read_state_from_file)
+	{
+		for (int i = 0; i < m_sim_params.num_scenarios; i++)
 		{
-			SingleScen(read_state_from_file, read_state_from_memory, init);
+			m_current_scenario = i;
+			if (!run_only_previous_failures || m_results.period_of_last_failure[i] > -1)
+			{
+				SingleScen(read_state_from_file, read_state_from_memory, init);
 
-			//Record failure events
-			m_results.failure_events[m_current_scenario] = m_failure_events;
-			m_results.failure_event_labels[m_current_scenario] = m_failure_event_labels;
+				//Record failure events
+				m_results.failure_events[m_current_scenario] = m_failure_events;
+				CommitScenarioResults(m_results, i, trace);
+			}
+		}
+	}
+	else
+	{
+		std::vector<int> scenarios;
+		for (int i = 0; i < max_scenarios; i++)
+		{
+			if (!run_only_previous_failures || m_results.period_of_last_failure[i] > -1)
+				scenarios.push_back(i);
+		}
+		size_t first_batch = scenarios.size();
+		size_t batch = 0;
+		if (adaptive)
+		{
+			bool antithetic = m_sim_params.sampling_method == SAMPLING_ANTITHETIC;
+			first_batch = m_sim_params.num_scenarios;
+			batch = m_sim_params.scenario_batch;
+			if (antithetic)
+			{
+				first_batch += first_batch % 2;
+				batch += batch % 2;
+			}
 		}
+		size_t nrun = RunScenarios(scenarios, read_state_from_memory, init, trace, first_batch, batch);
+		if (adaptive)
+			m_sim_params.num_scenarios = (int)nrun;
+	}
+	m_results.scenarios_run = m_sim_params.num_scenarios;
+	trace.Close();
+	{
+		PhaseTimer output_timer(PhaseTime(m_results.instrumentation.output_time));
+		FlushOutputFiles();
 	}
 	
 	//Obtain Summary Statistics
 	GetSummaryResults();
 }
 
+void PowerCycle::CommitScenarioResults(cycle_results &results, int s, 
+	ScenarioTraceFile &trace)
+{
+	/*
+	Adds the capacity and efficiency series of a finished scenario to the 
+	statistics and estimates in m_results and to the trace file, if open, 
+	and drops them from 'results' unless scenario results are retained.  
+	Called in scenario order.
+
+	results -- results holding the scenario's series
+	s -- scenario index
+	trace -- trace file
+	*/
+	const std::vector<double> &cap = results.cycle_capacity.at(s);
+	const std::vector<double> &eff = results.cycle_efficiency.at(s);
+	std::unordered_map<int, double>::const_iterator w = results.scenario_weights.find(s);
+	double weight = w == results.scenario_weights.end() ? 1. : w->second;
+	m_results.capacity_statistics.Add(cap, weight);
+	m_results.efficiency_statistics.Add(eff, weight);
+	std::unordered_map<int, double>::const_iterator labor = results.labor_costs.find(s);
+	AddScenarioEstimates(cap, eff, labor == results.labor_costs.end() ? 0. : labor->second, 
+		weight, s);
+	if (trace.IsOpen())
+		trace.Write(s, cap, eff);
+	if (!m_sim_params.retain_scenario_results)
+	{
+		results.cycle_capacity.erase(s);
+		results.cycle_efficiency.erase(s);
+	}
+}
+
+void PowerCycle::AddScenarioEstimates(const std::vector<double> &cap, 
+	const std::vector<double> &eff, double labor_cost, double weight, int s)
+{
+	/*
+	Adds the mean capacity and efficiency and the labor cost of a scenario
+	to the running estimates in m_results.  The two scenarios of an 
+	antithetic pair form one independent unit of the estimates.
+	cap, eff -- capacity and efficiency series of the scenario
+	labor_cost -- labor cost of the scenario
+	weight -- likelihood ratio of the scenario
+	s -- scenario index
+	*/
+	double cap_sum = 0., eff_sum = 0.;
+	for (int t = 0; t < m_sim_params.sim_length; t++)
+	{
+		cap_sum += cap.at(t);
+		eff_sum += eff.at(t);
+	}
+	bool end_unit = m_sim_params.sampling_method != SAMPLING_ANTITHETIC || s % 2 == 1;
+	m_results.capacity_estimate.Add(cap_sum / m_sim_params.sim_length, weight, end_unit);
+	m_results.efficiency_estimate.Add(eff_sum / m_sim_params.sim_length, weight, end_unit);
+	m_results.labor_cost_estimate.Add(labor_cost, weight, end_unit);
+}
+
+bool PowerCycle::UpdateConfidenceIntervals()
+{
+	/*
+	Sets the confidence intervals in m_results from the running estimates,
+	at level m_sim_params.ci_level.
+	retval -- true if m_sim_params.ci_target is positive and the half-widths
+		of all intervals are at most ci_target times their means
+	*/
+	double z = m_hs_dist.NormalCDFInverse(0.5 + 0.5 * m_sim_params.ci_level);
+	const MeanEstimate *estimates[3] = { 
+		&m_results.capacity_estimate, &m_results.efficiency_estimate, &m_results.labor_cost_estimate 
+	};
+	confidence_interval *intervals[3] = { 
+		&m_results.capacity_ci, &m_results.efficiency_ci, &m_results.labor_cost_ci 
+	};
+	bool met = m_sim_params.ci_target > 0.;
+	for (int i = 0; i < 3; i++)
+	{
+		intervals[i]->mean = estimates[i]->GetMean();
+		intervals[i]->half_width = z * estimates[i]->GetStandardError();
+		if (!(intervals[i]->half_width <= m_sim_params.ci_target * std::fabs(intervals[i]->mean)))
+			met = false;
+	}
+	m_results.ci_target_met = met;
+	return met;
+}
+
+template <typename T>
+static void CopyScenarioEntry(
+	const std::unordered_map<int, T> &src, 
+	std::unordered_map<int, T> &dst, 
+	int s
+)
+{
+	typename std::unordered_map<int, T>::const_iterator it = src.find(s);
+	if (it != src.end())
+		dst[s] = it->second;
+}
+
+static void CopyScenarioResults(const cycle_results &src, cycle_results &dst, int s)
+{
+	/*
+	Copies all scenario-specific entries of a results structure for 
+	scenario s, skipping those that do not exist in the source.
+	*/
+	CopyScenarioEntry(src.cycle_capacity, dst.cycle_capacity, s);
+	CopyScenarioEntry(src.cycle_efficiency, dst.cycle_efficiency, s);
+	CopyScenarioEntry(src.labor_costs, dst.labor_costs, s);
+	CopyScenarioEntry(src.scenario_weights, dst.scenario_weights, s);
+	CopyScenarioEntry(src.final_state, dst.final_state, s);
+	CopyScenarioEntry(src.run_checkpoints, dst.run_checkpoints, s);
+	CopyScenarioEntry(src.failure_events, dst.failure_events, s);
+	CopyScenarioEntry(src.period_of_last_failure, dst.period_of_last_failure, s);
+	CopyScenarioEntry(src.period_of_last_repair, dst.period_of_last_repair, s);
+	CopyScenarioEntry(src.turbine_efficiency, dst.turbine_efficiency, s);
+	CopyScenarioEntry(src.turbine_capacity, dst.turbine_capacity, s);
+}
+
+void PowerCycle::BindComponents()
+{
+	/*
+	Points all components at this plant's failure event store and component
+	state arrays. Called after the plant is copied, since the copied 
+	components still refer to the containers of the original plant.
+	*/
+	for (size_t i = 0; i < m_components.size(); i++)
+		m_components.at(i).SetParentState(&m_failure_events, &m_component_state, (int)i);
+}
+
+void PowerCycle::RegisterComponent()
+{
+	/*
+	Adds state entries for the most recently added component, and points 
+	the component at them.
+	*/
+	Component &c = m_components.back();
+	int idx = m_component_state.AddComponent(
+		c.GetTypeCode(), c.GetRepairMode(), 
+		c.GetCapacityReduction(), c.GetEfficiencyReduction()
+	);
+	c.SetParentState(&m_failure_events, &m_component_state, idx);
+}
+
+int PowerCycle::GetComponentIndex(std::string name)
+{
+	/* 
+	name -- component identifier
+	retval -- position of the named component in m_components 
+	*/
+	for (size_t i = 0; i < m_components.size(); i++)
+		if (m_components.at(i).GetName() == name)
+			return (int)i;
+	throw std::runtime_error("Component " + name + " not found.");
+}
+
+uint64_t PowerCycle::GetFailureEventKey(const failure_event &e)
+{
+	/*
+	Recovers the failure event store key of an event, e.g., one read from 
+	the failure file.
+	e -- failure event
+	retval -- packed key of the event
+	*/
+	if (e.fail_idx >= 0)
+		return FailureEventStore::FailureKey(
+			e.scen_index, e.time, GetComponentIndex(e.component), e.fail_idx
+		);
+	if (e.component == "MAINTENANCE")
+		return FailureEventStore::MaintenanceKey(e.scen_index, e.time, true);
+	if (e.component == "UNPLANNEDMAINTENANCE")
+		return FailureEventStore::MaintenanceKey(e.scen_index, e.time, false);
+	const std::string suffix = "-SWITCH";
+	if (e.component.size() > suffix.size() &&
+		e.component.compare(e.component.size() - suffix.size(), suffix.size(), suffix) == 0)
+		return FailureEventStore::SwitchKey(
+			e.scen_index, e.time, 
+			GetComponentIndex(e.component.substr(0, e.component.size() - suffix.size()))
+		);
+	throw std::runtime_error("Unrecognized failure event: " + e.component);
+}
+
+size_t PowerCycle::RunScenarios(
+	const std::vector<int> &scenarios, 
+	bool read_state_from_memory, 
+	bool init,
+	ScenarioTraceFile &trace,
+	size_t first_batch,
+	size_t batch
+)
+{
+	/*
+	Runs a set of independent scenarios on a pool of worker threads.  Each 
+	worker holds its own copy of the plant and of the three RNG engines.  
+	Every scenario starts from the plant state at the time of the call and 
+	draws from its own streams (3s, 3s+1 and 3s+2), so the results do not 
+	depend on the number of threads or on the order in which the workers 
+	pick up scenarios. Results, stored RNG states and failure histories are 
+	merged back in scenario order, and the plant is left in the final state 
+	of the last scenario, as in a serial run.  Each scenario's series are 
+	committed (see CommitScenarioResults()) as soon as all scenarios before
+	it have finished, so only scenarios finished out of order are held.
+
+	Scenarios past the first batch are run as a sequential stopping rule:
+	no scenario of a batch starts before all earlier scenarios are 
+	committed, and the run stops once UpdateConfidenceIntervals() reports
+	that the target is met, so the number of scenarios run does not depend 
+	on the number of threads either.
+
+	scenarios -- indices of the scenarios to run, in increasing order
+	read_state_from_memory -- reads the start state of each scenario from 
+		the results object if true
+	init -- passed to SingleScen()
+	trace -- trace file, written if open
+	first_batch -- number of scenarios run before the first check of the 
+		stopping rule; all scenarios are run if not less than their number
+	batch -- number of scenarios added after each check
+	retval -- number of scenarios run, the first of 'scenarios'
+	*/
+	size_t n = scenarios.size();
+	if (n == 0)
+		return 0;
+	if (first_batch < n && batch == 0)
+		throw std::runtime_error("sequential runs require a positive scenario batch.");
+
+	//file outputs are written by each scenario, so keep those in order
+	int nthreads = std::max(1, std::min(m_sim_params.num_threads, (int)n));
+	if (m_file_settings.output_to_files || m_file_settings.output_ampl_file)
+		nthreads = 1;
+
+	//template plant, without the results and failure history
+	cycle_results results = std::move(m_results);
+	std::vector< failure_event > all_failures = std::move(m_all_failures);
+	m_results = cycle_results();
+	m_all_failures.clear();
+	PowerCycle base(*this);
+	m_results = std::move(results);
+	m_all_failures = std::move(all_failures);
+
+	std::vector< PowerCycle > plants(nthreads, base);
+	std::vector< WELLFiveTwelve > gens;
+	gens.reserve(3 * nthreads);
+	for (int w = 0; w < nthreads; w++)
+	{
+		gens.push_back(*m_life_gen);
+		gens.push_back(*m_repair_gen);
+		gens.push_back(*m_binary_gen);
+	}
+	//stored stream states at the start of the run, from which new scenarios start
+	std::vector< WELLFiveTwelve > start_gens(gens);
+	bool antithetic = m_sim_params.sampling_method == SAMPLING_ANTITHETIC;
+
+	std::vector< cycle_results > outputs(n);
+	std::vector< std::vector< failure_event > > failures(n);
+	std::vector< int > owner(n, -1);
+	std::vector< std::exception_ptr > errors(nthreads);
+	const cycle_results &start_results = m_results;
+	std::mutex commit_mutex;
+	std::condition_variable batch_done;
+	size_t next = 0;
+	size_t next_commit = 0;
+	//scenarios are started below 'limit' only, until the stopping rule is checked
+	size_t limit = std::max((size_t)1, std::min(first_batch, n));
+	bool failed = false;
+
+	auto worker = [&](int w)
+	{
+		try
+		{
+			PowerCycle &plant = plants.at(w);
+			while (true)
+			{
+				size_t k;
+				{
+					std::unique_lock<std::mutex> lock(commit_mutex);
+					while (!failed && next >= limit && next < n)
+						batch_done.wait(lock);
+					if (failed || next >= n)
+						break;
+					k = next++;
+				}
+				int s = scenarios.at(k);
+				plant = base;
+				plant.AssignGenerators(&gens.at(3 * w), &gens.at(3 * w + 1), &gens.at(3 * w + 2));
+				plant.BindComponents();
+				plant.m_current_scenario = s;
+				CopyScenarioResults(start_results, plant.m_results, s);
+				plant.SetAntitheticStreams(antithetic && s % 2 == 1);
+				if (!read_state_from_memory)
+					plant.StartScenario(s, &start_gens.at(3 * w));
+
+				plant.SingleScen(false, read_state_from_memory, init);
+
+				//Record failure events
+				plant.m_results.failure_events[s] = plant.m_failure_events;
+
+				std::lock_guard<std::mutex> lock(commit_mutex);
+				outputs.at(k) = std::move(plant.m_results);
+				failures.at(k) = std::move(plant.m_all_failures);
+				plant.m_results = cycle_results();
+				plant.m_all_failures.clear();
+				owner.at(k) = w;
+				for (; next_commit < n && owner.at(next_commit) >= 0; next_commit++)
+					CommitScenarioResults(outputs.at(next_commit), scenarios.at(next_commit), trace);
+				if (next_commit == limit && limit < n)
+				{
+					if (UpdateConfidenceIntervals())
+						n = limit;
+					else
+						limit = std::min(n, limit + batch);
+					batch_done.notify_all();
+				}
+			}
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(commit_mutex);
+			errors.at(w) = std::current_exception();
+			failed = true;
+			batch_done.notify_all();
+		}
+	};
+
+	if (nthreads == 1)
+		worker(0);
+	else
+	{
+		std::vector< std::thread > threads;
+		for (int w = 0; w < nthreads; w++)
+			threads.push_back(std::thread(worker, w));
+		for (size_t w = 0; w < threads.size(); w++)
+			threads.at(w).join();
+	}
+	for (int w = 0; w < nthreads; w++)
+	{
+		if (errors.at(w))
+			std::rethrow_exception(errors.at(w));
+	}
+
+	//adopt the final state of the last scenario
+	int wl = owner.at(n - 1);
+	WELLFiveTwelve *life_gen = m_life_gen;
+	WELLFiveTwelve *repair_gen = m_repair_gen;
+	WELLFiveTwelve *binary_gen = m_binary_gen;
+	results = std::move(m_results);
+	all_failures = std::move(m_all_failures);
+	*this = std::move(plants.at(wl));
+	m_results = std::move(results);
+	m_all_failures = std::move(all_failures);
+	*life_gen = gens.at(3 * wl);
+	*repair_gen = gens.at(3 * wl + 1);
+	*binary_gen = gens.at(3 * wl + 2);
+	AssignGenerators(life_gen, repair_gen, binary_gen);
+	SetAntitheticStreams(false);
+	BindComponents();
+
+	//merge results, RNG states and failure histories in scenario order
+	for (size_t k = 0; k < n; k++)
+	{
+		int s = scenarios.at(k);
+		int w = owner.at(k);
+		CopyScenarioResults(outputs.at(k), m_results, s);
+		m_results.instrumentation.Add(outputs.at(k).instrumentation);
+		m_results.expected_time_to_failure = outputs.at(k).expected_time_to_failure;
+		m_results.expected_starts_to_failure = outputs.at(k).expected_starts_to_failure;
+		for (int g = 0; g < 3; g++)
+		{
+			WELLFiveTwelve *gen = g == 0 ? life_gen : (g == 1 ? repair_gen : binary_gen);
+			gen->m_stored_states[3 * s + g] = gens.at(3 * w + g).m_stored_states[3 * s + g];
+			gen->m_stored_state_is[3 * s + g] = gens.at(3 * w + g).m_stored_state_is[3 * s + g];
+		}
+		m_all_failures.insert(m_all_failures.end(), failures.at(k).begin(), failures.at(k).end());
+	}
+	return n;
+}
+
+void PowerCycle::StartScenario(int s, WELLFiveTwelve *start_gens)
+{
+	/*
+	Prepares a scenario that does not resume from memory: sets the RNG 
+	engines to the start of the scenario's streams, 3s, 3s+1 and 3s+2 (for
+	the second scenario of an antithetic pair, those of the first), and 
+	draws new lifetimes for all failure types if sample_lifetimes is set.
+	s -- scenario index
+	start_gens -- life, repair and binary engines, with the stored stream 
+		states at the start of the run
+	*/
+	int first = m_sim_params.sampling_method == SAMPLING_ANTITHETIC ? s - s % 2 : s;
+	WELLFiveTwelve *gens[3] = { m_life_gen, m_repair_gen, m_binary_gen };
+	uint32_t words[16];
+	int index;
+	for (int g = 0; g < 3; g++)
+	{
+		start_gens[g].assignStates(3 * first + g);
+		start_gens[g].getState(words, index);
+		gens[g]->setState(words, index);
+	}
+	m_component_state.log_likelihood_ratio = 0.;
+	if (!m_sim_params.sample_lifetimes)
+		return;
+	int sample = -1;
+	int num_samples = m_sim_params.num_scenarios;
+	uint32_t design = 0;
+	if (m_sim_params.sampling_method == SAMPLING_LATIN_HYPERCUBE)
+	{
+		//scenarios added by the stopping rule form one sample per batch
+		sample = s;
+		if (s >= num_samples)
+		{
+			sample = (s - num_samples) % m_sim_params.scenario_batch;
+			num_samples = m_sim_params.scenario_batch;
+		}
+		//each design is keyed by the start state of the life stream of its 
+		//first scenario, so that designs differ between batches and between
+		//runs with different stored stream states
+		start_gens[0].assignStates(3 * (s - sample));
+		start_gens[0].getState(words, index);
+		design = (uint32_t)index;
+		for (int i = 0; i < 16; i++)
+		{
+			design = (design ^ words[i]) * 0x9e3779b1u;
+			design ^= design >> 15;
+		}
+	}
+	PhaseTimer state_timer(PhaseTime(m_results.instrumentation.state_time));
+	uint64_t start_variates = m_sim_params.instrument ? GetNumVariates() : 0;
+	for (size_t c = 0; c < m_components.size(); c++)
+		m_components.at(c).SampleLifesAndProbs(*m_life_gen, sample, num_samples, design);
+	if (m_sim_params.instrument)
+		m_results.instrumentation.variates_drawn += GetNumVariates() - start_variates;
+}
+
+void PowerCycle::SetAntitheticStreams(bool antithetic)
+{
+	/* sets whether the three RNG engines return complemented variates. */
+	m_life_gen->setAntithetic(antithetic);
+	m_repair_gen->setAntithetic(antithetic);
+	m_binary_gen->setAntithetic(antithetic);
+}
+
+double *PowerCycle::PhaseTime(double &total)
+{
+	/* retval -- the phase time to add to with a PhaseTimer if instrumenting, or NULL */
+	return m_sim_params.instrument ? &total : NULL;
+}
+
+uint64_t PowerCycle::GetNumVariates()
+{
+	/* retval -- number of variates drawn from the three RNG engines, for instrumentation */
+	return m_life_gen->getNumVariates() + m_repair_gen->getNumVariates() + 
+		m_binary_gen->getNumVariates();
+}
+
+void PowerCycle::ApplyImportanceSampling()
+{
+	/*
+	Sets up importance sampling of the rare failure types of all components
+	from the simulation parameters, with the length of the run as the 
+	horizon.  The scale is shared by all rare failure types, and limited so
+	that their probabilities of failing within the run sum to at most one
+	half once scaled, which keeps the likelihood ratios of the scenarios 
+	from degenerating as the number of rare failure types grows.
+	*/
+	double horizon = m_sim_params.sim_length * m_sim_params.steplength;
+	double max_prob = m_sim_params.importance_rare_prob;
+	double scale = m_sim_params.importance_scale;
+	if (!(scale >= 1.))
+		throw std::runtime_error("importance sampling scale must be at least one.");
+	double total = 0.;
+	for (size_t c = 0; c < m_components.size(); c++)
+		total += m_components.at(c).GetRareFailureProbability(horizon, max_prob);
+	if (total > 0.)
+		scale = std::max(1., std::min(scale, 0.5 / total));
+	for (size_t c = 0; c < m_components.size(); c++)
+		m_components.at(c).SetImportanceSampling(scale, horizon, max_prob);
+}
+
+void PowerCycle::EstimateAvailability(bool calibrate)
+{
+	/*
+	Approximates the expected cycle capacity and efficiency in each period
+	of the dispatch analytically, in a small fraction of the time of a 
+	Monte Carlo simulation, e.g., to screen designs.  Each component is a 
+	two-state (operational or down) Markov chain, independent of the 
+	others, over the modes, starts, ramping and planned maintenance of the
+	dispatch as the plant would follow it from its current cycle state:
+	- an operational component fails in a period if any of its failure 
+	  types does.  Lifetimes fail with the increase of the cumulative 
+	  hazard of their distribution over the wear of the period (see 
+	  FailureType::GetCumulativeHazard()), counted from new and renewed on
+	  failure; failures on start occur with the mean failure probability 
+	  times the hazard rate.  Wear, and the hazard rate with its increases
+	  on starts, resets on repair and reductions on maintenance, follow the
+	  simulation in expectation.
+	- a failed component is repaired at the rate of an exponential downtime
+	  with the mean of its repair time plus cooldown, in the modes in which
+	  it may be repaired, or in any mode if its failure alone shuts the 
+	  plant down.
+	The capacity and efficiency of a period are then the expectation, over
+	the states with up to two components down, of those the plant model 
+	itself gives (SetCycleCapacityAndEfficiency(), with the shutdown 
+	policy), so that redundant trains and pumps are accounted for; the 
+	rarer states with more components down are left out.  Components start
+	in their current state, with their current hazard rates.
+
+	If 'calibrate' is true, the expected losses of capacity and of 
+	efficiency over the run are matched to those of the last simulation 
+	(m_results.avg_cycle_capacity and avg_cycle_efficiency) by factors, 
+	which are kept and applied to later estimates, e.g., for other designs
+	or dispatches, until the next calibration.  The plant state is left 
+	unchanged.
+
+	calibrate -- calibrates against the results of the last simulation if true
+	*/
+	int num_periods = m_sim_params.sim_length;
+	double dt = m_sim_params.steplength;
+	size_t n = m_components.size();
+	availability_estimate &est = m_results.availability;
+	if (calibrate && ((int)m_results.avg_cycle_capacity.size() < num_periods ||
+		(int)m_results.avg_cycle_efficiency.size() < num_periods))
+		throw std::runtime_error("availability calibration requires simulation results of the same length.");
+
+	//the cycle state follows the dispatch, and the operational flags are 
+	//set to evaluate plant states; both are restored on return
+	cycle_state start_state = m_current_cycle_state;
+	std::vector< unsigned char > start_operational = m_component_state.operational;
+	double start_capacity = m_cycle_capacity;
+	double start_efficiency = m_cycle_efficiency;
+	m_current_cycle_state.salt_pump_switch_time = 0.;
+	m_current_cycle_state.boiler_pump_switch_time = 0.;
+	m_current_cycle_state.water_pump_switch_time = 0.;
+
+	//capacity and efficiency of the plant with no component down (state 0)
+	//or component i down (1 + i), by temperature class (below the condenser
+	//threshold or not) and whether the plant is off.  With components i and
+	//j down, they are those of i and j down each, with their changes from
+	//state 0 added, except for the pairs listed, which interact (e.g., 
+	//redundant pumps); the difference is kept for those.  Each table is 
+	//computed on first use.
+	struct pair_interaction
+	{
+		size_t i, j;
+		double cap, eff;
+	};
+	std::vector< double > state_cap[4], state_eff[4];
+	std::vector< pair_interaction > interactions[4];
+	std::vector< unsigned char > &operational = m_component_state.operational;
+	auto state_tables = [&](int k)
+	{
+		if (!state_cap[k].empty())
+			return;
+		double temp = k % 2 == 0 ? m_condenser_temp_threshold - 1. : m_condenser_temp_threshold;
+		bool off = k >= 2;
+		auto evaluate = [&](double &cap, double &eff)
+		{
+			SetCycleCapacityAndEfficiency(temp);
+			cap = m_cycle_capacity;
+			eff = m_cycle_efficiency;
+			if (cap >= DBL_EPSILON && (
+				cap < m_shutdown_capacity || eff < m_shutdown_efficiency || (off && (
+					cap < m_no_restart_capacity || eff < m_no_restart_efficiency)
+				)))
+			{
+				cap = 0.;
+				eff = 0.;
+			}
+		};
+		std::vector< double > &sc = state_cap[k];
+		std::vector< double > &se = state_eff[k];
+		sc.resize(1 + n);
+		se.resize(1 + n);
+		std::fill(operational.begin(), operational.end(), 1);
+		evaluate(sc[0], se[0]);
+		for (size_t i = 0; i < n; i++)
+		{
+			operational[i] = 0;
+			evaluate(sc[1 + i], se[1 + i]);
+			operational[i] = 1;
+		}
+		for (size_t i = 0; i < n; i++)
+		{
+			operational[i] = 0;
+			for (size_t j = i + 1; j < n; j++)
+			{
+				pair_interaction pair;
+				operational[j] = 0;
+				evaluate(pair.cap, pair.eff);
+				operational[j] = 1;
+				pair.i = i;
+				pair.j = j;
+				pair.cap -= sc[1 + i] + sc[1 + j] - sc[0];
+				pair.eff -= se[1 + i] + se[1 + j] - se[0];
+				if (pair.cap != 0. || pair.eff != 0.)
+					interactions[k].push_back(pair);
+			}
+			operational[i] = 1;
+		}
+	};
+
+	//failure types, flattened as in the component state arrays
+	const ComponentStateArrays &cs = m_component_state;
+	std::vector< FailureType > types;
+	std::vector< double > mean_prob;
+	for (size_t i = 0; i < n; i++)
+	{
+		std::vector< FailureType > ft = m_components.at(i).GetFailureTypes();
+		for (size_t j = 0; j < ft.size(); j++)
+		{
+			types.push_back(ft.at(j));
+			mean_prob.push_back(ft.at(j).GetFailureDist()->IsBinary() ? 
+				ft.at(j).GetMeanFailureProbability() : -1.);
+		}
+	}
+	std::vector< double > wear(types.size(), 0.);
+	std::vector< double > hazard_at_wear(types.size(), 0.);
+
+	//the cumulative hazard is nondecreasing in wear, and for many lifetime
+	//distributions (e.g., inverse gamma) exactly zero up to some wear, 
+	//which is found once to skip evaluating it there.  Exponential lifetimes
+	//have a constant hazard rate, and need no wear.
+	std::vector< double > zero_hazard_wear(types.size(), 0.);
+	std::vector< double > constant_rate(types.size(), 0.);
+	for (size_t j = 0; j < types.size(); j++)
+	{
+		if (mean_prob[j] >= 0.)
+			continue;
+		Distribution *dist = types[j].GetFailureDist();
+		if (dist->GetType() == "gamma" && dist->GetAlpha() == 1.)
+		{
+			constant_rate[j] = 1. / dist->GetBeta();
+			continue;
+		}
+		if (types[j].GetCumulativeHazard(1.) > 0.)
+			continue;
+		double lo = 1., hi = 2.;
+		while (hi < 1.e12 && types[j].GetCumulativeHazard(hi) == 0.)
+		{
+			lo = hi;
+			hi *= 2.;
+		}
+		for (int it = 0; it < 30; it++)
+		{
+			double mid = 0.5 * (lo + hi);
+			if (types[j].GetCumulativeHazard(mid) == 0.)
+				lo = mid;
+			else
+				hi = mid;
+		}
+		zero_hazard_wear[j] = lo;
+	}
+	auto cumulative_hazard = [&](size_t j, double life)
+	{
+		return life <= zero_hazard_wear[j] ? 0. : types[j].GetCumulativeHazard(life);
+	};
+
+	//chains: probability that each component is operational, and its 
+	//expected hazard rate while operational
+	std::vector< double > up(n), hazard(n), repair_prob(n), up_after(n), odds(n);
+	std::vector< bool > reset_hazard(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		reset_hazard[i] = m_components.at(i).GetResetHazardRatePolicy();
+		up[i] = cs.operational[i] ? 1. : 0.;
+		hazard[i] = cs.hazard_rate[i];
+		double downtime = m_components.at(i).GetMeanRepairTime() + m_components.at(i).GetCooldownTime();
+		repair_prob[i] = downtime > 0. ? 1. - std::exp(-dt / downtime) : 1.;
+	}
+
+	const std::vector< double > &ambient_temperature = m_dispatch.at("ambient_temperature");
+	const std::vector< double > &cycle_power = m_dispatch.at("cycle_power");
+	const std::vector< double > &thermal_power = m_dispatch.at("thermal_power");
+	std::vector< double > raw_cap(num_periods), raw_eff(num_periods);
+	int maintenance_left = 0;
+	for (int t = 0; t < num_periods; t++)
+	{
+		double temp = ambient_temperature.at(t);
+		double power_out = cycle_power.at(t);
+		double thermal_out = thermal_power.at(t);
+		if (maintenance_left == 0 && m_current_cycle_state.hours_to_maintenance <= 0)
+		{
+			//planned maintenance: all components are down for its duration
+			maintenance_left = std::max(1, (int)std::ceil(m_current_cycle_state.maintenance_duration / dt));
+			m_current_cycle_state.hours_to_maintenance = m_current_cycle_state.maintenance_interval;
+			double reduction = m_begin_cycle_state.hot_start_penalty * m_sim_params.num_annual_starts;
+			for (size_t i = 0; i < n; i++)
+				hazard[i] = std::max(1., hazard[i] - reduction);
+		}
+		start_mode start = GetStartModeEnum(t);
+		operating_mode mode = GetOperatingModeEnum(t);
+		if (maintenance_left > 0)
+		{
+			raw_cap[t] = 0.;
+			raw_eff[t] = 0.;
+			mode = MODE_OFF;
+			power_out = 0.;
+			if (--maintenance_left == 0)
+				std::fill(up.begin(), up.end(), 1.);
+		}
+		else
+		{
+			double ramp_mult = GetRampMult(thermal_out);
+			double hazard_increase = 0.;
+			if (start == START_HOT)
+				hazard_increase = m_current_cycle_state.hot_start_penalty;
+			else if (start == START_WARM)
+				hazard_increase = m_current_cycle_state.warm_start_penalty;
+			else if (start == START_COLD)
+				hazard_increase = m_current_cycle_state.cold_start_penalty;
+			int k = (temp < m_condenser_temp_threshold ? 0 : 1) + (mode == MODE_OFF ? 2 : 0);
+			state_tables(k);
+			operating_mode opmode = mode == MODE_OS ? MODE_OF : (mode == MODE_SS ? MODE_SF : mode);
+
+			for (size_t i = 0; i < n; i++)
+			{
+				//failures, tested as in TestForComponentFailures()
+				double survive = 1.;
+				double constant_hazard = 0.;
+				if (mode != MODE_OFF)
+				{
+					for (size_t j = cs.life_offset[i]; j < cs.life_offset[i + 1]; j++)
+					{
+						operating_mode fmode = cs.fail_mode[j];
+						if (mean_prob[j] >= 0.)
+						{
+							if (fmode == mode)
+								survive *= 1. - std::min(1., mean_prob[j] * hazard[i]);
+							continue;
+						}
+						if (fmode != opmode && fmode != MODE_ALL && 
+							!(fmode == MODE_O && (opmode == MODE_OO || opmode == MODE_OF)))
+							continue;
+						double tested = dt * (hazard[i] + 100. * hazard_increase) * ramp_mult;
+						if (constant_rate[j] > 0.)
+						{
+							constant_hazard += tested * constant_rate[j];
+							continue;
+						}
+						double q = 1. - std::exp(hazard_at_wear[j] - cumulative_hazard(j, wear[j] + tested));
+						if (!(q >= 0.))
+							q = 1.;
+						survive *= 1. - q;
+						//lifetimes renew on failure
+						wear[j] = (wear[j] + dt * (hazard[i] + hazard_increase) * ramp_mult) * (1. - up[i] * q);
+						hazard_at_wear[j] = cumulative_hazard(j, wear[j]);
+					}
+					survive *= std::exp(-constant_hazard);
+					if (reset_hazard[i])
+						hazard[i] = survive * hazard[i] + (1. - survive);
+					hazard[i] += hazard_increase;
+				}
+				up_after[i] = up[i] * survive;
+				//repairs, in this period's mode or during a shutdown
+				if (cs.CanBeRepaired((int)i, mode) || state_cap[k][1 + i] < DBL_EPSILON)
+					up[i] = up_after[i] + (1. - up_after[i]) * repair_prob[i];
+				else
+					up[i] = up_after[i];
+			}
+
+			//expectation over the states with up to two components down, as 
+			//odds relative to all components up
+			double sum_odds = 0., sum_odds_sq = 0.;
+			for (size_t i = 0; i < n; i++)
+			{
+				odds[i] = (1. - up_after[i]) / std::max(up_after[i], 1.e-12);
+				sum_odds += odds[i];
+				sum_odds_sq += odds[i] * odds[i];
+			}
+			const std::vector< double > &sc = state_cap[k];
+			const std::vector< double > &se = state_eff[k];
+			double pairs = 0.5 * (sum_odds * sum_odds - sum_odds_sq);
+			double total = 1. + sum_odds + pairs;
+			double cap = sc[0] * total;
+			double eff = se[0] * total;
+			for (size_t i = 0; i < n; i++)
+			{
+				if (odds[i] == 0.)
+					continue;
+				//alone, and with each other component down
+				double w = odds[i] * (1. + sum_odds - odds[i]);
+				cap += w * (sc[1 + i] - sc[0]);
+				eff += w * (se[1 + i] - se[0]);
+			}
+			const std::vector< pair_interaction > &ki = interactions[k];
+			for (size_t m = 0; m < ki.size(); m++)
+			{
+				double w = odds[ki[m].i] * odds[ki[m].j];
+				cap += w * ki[m].cap;
+				eff += w * ki[m].eff;
+			}
+			raw_cap[t] = cap / total;
+			raw_eff[t] = eff / total;
+		}
+
+		//cycle state, as updated by OperatePlant()
+		m_current_cycle_state.thermal_output = thermal_out;
+		m_current_cycle_state.power_output = power_out;
+		if (mode == MODE_OFF)
+		{
+			m_current_cycle_state.is_online = false;
+			m_current_cycle_state.is_on_standby = false;
+			m_current_cycle_state.downtime += dt;
+			m_current_cycle_state.time_in_standby = 0.;
+			m_current_cycle_state.time_online = 0.;
+		}
+		else if (mode == MODE_SS || mode == MODE_SF || mode == MODE_SO)
+		{
+			m_current_cycle_state.is_online = false;
+			m_current_cycle_state.is_on_standby = true;
+			m_current_cycle_state.downtime = 0.;
+			m_current_cycle_state.time_online = 0.;
+			m_current_cycle_state.time_in_standby = mode == MODE_SS ? dt : 
+				m_current_cycle_state.time_in_standby + dt;
+		}
+		else
+		{
+			m_current_cycle_state.is_online = true;
+			m_current_cycle_state.is_on_standby = false;
+			m_current_cycle_state.downtime = 0.;
+			m_current_cycle_state.time_in_standby = 0.;
+			m_current_cycle_state.time_online = mode == MODE_OS ? dt :
+				m_current_cycle_state.time_online + dt;
+			m_current_cycle_state.hours_to_maintenance -= dt;
+		}
+	}
+	m_current_cycle_state = start_state;
+	m_component_state.operational = start_operational;
+	m_cycle_capacity = start_capacity;
+	m_cycle_efficiency = start_efficiency;
+
+	if (calibrate)
+	{
+		double sim_cap_loss = 0., sim_eff_loss = 0., cap_loss = 0., eff_loss = 0.;
+		for (int t = 0; t < num_periods; t++)
+		{
+			sim_cap_loss += 1. - m_results.avg_cycle_capacity.at(t);
+			sim_eff_loss += 1. - m_results.avg_cycle_efficiency.at(t);
+			cap_loss += 1. - raw_cap[t];
+			eff_loss += 1. - raw_eff[t];
+		}
+		est.capacity_calibration = cap_loss > 0. ? sim_cap_loss / cap_loss : 1.;
+		est.efficiency_calibration = eff_loss > 0. ? sim_eff_loss / eff_loss : 1.;
+	}
+	est.cycle_capacity.resize(num_periods);
+	est.cycle_efficiency.resize(num_periods);
+	est.avg_cycle_capacity = 0.;
+	est.avg_cycle_efficiency = 0.;
+	for (int t = 0; t < num_periods; t++)
+	{
+		est.cycle_capacity[t] = std::min(1., std::max(0., 1. - est.capacity_calibration * (1. - raw_cap[t])));
+		est.cycle_efficiency[t] = std::min(1., std::max(0., 1. - est.efficiency_calibration * (1. - raw_eff[t])));
+		est.avg_cycle_capacity += est.cycle_capacity[t] / num_periods;
+		est.avg_cycle_efficiency += est.cycle_efficiency[t] / num_periods;
+	}
+}
+
 void PowerCycle::ResetPlant()
 {
 	/* 
@@ -3194,6 +4842,7 @@ void PowerCycle::ResetPlant()
 	m_current_cycle_state.time_in_standby = 0.;
 	m_current_cycle_state.power_output = 0.;
 	m_current_cycle_state.hours_to_maintenance = m_current_cycle_state.maintenance_interval;
+	m_component_state.log_likelihood_ratio = 0.;
 	for (size_t c = 0; c < GetComponents().size(); c++)
 	{
 		GetComponents().at(c).Reset(*m_life_gen);
@@ -3225,10 +4874,9 @@ void PowerCycle::PrintComponentStatus()
 
 void PowerCycle::ClearFailureEvents()
 {
-	for (std::string f : m_failure_event_labels)
-		m_all_failures.push_back(m_failure_events[f]);
-	m_failure_events.clear();
-	m_failure_event_labels.clear();
+	for (size_t i = 0; i < m_failure_events.Size(); i++)
+		m_all_failures.push_back(m_failure_events.At(i));
+	m_failure_events.Clear();
 	m_results.period_of_last_failure[m_current_scenario] = -1;
 	m_results.period_of_last_repair[m_current_scenario] = -1;
 }
@@ -3339,7 +4987,7 @@ void PowerCycle::AgePlant(double age)
 	if (m > DBL_EPSILON)
 	{
 		m_sim_params.steplength = 2 * m;
-		AdvanceDowntime("OFF");
+		AdvanceDowntime(MODE_OFF);
 	}
 
 	//reset steplength and downtime thresholds
@@ -4,12 +4,15 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <memory>
 
 #include "component.h"
+#include "modes.h"
 #include "well512.h"
 #include "distributions.h"
 #include "plant_struct.h"
 #include "lib_util.h"
+#include "async_writer.h"
 
 
 class PowerCycle
@@ -21,6 +24,7 @@ class PowerCycle
 
 	//Components
 	std::vector< Component > m_components;
+	ComponentStateArrays m_component_state;   //packed state, by component index
 	std::vector< size_t > m_turbine_idx;  //turbine indices 
  	std::vector< size_t > m_sst_idx;   //salt-to-steam train indices 
 	std::vector< size_t > m_condenser_idx; //condenser train indices 
@@ -50,11 +54,16 @@ class PowerCycle
 	std::unordered_map<std::string, std::vector<double> > m_dispatch;
 
 	//Failure Events
-	std::unordered_map< std::string, failure_event >  m_failure_events;
-	std::vector <std::string>  m_failure_event_labels;
+	FailureEventStore m_failure_events;
 	std::vector <failure_event> m_all_failures;
 
-	std::unordered_map< std::string, ComponentStatus > m_start_component_status;
+	//Output files, written in the background; shared by copies of the plant
+	std::shared_ptr< AsyncFileWriter > m_file_writer;
+
+	std::vector< double > m_start_component_values;   //component state at the start of the run
+	std::vector< unsigned char > m_start_component_flags;
+	std::vector< size_t > m_steady_lives;   //failure types worn in a steady run (see RunSteadyPeriods)
+	std::vector< size_t > m_steady_owners;  //component of each entry of m_steady_lives
 
 	//ramping parameters
 	double m_ramp_threshold;   //these are calculated with capacity as input
@@ -82,6 +91,47 @@ class PowerCycle
 	bool m_new_failure_occurred;
 	bool m_new_repair_occurred;
 
+	//Component registry and state arrays
+	void BindComponents();
+	void RegisterComponent();
+	int GetComponentIndex(std::string name);
+	uint64_t GetFailureEventKey(const failure_event &e);
+
+	//Capacity of the component groups
+	double CountOperational(const std::vector<size_t> &idx);
+	double PumpCapacity(double num_pumps_operational, double switch_time, int num_pumps_required);
+	double CondenserCapacity(int num_streams, double temp);
+
+	//Dispatch runs: steady periods and checkpoints within a run
+	int RunSteadyPeriods(int t, std::vector<double> &cycle_capacities, 
+		std::vector<double> &cycle_efficiencies);
+	void RestorePlantState(const cycle_checkpoint &cp);
+	uint64_t HashDispatch(int t0, int t1, uint64_t h);
+	void RecordRunCheckpoint(int t, int period_of_last_failure, int period_of_last_repair);
+	int ResumeFromRunCheckpoint(std::vector<double> &cycle_capacities, 
+		std::vector<double> &cycle_efficiencies);
+
+	//Multi-scenario runner
+	size_t RunScenarios(
+		const std::vector<int> &scenarios, 
+		bool read_state_from_memory, 
+		bool init,
+		ScenarioTraceFile &trace,
+		size_t first_batch,
+		size_t batch
+	);
+	void CommitScenarioResults(cycle_results &results, int s, ScenarioTraceFile &trace);
+	void AddScenarioEstimates(const std::vector<double> &cap, 
+		const std::vector<double> &eff, double labor_cost, double weight, int s);
+	bool UpdateConfidenceIntervals();
+	void StartScenario(int s, WELLFiveTwelve *start_gens);
+	void SetAntitheticStreams(bool antithetic);
+	void ApplyImportanceSampling();
+
+	//Instrumentation
+	double *PhaseTime(double &total);
+	uint64_t GetNumVariates();
+
 public:
 	PowerCycle();
 	void Initialize(double age = 0., int scen_idx = 0);
@@ -116,16 +166,18 @@ public:
 	void ClearComponents();
 	void ReadComponentStatus(
 		std::unordered_map< std::string, ComponentStatus > dstat);
-	void ClearComponentStatus();
 	void ReadCycleStateFromResults();
-	void SetStartComponentStatus();
 	void StoreComponentState();
 	void StorePlantParamsState();
 	void StoreCycleState();
 	void RecordFinalState();
 	void RevertToStartState(bool reset_rng);
+	void SaveCheckpoint(cycle_checkpoint &cp, int t = 0);
+	void RestoreCheckpoint(const cycle_checkpoint &cp);
 
 	void WriteStateToFiles();
+	void WriteStateTextFiles();
+	void WriteStateBundle();
 	void WritePlantLayoutFile();
 	void WriteComponentFile();
 	void WritePlantStateFile();
@@ -136,8 +188,10 @@ public:
 	void WriteCapEffFile();
 	void WriteFinalEffFile();
 	void WriteFailureStats();
+	void FlushOutputFiles();
 
 	void ReadStateFromFiles(bool init);
+	void ReadStateBundle();
 	void ReadPlantLayoutFile();
 	void ReadComponentFile();
 	void ReadPlantFile();
@@ -271,6 +325,12 @@ public:
 		std::string start, 
 		std::string mode
 	);
+	void TestForComponentFailures(
+		double ramp_mult, 
+		int t, 
+		start_mode start, 
+		operating_mode mode
+	);
 	bool AllComponentsOperational();
 	double GetMaxComponentDowntime();
 	void PlantMaintenanceShutdown(
@@ -287,6 +347,7 @@ public:
 		double switch_time = 0.0
 	);
 	void AdvanceDowntime(std::string mode);
+	void AdvanceDowntime(operating_mode mode);
 	double GetRampMult(double power_out);
 	void OperateComponents(
 		double ramp_mult, 
@@ -295,19 +356,30 @@ public:
 		std::string mode,
 		double duration = 1.0
 	);
+	void OperateComponents(
+		double ramp_mult, 
+		int t, 
+		start_mode start, 
+		operating_mode mode,
+		double duration = 1.0
+	);
 	void ResetHazardRates();
 	std::unordered_map<std::string, ComponentStatus> GetComponentStates();
 	std::string GetStartMode(int t);
 	std::string GetOperatingMode(int t);
+	start_mode GetStartModeEnum(int t);
+	operating_mode GetOperatingModeEnum(int t);
 	void ReadInComponentFailures(int t);
 	void ReadInMaintenanceEvents(int t);
 	int FirstPeriodOfDifference(
 		std::vector<double> cycle_efficiencies,
 		std::vector<double> cycle_capacities
 	);
-	void RunDispatch();
+	void RunDispatch(bool resume = false);
 	void OperatePlant(double power_out, double thermal_out, int t, 
 		std::string start, std::string mode);
+	void OperatePlant(double power_out, double thermal_out, int t, 
+		start_mode start, operating_mode mode);
 	void SingleScen(bool reset_plant, bool read_state_from_file = false,
 		bool init = false);
 	void GetSummaryResults();
@@ -320,6 +392,7 @@ public:
 		bool run_only_previous_failures = false,
 		bool init = false
 	);
+	void EstimateAvailability(bool calibrate = false);
 	void ResetPlant();
 	void PrintComponentStatus();
 	void ClearFailureEvents();
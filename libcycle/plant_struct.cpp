@@ -2,6 +2,7 @@
 #include <string>
 #include <unordered_map>
 #include <iostream>
+#include <limits>
 
 #include "plant_struct.h"
 
@@ -21,6 +22,9 @@ cycle_file_settings::cycle_file_settings()
 	failure_file = "./failures";
 	num_failures_file = "./num_failures";
 	cap_eff_filename = "./capeff";
+	trace_filename = "";
+	state_bundle_filename = "./cycle_state";
+	use_state_bundle = false;
 	output_ampl_file = false;
 	output_to_files = false;
 	day_idx = 0;
@@ -83,6 +87,20 @@ simulation_params::simulation_params()
 	stop_at_first_repair = false;
 	stop_at_first_failure = false;
 	num_annual_starts = 50;
+	num_threads = 1;
+	skip_steady_periods = true;
+	checkpoint_interval = 24;
+	retain_scenario_results = true;
+	result_quantiles = { 0.05, 0.5, 0.95 };
+	sampling_method = SAMPLING_INDEPENDENT;
+	sample_lifetimes = false;
+	importance_scale = 1.;
+	importance_rare_prob = 0.05;
+	ci_target = 0.;
+	max_scenarios = 1000;
+	scenario_batch = 10;
+	ci_level = 0.95;
+	instrument = false;
 }
 
 void simulation_params::print()
@@ -95,7 +113,110 @@ void simulation_params::print()
 		<< "hourly_labor_cost: " << hourly_labor_cost << "\n"
 		<< "stop_at_first_repair: " << stop_at_first_repair << "\n"
 		<< "stop_at_first_failure: " << stop_at_first_failure << "\n"
-		<< "num_annual_starts: " << num_annual_starts << "\n";
+		<< "num_annual_starts: " << num_annual_starts << "\n"
+		<< "num_threads: " << num_threads << "\n"
+		<< "skip_steady_periods: " << skip_steady_periods << "\n"
+		<< "checkpoint_interval: " << checkpoint_interval << "\n"
+		<< "retain_scenario_results: " << retain_scenario_results << "\n"
+		<< "sampling_method: " << sampling_method << "\n"
+		<< "sample_lifetimes: " << sample_lifetimes << "\n"
+		<< "importance_scale: " << importance_scale << "\n"
+		<< "importance_rare_prob: " << importance_rare_prob << "\n"
+		<< "ci_target: " << ci_target << "\n"
+		<< "max_scenarios: " << max_scenarios << "\n"
+		<< "scenario_batch: " << scenario_batch << "\n"
+		<< "ci_level: " << ci_level << "\n"
+		<< "instrument: " << instrument << "\n";
+}
+
+cycle_checkpoint::cycle_checkpoint()
+{
+	scenario = 0;
+	period = 0;
+	cycle_capacity = 1.;
+	cycle_efficiency = 1.;
+	new_failure_occurred = false;
+	new_repair_occurred = false;
+	for (int g = 0; g < 3; g++)
+	{
+		for (int i = 0; i < 16; i++)
+			rng_states[g][i] = 0;
+		rng_state_is[g] = 0;
+	}
+	num_failure_events = 0;
+}
+
+cycle_run_checkpoint::cycle_run_checkpoint()
+{
+	period_of_last_failure = -1;
+	period_of_last_repair = -1;
+	dispatch_hash = 0;
+}
+
+confidence_interval::confidence_interval()
+{
+	mean = 0.;
+	half_width = std::numeric_limits<double>::infinity();
+}
+
+cycle_instrumentation::cycle_instrumentation()
+{
+	Reset();
+}
+
+void cycle_instrumentation::Reset()
+{
+	failures_tested = 0;
+	variates_drawn = 0;
+	maintenance_shutdowns = 0;
+	unplanned_shutdowns = 0;
+	pump_switches = 0;
+	checkpoint_restores = 0;
+	periods_read_in = 0;
+	periods_skipped = 0;
+	read_in_time = 0.;
+	steady_time = 0.;
+	failure_test_time = 0.;
+	maintenance_time = 0.;
+	operate_time = 0.;
+	dispatch_time = 0.;
+	state_time = 0.;
+	output_time = 0.;
+	scenario_time = 0.;
+	simulate_time = 0.;
+}
+
+void cycle_instrumentation::Add(const cycle_instrumentation &other)
+{
+	/* adds the counts and times of another run, e.g., a scenario run by a worker thread. */
+	failures_tested += other.failures_tested;
+	variates_drawn += other.variates_drawn;
+	maintenance_shutdowns += other.maintenance_shutdowns;
+	unplanned_shutdowns += other.unplanned_shutdowns;
+	pump_switches += other.pump_switches;
+	checkpoint_restores += other.checkpoint_restores;
+	periods_read_in += other.periods_read_in;
+	periods_skipped += other.periods_skipped;
+	read_in_time += other.read_in_time;
+	steady_time += other.steady_time;
+	failure_test_time += other.failure_test_time;
+	maintenance_time += other.maintenance_time;
+	operate_time += other.operate_time;
+	dispatch_time += other.dispatch_time;
+	state_time += other.state_time;
+	output_time += other.output_time;
+	scenario_time += other.scenario_time;
+	simulate_time += other.simulate_time;
+}
+
+availability_estimate::availability_estimate()
+{
+	cycle_capacity = {};
+	cycle_efficiency = {};
+	avg_cycle_capacity = 1.;
+	avg_cycle_efficiency = 1.;
+	capacity_calibration = 1.;
+	efficiency_calibration = 1.;
 }
 
 cycle_results::cycle_results()
@@ -103,12 +224,14 @@ cycle_results::cycle_results()
 	cycle_capacity = {};
 	cycle_efficiency = {};
 	labor_costs = {};
+	scenario_weights = {};
 	avg_cycle_capacity = {};
 	avg_cycle_efficiency = {};
 	avg_labor_cost = 0.;
-	component_status = {};
-	plant_status = {};
-	failure_event_labels = {};
+	scenarios_run = 0;
+	ci_target_met = false;
+	final_state = {};
+	run_checkpoints = {};
 	failure_events = {};
 	period_of_last_failure = {};
 	period_of_last_repair = {};
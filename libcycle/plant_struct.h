@@ -4,8 +4,10 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <chrono>
 
 #include "component.h"
+#include "result_sink.h"
 
 struct cycle_file_settings
 {
@@ -23,6 +25,9 @@ struct cycle_file_settings
 	std::string failure_file;
 	std::string num_failures_file;
 	std::string cap_eff_filename;
+	std::string trace_filename; //binary capacity/efficiency traces by scenario (ScenarioTraceFile); none if empty
+	std::string state_bundle_filename; //binary plant state bundle (StateBundle)
+	bool use_state_bundle; //true if the plant state is written to and read from the bundle instead of the text files
 	bool output_ampl_file;
 	bool output_to_files;
 	int day_idx;
@@ -57,6 +62,57 @@ struct cycle_state
 	void print();
 };
 
+/*
+Snapshot of the simulation state of a plant in one scenario: the cycle state,
+the state of all components as flat arrays (see ComponentStateArrays::SaveState), 
+the positions of the three RNG streams, and the number of failure events 
+recorded so far.  Taken and restored by PowerCycle::SaveCheckpoint and 
+PowerCycle::RestoreCheckpoint with array copies only; the arrays are reused 
+when a checkpoint object is overwritten.
+*/
+struct cycle_checkpoint
+{
+	int scenario;
+	int period;   //first period to simulate after restoring
+	cycle_state plant_state;
+	double cycle_capacity;
+	double cycle_efficiency;
+	bool new_failure_occurred;
+	bool new_repair_occurred;
+	std::vector< double > component_values;
+	std::vector< unsigned char > component_flags;
+	uint32_t rng_states[3][16];   //life, repair and binary generators
+	int rng_state_is[3];
+	size_t num_failure_events;
+	cycle_checkpoint();
+};
+
+/*
+Checkpoint taken during a run in its read-in stage, before any failure event
+or random draw of the run.  A later run of the same scenario that starts from
+the same state, with the same read-only periods and the same dispatch up to 
+the checkpoint, reaches the checkpoint in the same state, so it may resume 
+from there (see PowerCycle::ResumeFromRunCheckpoint).
+*/
+struct cycle_run_checkpoint
+{
+	cycle_checkpoint state;
+	int period_of_last_failure;   //read-only stage of the run that took it
+	int period_of_last_repair;
+	uint64_t dispatch_hash;   //hash of the dispatch in periods before state.period
+	cycle_run_checkpoint();
+};
+
+/*
+How the random variates of the scenarios of a run are drawn; see 
+PowerCycle::Simulate().
+*/
+enum scenario_sampling {
+	SAMPLING_INDEPENDENT,		//each scenario draws from its own streams
+	SAMPLING_ANTITHETIC,		//scenarios 2k and 2k+1 draw complementary variates
+	SAMPLING_LATIN_HYPERCUBE	//sampled lifetimes form a Latin hypercube over the scenarios
+};
+
 struct simulation_params
 {
 	int read_periods;
@@ -68,22 +124,131 @@ struct simulation_params
 	bool stop_at_first_repair;
 	bool stop_at_first_failure;
 	int num_annual_starts; //assumed only hot starts
+	int num_threads; //number of worker threads used to run scenarios
+	bool skip_steady_periods; //true if runs of steady periods bypass the full period update
+	int checkpoint_interval; //periods between checkpoints that later runs from memory may resume from; 0 to disable
+	bool retain_scenario_results; //true if the capacity and efficiency series of every scenario are kept in the results
+	std::vector<double> result_quantiles; //quantile levels estimated by period over scenarios
+	int sampling_method; //scenario_sampling
+	bool sample_lifetimes; //true if each scenario draws new lifetimes for all failure types at its start
+	double importance_scale; //factor by which importance sampling raises the probability of rare failures within the run; 1 to disable
+	double importance_rare_prob; //probability of failing within the run up to which a failure type is rare
+	double ci_target; //relative half-width of the confidence intervals at which scenarios stop being added; 0 to run num_scenarios only
+	int max_scenarios; //maximum number of scenarios run when ci_target is set
+	int scenario_batch; //number of scenarios added at a time when ci_target is set
+	double ci_level; //confidence level of the intervals in the results
+	bool instrument; //true if event counts and phase times are kept in the results
 	simulation_params();
 	void print();
 };
 
+struct confidence_interval
+{
+	double mean;
+	double half_width; //infinite if fewer than two independent scenarios (or antithetic pairs) were run
+	confidence_interval();
+};
+
+/*
+Expected cycle capacity and efficiency by period from the analytical 
+approximation of PowerCycle::EstimateAvailability(), without Monte Carlo.
+*/
+struct availability_estimate
+{
+	std::vector < double > cycle_capacity;
+	std::vector < double > cycle_efficiency;
+	double avg_cycle_capacity;
+	double avg_cycle_efficiency;
+	double capacity_calibration;   //factor applied to the expected loss of capacity; 1 until calibrated
+	double efficiency_calibration; //factor applied to the expected loss of efficiency; 1 until calibrated
+	availability_estimate();
+};
+
+/*
+Event counts and wall times (s) of the phases of the scenarios of a 
+simulation, kept when simulation_params::instrument is set.  Phase times 
+are summed over scenarios, and so over worker threads; simulate_time is 
+the wall time of the call to Simulate().  The phases of RunDispatch are 
+disjoint: read-in periods (replaying the events of an earlier run, 
+including restoring a checkpoint) count towards read_in_time only, and 
+failure_test_time, maintenance_time and operate_time cover the other 
+periods.
+*/
+struct cycle_instrumentation
+{
+	size_t failures_tested;        //failure types of operational components tested
+	size_t variates_drawn;         //uniform variates drawn from the three RNG streams
+	size_t maintenance_shutdowns;  //planned maintenance shutdowns
+	size_t unplanned_shutdowns;    //shutdowns for repairs under the shutdown policy
+	size_t pump_switches;          //new pump switching events
+	size_t checkpoint_restores;    //runs resumed from a checkpoint of an earlier run
+	size_t periods_read_in;        //periods replaying the events of an earlier run
+	size_t periods_skipped;        //steady periods bypassing the full period update
+	double read_in_time;
+	double steady_time;
+	double failure_test_time;
+	double maintenance_time;
+	double operate_time;
+	double dispatch_time;          //RunDispatch() in all
+	double state_time;             //reading, storing and reverting plant states
+	double output_time;            //writing output files
+	double scenario_time;          //SingleScen() in all
+	double simulate_time;
+	cycle_instrumentation();
+	void Reset();
+	void Add(const cycle_instrumentation &other);
+};
+
+/*
+Adds the wall time of its scope to a phase time of cycle_instrumentation, 
+or does nothing if given NULL, so timers cost one test when instrumentation
+is off.
+*/
+class PhaseTimer
+{
+	double *m_total;
+	std::chrono::steady_clock::time_point m_start;
+
+	PhaseTimer(const PhaseTimer &);
+	PhaseTimer &operator=(const PhaseTimer &);
+
+public:
+	PhaseTimer(double *total) : m_total(total)
+	{
+		if (m_total != NULL)
+			m_start = std::chrono::steady_clock::now();
+	}
+	~PhaseTimer()
+	{
+		if (m_total != NULL)
+			*m_total += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+	}
+};
+
 struct cycle_results
 {
 	std::unordered_map < int, std::vector < double > > cycle_capacity;
 	std::unordered_map < int, std::vector < double > > cycle_efficiency;
 	std::unordered_map < int, double  > labor_costs;
+	std::unordered_map < int, double > scenario_weights; //likelihood ratios of the scenarios under importance sampling; 1 otherwise
 	std::vector < double > avg_cycle_capacity;
 	std::vector < double > avg_cycle_efficiency;
 	double avg_labor_cost;
-	std::unordered_map<int, std::unordered_map< std::string, ComponentStatus > > component_status;
-	std::unordered_map<int, cycle_state >  plant_status;
-	std::unordered_map < int, std::vector < std::string > > failure_event_labels;
-	std::unordered_map < int, std::unordered_map < std::string, failure_event > > failure_events;
+	PeriodStatistics capacity_statistics;
+	PeriodStatistics efficiency_statistics;
+	MeanEstimate capacity_estimate;   //running mean over scenarios of the mean cycle capacity of each scenario
+	MeanEstimate efficiency_estimate; //running mean over scenarios of the mean cycle efficiency of each scenario
+	MeanEstimate labor_cost_estimate; //running mean over scenarios of the labor cost of each scenario
+	confidence_interval capacity_ci;
+	confidence_interval efficiency_ci;
+	confidence_interval labor_cost_ci;
+	int scenarios_run;
+	bool ci_target_met;
+	availability_estimate availability;
+	cycle_instrumentation instrumentation;
+	std::unordered_map<int, cycle_checkpoint > final_state;
+	std::unordered_map<int, std::vector< cycle_run_checkpoint > > run_checkpoints;
+	std::unordered_map < int, FailureEventStore > failure_events;
 	std::unordered_map <int, int> period_of_last_failure;
 	std::unordered_map <int, int> period_of_last_repair;
 	std::unordered_map <int, double> turbine_efficiency;
@@ -0,0 +1,455 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <stdexcept>
+
+#include "result_sink.h"
+
+//##################################################################################
+
+PeriodStatistics::PeriodStatistics()
+{
+	m_num_periods = 0;
+	m_count = 0;
+	m_weight = 0.;
+}
+
+void PeriodStatistics::Reset(int num_periods, const std::vector<double> &quantiles)
+{
+	/*
+	Clears all statistics.
+	num_periods -- length of the series to be added
+	quantiles -- quantile levels to estimate, each in [0, 1]
+	*/
+	for (size_t k = 0; k < quantiles.size(); k++)
+	{
+		if (!(quantiles.at(k) >= 0. && quantiles.at(k) <= 1.))
+			throw std::runtime_error("quantile levels must be between 0 and 1.");
+	}
+	m_num_periods = std::max(0, num_periods);
+	m_count = 0;
+	m_weight = 0.;
+	m_levels = quantiles;
+	size_t n = (size_t)m_num_periods;
+	m_sum.assign(n, 0.);
+	m_mean.assign(n, 0.);
+	m_m2.assign(n, 0.);
+	m_min.assign(n, 0.);
+	m_max.assign(n, 0.);
+	m_heights.assign(m_levels.size() * n * 5, 0.);
+	m_positions.assign(m_levels.size() * n * 5, 0);
+}
+
+void PeriodStatistics::Add(const std::vector<double> &x, double weight)
+{
+	/*
+	Adds the series of one scenario.
+	x -- value in each period
+	weight -- weight of the series, nonnegative
+	*/
+	if ((int)x.size() != m_num_periods)
+		throw std::runtime_error("series length does not match the statistics.");
+	if (!(weight >= 0.))
+		throw std::runtime_error("series weights must be nonnegative.");
+	m_weight += weight;
+	for (int t = 0; t < m_num_periods; t++)
+	{
+		double v = x[t];
+		m_sum[t] += weight * v;
+		double delta = v - m_mean[t];
+		if (m_weight > 0.)
+			m_mean[t] += delta * weight / m_weight;
+		m_m2[t] += weight * delta * (v - m_mean[t]);
+		if (m_count == 0 || v < m_min[t])
+			m_min[t] = v;
+		if (m_count == 0 || v > m_max[t])
+			m_max[t] = v;
+	}
+	for (size_t k = 0; k < m_levels.size(); k++)
+	{
+		for (int t = 0; t < m_num_periods; t++)
+			AddToQuantile(k, t, x[t]);
+	}
+	m_count++;
+}
+
+void PeriodStatistics::AddToQuantile(size_t k, int t, double x)
+{
+	/*
+	Updates the P-square markers of quantile k in period t with a new
+	observation.  The first five observations are kept sorted in the marker
+	heights.
+	*/
+	double *q = &m_heights[((size_t)k * m_num_periods + t) * 5];
+	int *n = &m_positions[((size_t)k * m_num_periods + t) * 5];
+	if (m_count < 5)
+	{
+		int i = m_count;
+		for (; i > 0 && q[i - 1] > x; i--)
+			q[i] = q[i - 1];
+		q[i] = x;
+		n[m_count] = m_count;
+		return;
+	}
+
+	//cell of the new observation; adjust the extreme markers if needed
+	int c;
+	if (x < q[0])
+	{
+		q[0] = x;
+		c = 0;
+	}
+	else if (x < q[1])
+		c = 0;
+	else if (x < q[2])
+		c = 1;
+	else if (x < q[3])
+		c = 2;
+	else if (x <= q[4])
+		c = 3;
+	else
+	{
+		q[4] = x;
+		c = 3;
+	}
+	for (int i = c + 1; i < 5; i++)
+		n[i]++;
+
+	//desired (0-based) marker positions after m_count + 1 observations
+	double p = m_levels[k];
+	double m = (double)m_count;
+	double desired[5] = { 0., m * p / 2., m * p, m * (1. + p) / 2., m };
+	for (int i = 1; i < 4; i++)
+	{
+		double d = desired[i] - n[i];
+		if ((d >= 1. && n[i + 1] - n[i] > 1) || (d <= -1. && n[i - 1] - n[i] < -1))
+		{
+			int s = d > 0. ? 1 : -1;
+			double qp = q[i] + (double)s / (n[i + 1] - n[i - 1]) * (
+				(n[i] - n[i - 1] + s) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+				(n[i + 1] - n[i] - s) * (q[i] - q[i - 1]) / (n[i] - n[i - 1])
+				);
+			if (q[i - 1] < qp && qp < q[i + 1])
+				q[i] = qp;
+			else
+				q[i] += s * (q[i + s] - q[i]) / (n[i + s] - n[i]);
+			n[i] += s;
+		}
+	}
+}
+
+int PeriodStatistics::GetCount() const
+{
+	/* retval -- number of series added */
+	return m_count;
+}
+
+double PeriodStatistics::GetWeight() const
+{
+	/* retval -- sum of the weights of the series added */
+	return m_weight;
+}
+
+int PeriodStatistics::GetNumPeriods() const
+{
+	return m_num_periods;
+}
+
+const std::vector<double> &PeriodStatistics::GetQuantileLevels() const
+{
+	return m_levels;
+}
+
+std::vector<double> PeriodStatistics::GetMean() const
+{
+	/* retval -- weighted mean by period; empty if no series of nonzero weight were added */
+	std::vector<double> mean;
+	if (m_count == 0 || m_weight == 0.)
+		return mean;
+	mean.resize(m_num_periods);
+	for (int t = 0; t < m_num_periods; t++)
+		mean[t] = m_sum[t] / m_weight;
+	return mean;
+}
+
+std::vector<double> PeriodStatistics::GetVariance() const
+{
+	/*
+	retval -- sample variance by period, weighted with the bias correction
+		of the number of series, n / (n - 1); empty if fewer than two series
+		or no series of nonzero weight were added
+	*/
+	std::vector<double> var;
+	if (m_count < 2 || m_weight == 0.)
+		return var;
+	var.resize(m_num_periods);
+	double denom = m_weight - m_weight / m_count;
+	for (int t = 0; t < m_num_periods; t++)
+		var[t] = m_m2[t] / denom;
+	return var;
+}
+
+const std::vector<double> &PeriodStatistics::GetMin() const
+{
+	return m_min;
+}
+
+const std::vector<double> &PeriodStatistics::GetMax() const
+{
+	return m_max;
+}
+
+std::vector<double> PeriodStatistics::GetQuantile(size_t k) const
+{
+	/*
+	k -- index of the quantile level
+	retval -- estimate of the quantile by period; empty if no series were
+		added.  Exact (by linear interpolation) for up to five series.
+	*/
+	double p = m_levels.at(k);
+	std::vector<double> est;
+	if (m_count == 0)
+		return est;
+	est.resize(m_num_periods);
+	for (int t = 0; t < m_num_periods; t++)
+	{
+		const double *q = &m_heights[((size_t)k * m_num_periods + t) * 5];
+		if (m_count >= 5)
+			est[t] = q[2];
+		else
+		{
+			double r = p * (m_count - 1);
+			int i = std::min((int)r, m_count - 1);
+			int j = std::min(i + 1, m_count - 1);
+			est[t] = q[i] + (r - i) * (q[j] - q[i]);
+		}
+	}
+	return est;
+}
+
+//##################################################################################
+
+MeanEstimate::MeanEstimate()
+{
+	Reset();
+}
+
+void MeanEstimate::Reset()
+{
+	m_units = 0;
+	m_sum_y = m_sum_w = m_sum_yy = m_sum_yw = m_sum_ww = 0.;
+	m_open_count = 0;
+	m_open_y = m_open_w = 0.;
+}
+
+void MeanEstimate::Add(double x, double weight, bool end_unit)
+{
+	/*
+	Adds the output of one scenario to the open unit.
+	x -- output of the scenario
+	weight -- weight of the scenario, e.g., its likelihood ratio
+	end_unit -- closes the unit after this scenario if true
+	*/
+	m_open_count++;
+	m_open_y += weight * x;
+	m_open_w += weight;
+	if (!end_unit)
+		return;
+	m_units++;
+	m_sum_y += m_open_y;
+	m_sum_w += m_open_w;
+	m_sum_yy += m_open_y * m_open_y;
+	m_sum_yw += m_open_y * m_open_w;
+	m_sum_ww += m_open_w * m_open_w;
+	m_open_count = 0;
+	m_open_y = m_open_w = 0.;
+}
+
+int MeanEstimate::GetUnits() const
+{
+	/* retval -- number of units, counting an open unit */
+	return m_units + (m_open_count > 0 ? 1 : 0);
+}
+
+double MeanEstimate::GetMean() const
+{
+	/* retval -- weighted mean over all scenarios added; 0 if none */
+	double w = m_sum_w + m_open_w;
+	return w > 0. ? (m_sum_y + m_open_y) / w : 0.;
+}
+
+double MeanEstimate::GetStandardError() const
+{
+	/* retval -- standard error of the mean; infinite for fewer than two units */
+	int n = GetUnits();
+	double w = m_sum_w + m_open_w;
+	if (n < 2 || !(w > 0.))
+		return std::numeric_limits<double>::infinity();
+	double mean = GetMean();
+	double ss = m_sum_yy - 2. * mean * m_sum_yw + mean * mean * m_sum_ww;
+	if (m_open_count > 0)
+		ss += (m_open_y - mean * m_open_w) * (m_open_y - mean * m_open_w);
+	return std::sqrt(std::max(0., ss) * n / (n - 1.)) / w;
+}
+
+//##################################################################################
+
+static const char TRACE_MAGIC[8] = { 'D', 'A', 'O', 'T', 'R', 'A', 'C', 'E' };
+static const size_t TRACE_HEADER_SIZE = 64;
+
+ScenarioTraceFile::ScenarioTraceFile()
+{
+	m_num_scenarios = 0;
+	m_num_periods = 0;
+}
+
+ScenarioTraceFile::~ScenarioTraceFile()
+{
+	Close();
+}
+
+size_t ScenarioTraceFile::DataOffset() const
+{
+	/* retval -- offset of the first series: header and padded scenario flags */
+	return TRACE_HEADER_SIZE + (((size_t)m_num_scenarios + 7) / 8) * 8;
+}
+
+double *ScenarioTraceFile::Series(int scenario, int series) const
+{
+	if (!m_file.IsOpen())
+		throw std::runtime_error("trace file is not open.");
+	if (scenario < 0 || scenario >= m_num_scenarios)
+		throw std::runtime_error("scenario index out of range in trace file.");
+	size_t offset = DataOffset() +
+		(((size_t)scenario * NUM_SERIES + series) * m_num_periods) * sizeof(double);
+	return reinterpret_cast<double*>(m_file.GetData() + offset);
+}
+
+void ScenarioTraceFile::Create(const std::string &filename, int num_scenarios,
+	int num_periods)
+{
+	/*
+	Creates (or overwrites) a trace file with no scenarios written.
+	filename -- path of the file
+	num_scenarios -- number of scenarios
+	num_periods -- length of each series
+	*/
+	Close();
+	if (num_scenarios < 0 || num_periods < 0)
+		throw std::runtime_error("invalid dimensions for trace file.");
+	m_num_scenarios = num_scenarios;
+	m_num_periods = num_periods;
+	m_file.Create(filename, DataOffset() +
+		(size_t)num_scenarios * NUM_SERIES * num_periods * sizeof(double));
+
+	//the file starts zero-filled, so all scenarios are marked as unwritten
+	char *h = m_file.GetData();
+	std::memcpy(h, TRACE_MAGIC, 8);
+	uint32_t version = VERSION, nseries = NUM_SERIES;
+	uint64_t ns = (uint64_t)num_scenarios, np = (uint64_t)num_periods;
+	std::memcpy(h + 8, &version, 4);
+	std::memcpy(h + 12, &nseries, 4);
+	std::memcpy(h + 16, &ns, 8);
+	std::memcpy(h + 24, &np, 8);
+}
+
+void ScenarioTraceFile::Open(const std::string &filename)
+{
+	/*
+	Opens an existing trace file for reading.
+	filename -- path of the file
+	*/
+	Close();
+	m_file.Open(filename);
+	if (m_file.GetSize() < TRACE_HEADER_SIZE)
+	{
+		Close();
+		throw std::runtime_error("trace file " + filename + " is too short.");
+	}
+
+	uint32_t version, nseries;
+	uint64_t ns, np;
+	const char *h = m_file.GetData();
+	std::memcpy(&version, h + 8, 4);
+	std::memcpy(&nseries, h + 12, 4);
+	std::memcpy(&ns, h + 16, 8);
+	std::memcpy(&np, h + 24, 8);
+	if (std::memcmp(h, TRACE_MAGIC, 8) != 0 || version != VERSION ||
+		nseries != NUM_SERIES)
+	{
+		Close();
+		throw std::runtime_error(filename + " is not a trace file of a supported version.");
+	}
+	m_num_scenarios = (int)ns;
+	m_num_periods = (int)np;
+	if (m_file.GetSize() < DataOffset() + (size_t)ns * NUM_SERIES * np * sizeof(double))
+	{
+		Close();
+		throw std::runtime_error("trace file " + filename + " is truncated.");
+	}
+}
+
+void ScenarioTraceFile::Close()
+{
+	/* unmaps and closes the file, if open; written data is kept. */
+	m_file.Close();
+}
+
+bool ScenarioTraceFile::IsOpen() const
+{
+	return m_file.IsOpen();
+}
+
+int ScenarioTraceFile::GetNumScenarios() const
+{
+	return m_num_scenarios;
+}
+
+int ScenarioTraceFile::GetNumPeriods() const
+{
+	return m_num_periods;
+}
+
+void ScenarioTraceFile::Write(int scenario, const std::vector<double> &capacity,
+	const std::vector<double> &efficiency)
+{
+	/*
+	Writes the series of a scenario, and marks it as written.
+	scenario -- scenario index
+	capacity -- cycle capacity by period
+	efficiency -- cycle efficiency by period
+	*/
+	if (!m_file.IsWritable())
+		throw std::runtime_error("trace file is not open for writing.");
+	if ((int)capacity.size() != m_num_periods || (int)efficiency.size() != m_num_periods)
+		throw std::runtime_error("series length does not match the trace file.");
+	if (m_num_periods > 0)
+	{
+		std::memcpy(Series(scenario, 0), &capacity[0], m_num_periods * sizeof(double));
+		std::memcpy(Series(scenario, 1), &efficiency[0], m_num_periods * sizeof(double));
+	}
+	else
+		Series(scenario, 0);
+	m_file.GetData()[TRACE_HEADER_SIZE + scenario] = 1;
+}
+
+bool ScenarioTraceFile::HasScenario(int scenario) const
+{
+	/* retval -- true if the series of the scenario were written */
+	if (!m_file.IsOpen() || scenario < 0 || scenario >= m_num_scenarios)
+		return false;
+	return m_file.GetData()[TRACE_HEADER_SIZE + scenario] != 0;
+}
+
+const double *ScenarioTraceFile::GetCapacity(int scenario) const
+{
+	/* retval -- cycle capacity of the scenario by period, in the mapped file */
+	return Series(scenario, 0);
+}
+
+const double *ScenarioTraceFile::GetEfficiency(int scenario) const
+{
+	/* retval -- cycle efficiency of the scenario by period, in the mapped file */
+	return Series(scenario, 1);
+}
@@ -0,0 +1,156 @@
+#ifndef _RESULT_SINK_
+#define _RESULT_SINK_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "mapped_file.h"
+
+/*
+Online statistics of a time series over scenarios: per period, the sum (so
+that the mean is identical to summing the retained series in scenario
+order), the variance (Welford), the minimum and maximum, and estimates of a
+set of quantiles by the P-square algorithm of Jain and Chlamtac (1985), which
+keeps five markers per quantile.  Series may carry a weight, e.g., the
+likelihood ratio of an importance sampled scenario; the mean and variance
+are then weighted (West, 1979), while the minimum, maximum and quantiles
+are of the unweighted series.  Memory depends on the number of periods
+and quantiles only, not on the number of scenarios added.  The quantile 
+estimates are approximate, and coarse for series that take only a few 
+distinct values over the scenarios.
+*/
+class PeriodStatistics
+{
+	int m_num_periods;
+	int m_count;
+	double m_weight;
+	std::vector< double > m_levels;
+	std::vector< double > m_sum;
+	std::vector< double > m_mean;
+	std::vector< double > m_m2;
+	std::vector< double > m_min;
+	std::vector< double > m_max;
+	//P-square markers: heights and positions of marker i of quantile k in
+	//period t, at [(k*m_num_periods + t)*5 + i]
+	std::vector< double > m_heights;
+	std::vector< int > m_positions;
+
+	void AddToQuantile(size_t k, int t, double x);
+
+public:
+	PeriodStatistics();
+
+	void Reset(int num_periods, const std::vector<double> &quantiles);
+
+	void Add(const std::vector<double> &x, double weight = 1.);
+
+	int GetCount() const;
+
+	double GetWeight() const;
+
+	int GetNumPeriods() const;
+
+	const std::vector<double> &GetQuantileLevels() const;
+
+	std::vector<double> GetMean() const;
+
+	std::vector<double> GetVariance() const;
+
+	const std::vector<double> &GetMin() const;
+
+	const std::vector<double> &GetMax() const;
+
+	std::vector<double> GetQuantile(size_t k) const;
+};
+
+/*
+Running estimate of the mean of a scalar output over scenarios (e.g., the
+labor cost of a scenario), with its standard error, for confidence 
+intervals and stopping rules.  Scenarios are grouped into independent 
+units, e.g., one scenario each, or the two scenarios of an antithetic 
+pair; within a unit they may be dependent.  With unit sums y and unit 
+weights W, the mean is sum(y) / sum(W) and its variance is estimated as 
+n / (n - 1) * sum((y - mean W)^2) / sum(W)^2 over the n units, which is 
+the usual s^2 / n for single, unweighted scenarios and the ratio 
+estimator variance under importance sampling.  Only five sums are kept.
+*/
+class MeanEstimate
+{
+	int m_units;
+	double m_sum_y;
+	double m_sum_w;
+	double m_sum_yy;
+	double m_sum_yw;
+	double m_sum_ww;
+	//unit still open
+	int m_open_count;
+	double m_open_y;
+	double m_open_w;
+
+public:
+	MeanEstimate();
+
+	void Reset();
+
+	void Add(double x, double weight, bool end_unit);
+
+	int GetUnits() const;
+
+	double GetMean() const;
+
+	double GetStandardError() const;
+};
+
+/*
+Binary file of the cycle capacity and efficiency of each scenario, accessed
+through a memory mapping.  The layout is a 64-byte header (magic "DAOTRACE",
+format version, number of series, scenarios and periods), one byte per
+scenario that is nonzero once the scenario is written (padded to 8 bytes),
+and then, for each scenario in order, the capacity and efficiency series as
+native doubles.  Scenarios may be written in any order; the file is sized
+when created, so writes never reallocate.
+*/
+class ScenarioTraceFile
+{
+	MappedFile m_file;
+	int m_num_scenarios;
+	int m_num_periods;
+
+	size_t DataOffset() const;
+	double *Series(int scenario, int series) const;
+
+	ScenarioTraceFile(const ScenarioTraceFile &);
+	ScenarioTraceFile &operator=(const ScenarioTraceFile &);
+
+public:
+	static const uint32_t VERSION = 1;
+	static const uint32_t NUM_SERIES = 2;
+
+	ScenarioTraceFile();
+	~ScenarioTraceFile();
+
+	void Create(const std::string &filename, int num_scenarios, int num_periods);
+
+	void Open(const std::string &filename);
+
+	void Close();
+
+	bool IsOpen() const;
+
+	int GetNumScenarios() const;
+
+	int GetNumPeriods() const;
+
+	void Write(int scenario, const std::vector<double> &capacity,
+		const std::vector<double> &efficiency);
+
+	bool HasScenario(int scenario) const;
+
+	const double *GetCapacity(int scenario) const;
+
+	const double *GetEfficiency(int scenario) const;
+};
+
+#endif
@@ -0,0 +1,265 @@
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include "state_bundle.h"
+
+static const char BUNDLE_MAGIC[8] = { 'D', 'A', 'O', 'C', 'Y', 'C', 'S', 'T' };
+static const uint32_t BUNDLE_BYTE_ORDER = 0x01020304;
+static const size_t BUNDLE_HEADER_SIZE = 32;
+static const size_t BUNDLE_ENTRY_SIZE = 24;
+
+static size_t PaddedSize(size_t n)
+{
+	return (n + 7) / 8 * 8;
+}
+
+//##################################################################################
+
+StateBundleSection::StateBundleSection(uint32_t id)
+{
+	m_id = id;
+}
+
+uint32_t StateBundleSection::GetId() const
+{
+	return m_id;
+}
+
+const std::vector< char > &StateBundleSection::GetData() const
+{
+	return m_data;
+}
+
+void StateBundleSection::Append(const void *p, size_t n)
+{
+	/* appends n bytes, zero-padded to a multiple of 8. */
+	size_t pos = m_data.size();
+	m_data.resize(pos + PaddedSize(n), 0);
+	if (n > 0)
+		std::memcpy(&m_data[pos], p, n);
+}
+
+void StateBundleSection::PutInt(int64_t x)
+{
+	Append(&x, sizeof(x));
+}
+
+void StateBundleSection::PutDouble(double x)
+{
+	Append(&x, sizeof(x));
+}
+
+void StateBundleSection::PutDoubles(const std::vector<double> &x)
+{
+	PutInt((int64_t)x.size());
+	if (!x.empty())
+		Append(&x[0], x.size() * sizeof(double));
+}
+
+void StateBundleSection::PutBytes(const std::vector<unsigned char> &x)
+{
+	PutInt((int64_t)x.size());
+	if (!x.empty())
+		Append(&x[0], x.size());
+}
+
+void StateBundleSection::PutWords(const uint32_t *words, size_t n)
+{
+	Append(words, n * sizeof(uint32_t));
+}
+
+//##################################################################################
+
+StateBundleReader::StateBundleReader(const char *data, size_t size)
+{
+	m_data = data;
+	m_size = size;
+	m_pos = 0;
+}
+
+const char *StateBundleReader::Take(size_t n)
+{
+	/* retval -- the next n bytes; the cursor moves past their padding. */
+	size_t padded = PaddedSize(n);
+	if (padded < n || m_pos + padded > m_size || m_pos + padded < m_pos)
+		throw std::runtime_error("state bundle section is truncated.");
+	const char *p = m_data + m_pos;
+	m_pos += padded;
+	return p;
+}
+
+int64_t StateBundleReader::GetInt()
+{
+	int64_t x;
+	std::memcpy(&x, Take(sizeof(x)), sizeof(x));
+	return x;
+}
+
+double StateBundleReader::GetDouble()
+{
+	double x;
+	std::memcpy(&x, Take(sizeof(x)), sizeof(x));
+	return x;
+}
+
+void StateBundleReader::GetDoubles(std::vector<double> &x)
+{
+	int64_t n = GetInt();
+	if (n < 0 || (uint64_t)n > (m_size - m_pos) / sizeof(double))
+		throw std::runtime_error("state bundle section is truncated.");
+	x.resize((size_t)n);
+	if (n > 0)
+		std::memcpy(&x[0], Take((size_t)n * sizeof(double)), (size_t)n * sizeof(double));
+}
+
+void StateBundleReader::GetBytes(std::vector<unsigned char> &x)
+{
+	int64_t n = GetInt();
+	if (n < 0 || (uint64_t)n > m_size - m_pos)
+		throw std::runtime_error("state bundle section is truncated.");
+	x.resize((size_t)n);
+	if (n > 0)
+		std::memcpy(&x[0], Take((size_t)n), (size_t)n);
+}
+
+void StateBundleReader::GetWords(uint32_t *words, size_t n)
+{
+	std::memcpy(words, Take(n * sizeof(uint32_t)), n * sizeof(uint32_t));
+}
+
+bool StateBundleReader::AtEnd() const
+{
+	return m_pos >= m_size;
+}
+
+//##################################################################################
+
+void StateBundle::Write(const std::string &filename,
+	const std::vector<StateBundleSection> &sections)
+{
+	/*
+	Writes a bundle of the given sections, replacing any existing file.
+	filename -- path of the file
+	sections -- section contents, in the order to be written
+	*/
+	uint64_t nsec = (uint64_t)sections.size();
+	size_t offset = PaddedSize(BUNDLE_HEADER_SIZE + sections.size() * BUNDLE_ENTRY_SIZE);
+	std::vector< uint64_t > offsets(sections.size());
+	for (size_t i = 0; i < sections.size(); i++)
+	{
+		offsets[i] = (uint64_t)offset;
+		offset += sections[i].GetData().size();
+	}
+	uint64_t total = (uint64_t)offset;
+
+	std::string temp_filename = filename + ".tmp";
+	MappedFile file;
+	file.Create(temp_filename, offset);
+	char *h = file.GetData();
+	uint32_t version = VERSION, byte_order = BUNDLE_BYTE_ORDER;
+	std::memcpy(h, BUNDLE_MAGIC, 8);
+	std::memcpy(h + 8, &version, 4);
+	std::memcpy(h + 12, &byte_order, 4);
+	std::memcpy(h + 16, &nsec, 8);
+	std::memcpy(h + 24, &total, 8);
+	for (size_t i = 0; i < sections.size(); i++)
+	{
+		char *e = h + BUNDLE_HEADER_SIZE + i * BUNDLE_ENTRY_SIZE;
+		uint32_t id = sections[i].GetId();
+		uint64_t size = (uint64_t)sections[i].GetData().size();
+		std::memcpy(e, &id, 4);
+		std::memcpy(e + 8, &offsets[i], 8);
+		std::memcpy(e + 16, &size, 8);
+		if (size > 0)
+			std::memcpy(h + offsets[i], &sections[i].GetData()[0], (size_t)size);
+	}
+	file.Close();
+
+	std::remove(filename.c_str());
+	if (std::rename(temp_filename.c_str(), filename.c_str()) != 0)
+		throw std::runtime_error("could not write state bundle " + filename);
+}
+
+void StateBundle::Open(const std::string &filename)
+{
+	/*
+	Opens a bundle for reading, and reads its table of sections.
+	filename -- path of the file
+	*/
+	Close();
+	m_file.Open(filename);
+	const char *h = m_file.GetData();
+	size_t size = m_file.GetSize();
+	uint32_t version = 0, byte_order = 0;
+	uint64_t nsec = 0, total = 0;
+	if (size >= BUNDLE_HEADER_SIZE)
+	{
+		std::memcpy(&version, h + 8, 4);
+		std::memcpy(&byte_order, h + 12, 4);
+		std::memcpy(&nsec, h + 16, 8);
+		std::memcpy(&total, h + 24, 8);
+	}
+	if (size < BUNDLE_HEADER_SIZE || std::memcmp(h, BUNDLE_MAGIC, 8) != 0 ||
+		version != VERSION || byte_order != BUNDLE_BYTE_ORDER)
+	{
+		Close();
+		throw std::runtime_error(filename + " is not a state bundle of a supported version.");
+	}
+	if (total != (uint64_t)size || nsec > (size - BUNDLE_HEADER_SIZE) / BUNDLE_ENTRY_SIZE)
+	{
+		Close();
+		throw std::runtime_error("state bundle " + filename + " is truncated.");
+	}
+	for (uint64_t i = 0; i < nsec; i++)
+	{
+		const char *e = h + BUNDLE_HEADER_SIZE + i * BUNDLE_ENTRY_SIZE;
+		uint32_t id;
+		uint64_t offset, len;
+		std::memcpy(&id, e, 4);
+		std::memcpy(&offset, e + 8, 8);
+		std::memcpy(&len, e + 16, 8);
+		if (offset > total || len > total - offset)
+		{
+			Close();
+			throw std::runtime_error("state bundle " + filename + " is truncated.");
+		}
+		m_ids.push_back(id);
+		m_offsets.push_back(offset);
+		m_sizes.push_back(len);
+	}
+}
+
+void StateBundle::Close()
+{
+	m_file.Close();
+	m_ids.clear();
+	m_offsets.clear();
+	m_sizes.clear();
+}
+
+bool StateBundle::IsOpen() const
+{
+	return m_file.IsOpen();
+}
+
+bool StateBundle::HasSection(uint32_t id) const
+{
+	for (size_t i = 0; i < m_ids.size(); i++)
+		if (m_ids[i] == id)
+			return true;
+	return false;
+}
+
+StateBundleReader StateBundle::GetSection(uint32_t id) const
+{
+	/*
+	retval -- cursor at the start of the first section with the given id;
+	throws if the bundle has no such section.
+	*/
+	for (size_t i = 0; i < m_ids.size(); i++)
+		if (m_ids[i] == id)
+			return StateBundleReader(m_file.GetData() + m_offsets[i], (size_t)m_sizes[i]);
+	throw std::runtime_error("state bundle " + m_file.GetFilename() +
+		" has no section " + std::to_string(id) + ".");
+}
@@ -0,0 +1,117 @@
+#ifndef _STATE_BUNDLE_
+#define _STATE_BUNDLE_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "mapped_file.h"
+
+/*
+Sections of the plant state bundle written by PowerCycle::WriteStateBundle.
+*/
+enum state_bundle_section
+{
+	BUNDLE_SIM_PARAMS = 1,   //simulation parameters, as in the sim params file
+	BUNDLE_LAYOUT = 2,       //plant composition and condenser efficiencies
+	BUNDLE_COMPONENTS = 3,   //component state arrays (ComponentStateArrays::SaveState)
+	BUNDLE_PLANT_STATE = 4,  //cycle_state
+	BUNDLE_CAP_EFF = 5,      //periods of last failure/repair, capacity and efficiency
+	BUNDLE_RNG = 6           //stored states of the three RNG streams of the scenario
+};
+
+/*
+Contents of one section of a state bundle, built in memory before writing.
+All values are stored in native byte order and padded to 8 bytes, so that
+they can be read in place from the mapped file: integers as int64, doubles
+as is, and arrays as an int64 count followed by the elements.
+*/
+class StateBundleSection
+{
+	uint32_t m_id;
+	std::vector< char > m_data;
+
+	void Append(const void *p, size_t n);
+
+public:
+	StateBundleSection(uint32_t id);
+
+	uint32_t GetId() const;
+
+	const std::vector< char > &GetData() const;
+
+	void PutInt(int64_t x);
+
+	void PutDouble(double x);
+
+	void PutDoubles(const std::vector<double> &x);
+
+	void PutBytes(const std::vector<unsigned char> &x);
+
+	void PutWords(const uint32_t *words, size_t n);
+};
+
+/*
+Cursor over a section of an open state bundle, reading values in the order
+they were put.  Reading past the end of the section throws.
+*/
+class StateBundleReader
+{
+	const char *m_data;
+	size_t m_size;
+	size_t m_pos;
+
+	const char *Take(size_t n);
+
+public:
+	StateBundleReader(const char *data, size_t size);
+
+	int64_t GetInt();
+
+	double GetDouble();
+
+	void GetDoubles(std::vector<double> &x);
+
+	void GetBytes(std::vector<unsigned char> &x);
+
+	void GetWords(uint32_t *words, size_t n);
+
+	bool AtEnd() const;
+};
+
+/*
+Versioned binary file of sections, accessed through a memory mapping.  The
+layout is a 32-byte header (magic "DAOCYCST", format version, byte order
+mark, number of sections and total size), a table of sections (id, offset
+and size, 24 bytes each), and the sections themselves at 8-byte aligned
+offsets.  Readers skip sections they do not know, so that sections may be
+added without a new version; files of other versions, or written with a
+different byte order, are rejected.  Files are written to a temporary name
+and then renamed, so that a reader never sees a partially written bundle.
+*/
+class StateBundle
+{
+	MappedFile m_file;
+	std::vector< uint32_t > m_ids;
+	std::vector< uint64_t > m_offsets;
+	std::vector< uint64_t > m_sizes;
+
+public:
+	static const uint32_t VERSION = 2;
+
+	static void Write(const std::string &filename,
+		const std::vector<StateBundleSection> &sections);
+
+	void Open(const std::string &filename);
+
+	void Close();
+
+	bool IsOpen() const;
+
+	bool HasSection(uint32_t id) const;
+
+	StateBundleReader GetSection(uint32_t id) const;
+};
+
+#endif
@@ -1,5 +1,7 @@
 #include <vector>
+#include <string>
 #include <stdint.h>
+#include <stddef.h>
 #include <unordered_map>
 
 #ifndef _WELL512_
@@ -8,40 +10,55 @@
 
 class WELLFiveTwelve
 {
-    int W;
-    int R;
-    int P;
-    int M1;
-    int M2;
-    int M3;
-    long double FACT;
-
-    std::vector< uint32_t > state;
+    uint32_t state[16];
     int state_i;
-	
+	uint32_t m_antithetic_mask;  //0, or all ones when variates are complemented
+	uint64_t m_num_variates;     //variates drawn since construction, for instrumentation
 
+	WELLFiveTwelve();
+	void loadBaseState();
+	void jumpPower(int e);
+	static std::vector< uint64_t > jumpPolynomials();
+	static const uint64_t *jumpPolynomial(int e);
 
 public:
-    //WELLFiveTwelve();
-    WELLFiveTwelve(int scen, int W=32, int R=16, int P=0, int M1=13, int M2=9, int M3=5);
+	static const int MAX_JUMP_LOG2 = 320;
+
+    WELLFiveTwelve(int scen);
 
     void assignStates(int scenario);
 	void saveStates(int scenario);
+	void assignSubstream(int scenario, uint64_t substream);
+	void jumpAhead(uint64_t n, int log2_stride = 0);
+	void getState(uint32_t *words, int &index) const;
+	void setState(const uint32_t *words, int index);
+	void setAntithetic(bool antithetic);
+	bool isAntithetic() const;
+	uint64_t getNumVariates() const;
+
+    inline double getVariate()
+    {
+		/*
+		WELL512a recurrence (Panneton, L'Ecuyer and Matsumoto), on the
+		circular buffer 'state' with current position 'state_i'.
+		*/
+		m_num_variates++;
+		uint32_t v0 = state[state_i];
+		uint32_t vm1 = state[(state_i + 13) & 0xf];
+		uint32_t vm2 = state[(state_i + 9) & 0xf];
+		uint32_t z0 = state[(state_i + 15) & 0xf];
+		uint32_t z1 = (v0 ^ (v0 << 16)) ^ (vm1 ^ (vm1 << 15));
+		uint32_t z2 = vm2 ^ (vm2 >> 11);
+		uint32_t v1 = z1 ^ z2;
+		state[state_i] = v1;
+		state_i = (state_i + 15) & 0xf;
+		state[state_i] = (z0 ^ (z0 << 2)) ^ (z1 ^ (z1 << 18)) ^ (z2 << 28)
+			^ (v1 ^ ((v1 << 5) & 0xda442d24));
+		return (double)(state[state_i] ^ m_antithetic_mask) * 2.32830643653869628906e-10;
+    }
+
+	void fill(double *variates, size_t n);
 
-    int V0();
-    int VM1();
-    int VM2();
-    int VM3();
-    int VRm1();
-    int VRm2();
-    int newV0();
-    int newV1();
-    int newVRm1();
-    uint32_t MAT0POS(int t, uint32_t v);
-    uint32_t MAT0NEG(int t, uint32_t v);
-    uint32_t MAT3NEG(int t, uint32_t v);
-    uint32_t MAT4NEG(int t, uint32_t b, uint32_t v);
-    double getVariate();
 	std::unordered_map<int, std::vector< uint32_t > > m_stored_states;
 	std::unordered_map<int, int > m_stored_state_is;
 	void UpdateStoredState(int scenario, std::vector< uint32_t > new_state, int new_state_i);
@@ -52,4 +69,4 @@ public:
 
 
 
-#endif
\ No newline at end of file
+#endif
@@ -318,6 +318,7 @@ void optical_degradation::simulate(bool(*callback)(float prg, const char *msg),
 	double degr_accel = std::pow((1. + m_settings.degr_accel_per_year), 1./8760);
 	int num_accel_entries = m_settings.n_hr_warmup + m_settings.n_hr_sim + std::max(m_settings.soil_sim_interval, m_settings.refl_sim_interval) + 1;
 	std::vector< double > alpha_t_by_age(num_accel_entries);
+	std::vector< double > rate_alphas(helios.size()), rate_draws(helios.size());
 	if (m_settings.degr_accel_per_year > DBL_EPSILON)
 	{
 		alpha_t_by_age[0] = degr_accel;
@@ -383,29 +384,24 @@ void optical_degradation::simulate(bool(*callback)(float prg, const char *msg),
 		//at each soiling interval, refresh hourly soiling rates
 		if (t % m_settings.soil_sim_interval == 0)
 		{
-			for (std::vector<opt_heliostat>::iterator h = helios.begin(); h != helios.end(); h++)
-			{
-				//soil each heliostat
-				double ss = soiling_dist.GetVariate(
-					m_settings.soil_sim_interval*soil_c,soil_gen
-				);
-				h->soil_loss_rate = ss;
-			}
+			//soil each heliostat
+			soiling_dist.GetVariates(
+				m_settings.soil_sim_interval*soil_c, soil_gen, rate_draws.data(), helios.size()
+			);
+			for (size_t i = 0; i < helios.size(); i++)
+				helios[i].soil_loss_rate = rate_draws[i];
 		}
 
 		//at each degradation interval, refresh hourly degradation rates
 		if (t % m_settings.refl_sim_interval == 0)
 		{
-			for (std::vector<opt_heliostat>::iterator h = helios.begin(); h != helios.end(); h++)
-			{
-
-				//degrade each heliostat
-				double dd = degr_dist.GetVariate(
-					alpha_t_by_age[h->age_hours+m_settings.refl_sim_interval] 
-					- alpha_t_by_age[h->age_hours], degr_gen
-				);
-				h->refl_loss_rate = dd;
-			}
+			//degrade each heliostat
+			for (size_t i = 0; i < helios.size(); i++)
+				rate_alphas[i] = alpha_t_by_age[helios[i].age_hours+m_settings.refl_sim_interval] 
+					- alpha_t_by_age[helios[i].age_hours];
+			degr_dist.GetVariates(rate_alphas.data(), degr_gen, rate_draws.data(), helios.size());
+			for (size_t i = 0; i < helios.size(); i++)
+				helios[i].refl_loss_rate = rate_draws[i];
 		}
 
 		//at each hour, update the soiling/degradation losses.
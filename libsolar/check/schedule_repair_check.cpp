@@ -0,0 +1,125 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "solarfield_staff.h"
+
+/*
+Check of solarfield_staff_member::schedule_repair().
+
+schedule_repair() skips the whole weeks in which a repair cannot end 
+instead of walking them a day at a time.  This checks it against the 
+day-by-day loop it replaced, on random staff limits, hours already worked,
+start times and repair times, comparing the completion time and the 
+hours worked today, this week and in total.  Inputs are multiples of 
+1/64 hour, so that both sides compute exactly and must agree to the bit; 
+off that grid, the two can differ where the remaining repair time is 
+within rounding of a whole number of weeks.
+
+usage: schedule_repair_check [-n cases] [-s seed]
+	-n -- number of random cases (default 200000)
+	-s -- stream of the random number generator (default 0)
+Exits with a nonzero status on any mismatch.
+*/
+
+static double ScheduleRepairByDay(solarfield_staff_member &staff, double t_start, double repair_time)
+{
+	/*
+	The day-by-day repair calendar that schedule_repair() replaced (formerly
+	solarfield_availability::get_time_of_repair()).
+	*/
+	double t_end = t_start * 1.0;
+	//try to finish today
+	double hours_left_today = 24 - remainder(t_start, 24.);
+	if (repair_time <= fmin(staff.get_time_available(), hours_left_today))
+	{
+		staff.m_hours_this_week += repair_time;
+		staff.m_hours_today += repair_time;
+		return t_start += repair_time;
+	}
+	t_end += hours_left_today;
+	double repair_remaining = repair_time - fmin(staff.get_time_available(), hours_left_today);
+	double week_labor = staff.get_time_available_week() - fmin(staff.get_time_available(), hours_left_today);
+	double day_labor = fmin(week_labor, staff.m_max_hours_per_day);
+	int days_left = (int)remainder(t_end, 168) / 24;
+	while (true)
+	{
+		for (int i = 0; i < days_left; i++)
+		{
+			day_labor = fmin(week_labor, staff.m_max_hours_per_day);
+			if (repair_remaining < fmin(week_labor, staff.m_max_hours_per_day))
+			{
+				staff.m_hours_this_week = staff.m_max_hours_per_week - week_labor + repair_remaining;
+				staff.m_hours_today = repair_remaining;
+				staff.add_time_worked(repair_time);
+				return t_end + repair_remaining;
+			}
+			week_labor -= day_labor;
+			repair_remaining -= day_labor;
+			t_end += 24;
+		}
+		days_left = 7;
+		week_labor = staff.m_max_hours_per_week;
+	}
+}
+
+static double Grid(WELLFiveTwelve &gen, double max)
+{
+	/* retval -- random multiple of 1/64 in [0, max] */
+	return floor(gen.getVariate() * (max * 64. + 1.)) / 64.;
+}
+
+int main(int argc, char *argv[])
+{
+	int num_cases = 200000;
+	int seed = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		bool has_value = i + 1 < argc;
+		if (std::strcmp(argv[i], "-n") == 0 && has_value)
+			num_cases = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "-s") == 0 && has_value)
+			seed = std::atoi(argv[++i]);
+		else
+			num_cases = 0;
+	}
+	if (num_cases < 1 || seed < 0)
+	{
+		std::cerr << "usage: schedule_repair_check [-n cases] [-s seed]\n";
+		return 1;
+	}
+
+	WELLFiveTwelve gen(seed);
+	int failures = 0;
+	for (int c = 0; c < num_cases; c++)
+	{
+		solarfield_staff_member staff;
+		double max_day = 1. + Grid(gen, 15.);
+		double max_week = max_day + Grid(gen, 80.);
+		staff.initialize(max_day, max_week);
+		staff.m_hours_this_week = Grid(gen, staff.m_max_hours_per_week);
+		staff.m_hours_today = fmin(staff.m_hours_this_week, Grid(gen, staff.m_max_hours_per_day));
+		staff.m_hours_worked = Grid(gen, 1000.);
+		double t_start = Grid(gen, 87600.);
+		//mostly short repairs, some spanning many weeks
+		double repair_time = Grid(gen, gen.getVariate() < 0.8 ? 40. : 2000.);
+
+		solarfield_staff_member expected = staff;
+		double t_expected = ScheduleRepairByDay(expected, t_start, repair_time);
+		double t_end = staff.schedule_repair(t_start, repair_time);
+		if (t_end != t_expected || staff.m_hours_today != expected.m_hours_today ||
+			staff.m_hours_this_week != expected.m_hours_this_week ||
+			staff.m_hours_worked != expected.m_hours_worked)
+		{
+			if (failures < 10)
+				std::cerr << "case " << c << ": start " << t_start << " repair " << repair_time
+					<< " limits " << max_day << "/" << max_week << ": end " << t_end 
+					<< " expected " << t_expected << "\n";
+			failures++;
+		}
+	}
+	std::printf("schedule_repair_check: %d cases, %d failures\n", num_cases, failures);
+	return failures == 0 ? 0 : 1;
+}
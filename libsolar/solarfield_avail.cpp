@@ -1,6 +1,7 @@
 #include "solarfield_structures.h"
 #include "solarfield_avail.h"
 #include "./../libcycle/distributions.h"
+#include "./../libcycle/result_sink.h"
 
 #include <random>
 #include <vector>
@@ -11,6 +12,12 @@
 #include <iostream>
 #include <fstream>
 #include <float.h>
+#include <limits>
+#include <stdexcept>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 solarfield_availability::solarfield_availability()
 {
@@ -43,6 +50,7 @@ void solarfield_availability::initialize()
 	initialize_results();
 	m_repair_queue_length = 0;
 	m_current_availability = 1.0;
+	m_levels.reset(m_settings.n_years * 8760, m_current_availability, (double)m_repair_queue_length);
 }
 
 void solarfield_availability::initialize_results()
@@ -65,10 +73,15 @@ void solarfield_availability::initialize_results()
 
 	m_results.staff_utilization = 0.;
 
+	m_results.n_replications = 1;
+	m_results.avg_avail_ci = std::numeric_limits<double>::quiet_NaN();
+	m_results.n_repairs_ci = std::numeric_limits<double>::quiet_NaN();
+	m_results.staff_utilization_ci = std::numeric_limits<double>::quiet_NaN();
+	m_results.repair_cost_ci = std::numeric_limits<double>::quiet_NaN();
 
 	m_results.staff_time.clear();
 	m_results.failures_per_year.clear();
-	//m_results.repair_time_per_year.clear();
+	m_results.repair_time_per_year.clear();
 	m_results.queue_size_vs_time.clear();
 	m_results.queue_size_vs_time.assign(nsteps, 0);
 	//m_results.queue_time_vs_time.clear();
@@ -90,42 +103,88 @@ void solarfield_availability::initialize_results()
 
 void solarfield_availability::create_om_staff(int n_staff, double max_hours_per_day, double max_hours_per_week)
 {
-	m_staff = solarfield_repair_staff();
+	m_staff.clear();
 	m_staff.m_max_hours_per_day = max_hours_per_day;
 	m_staff.m_max_hours_per_week = max_hours_per_week;
-	m_staff.m_n_staff = n_staff;
+	m_staff.m_members.reserve(n_staff);
 	for (int m = 0; m < n_staff; m++)
+		m_staff.add_member(max_hours_per_day, max_hours_per_week);
+}
+
+void solarfield_availability::sample_heliostats(int n_heliostats)
+{
+	/*
+	Chooses the heliostats that represent the field, setting the energy 
+	each represents and its performance, and m_settings.sum_performance 
+	to the total energy represented, which is the energy of the whole 
+	field in both modes, so that the revenue based on it is the same.  
+	FIRST_HELIOSTATS takes the first n_heliostats of 
+	m_settings.helio_performance, each representing its own energy scaled 
+	by the ratio of the field total to the total of those heliostats.  
+	STRATIFIED sorts all heliostats by performance and splits them into 
+	n_heliostats strata of equal size, to within one heliostat; each 
+	stratum is simulated as one heliostat of its mean performance that 
+	represents the energy of the whole stratum, so the losses of low- and 
+	high-performing heliostats are weighted as in the full field.  As all 
+	heliostats share the same component distributions, the stratum mean 
+	represents the stratum as well as any one heliostat drawn from it.
+	n_heliostats -- number of heliostats to simulate
+	*/
+	const std::vector<double> &perf = m_settings.helio_performance;
+	if (n_heliostats < 1 || (size_t)n_heliostats > perf.size())
+		throw std::runtime_error("Number of simulated heliostats must be between 1 and the number of heliostat performance values");
+
+	m_helio_energy.clear();
+	m_helio_sim_performance.clear();
+	m_settings.sum_performance = 0.0;
+	if (m_settings.helio_sampling == STRATIFIED)
+	{
+		std::vector<int> order(perf.size());
+		for (size_t i = 0; i < order.size(); i++)
+			order[i] = (int)i;
+		std::stable_sort(order.begin(), order.end(),
+			[&perf](int a, int b) { return perf[a] < perf[b]; });
+
+		size_t n = order.size();
+		for (size_t k = 0; k < (size_t)n_heliostats; k++)
+		{
+			size_t first = k * n / n_heliostats;
+			size_t last = (k + 1) * n / n_heliostats;
+			double energy = 0.;
+			for (size_t i = first; i < last; i++)
+				energy += perf[order[i]];
+			m_helio_energy.push_back(energy);
+			m_helio_sim_performance.push_back(energy / (double)(last - first));
+			m_settings.sum_performance += energy;
+		}
+	}
+	else
 	{
-		solarfield_staff_member *staff = new solarfield_staff_member();
-		staff->initialize(max_hours_per_day, max_hours_per_week);
-		m_staff.m_members.push_back(staff);
+		double field_energy = 0., sim_energy = 0.;
+		for (size_t i = 0; i < perf.size(); i++)
+			field_energy += perf[i];
+		for (int i = 0; i < n_heliostats; i++)
+			sim_energy += perf[i];
+		m_helio_sim_performance.assign(perf.begin(), perf.begin() + n_heliostats);
+		for (int i = 0; i < n_heliostats; i++)
+			m_helio_energy.push_back(perf[i] * field_energy / sim_energy);
+		m_settings.sum_performance = field_energy;
 	}
 }
 
 void solarfield_availability::create_helio_field(int n_components, int n_heliostats, double scale)
 {
-	m_field.m_components.clear();
-	m_field.m_helios.clear();
-	m_field.m_helios.reserve(n_heliostats);
-	m_field.m_components.reserve(n_components);
-	m_settings.sum_performance = 0.0;
+	m_field.clear();
 	for (int c = 0; c < n_components; c++)
 	{
 		m_field.add_component(m_settings.helio_components.at(c));
 	}
+	if (m_settings.is_tracking)
+		m_field.initialize_repair_time_tracking();
 
-	for (int i = 0; i < n_heliostats; i++)
-	{
-		solarfield_heliostat *hel = new solarfield_heliostat;
-
-		m_settings.sum_performance += m_settings.helio_performance[i];
-
-		hel->initialize(m_field.m_components, *m_gen, scale, m_settings.helio_performance[i]);
-		m_field.m_helios.push_back(hel);
+	sample_heliostats(n_heliostats);
 
-		if (m_settings.is_tracking)
-			hel->initialize_repair_time_tracking();
-	}
+	m_field.add_heliostats(n_heliostats, *m_gen, scale, m_helio_sim_performance);
 }
 
 void solarfield_availability::assign_generator(WELLFiveTwelve &gen)
@@ -137,7 +196,9 @@ void solarfield_availability::get_operating_hours()
 {
 	/* 
 	Determines the operating schedule based on the daily sunrise and sunset 
-	assumed for the location. The result is stored in m_settings.op_schedule.
+	assumed for the location. The result is stored in m_settings.op_schedule,
+	and the cumulative operating hours over the year, from which 
+	get_time_of_failure finds failure times, in m_cumulative_op_hours.
 	Assumes that the heliostats operate from sunrise to sunset.
 	*/
 	std::vector<double> daily_sunrise, daily_sunset, op_hours;
@@ -170,8 +231,12 @@ void solarfield_availability::get_operating_hours()
 				throw std::runtime_error("Logic broken!");
 		}
 	}
+	m_cumulative_op_hours.assign(op_hours.size() + 1, 0.);
+	for (size_t h = 0; h < op_hours.size(); h++)
+		m_cumulative_op_hours[h + 1] = m_cumulative_op_hours[h] + op_hours[h];
+
 	m_settings.op_schedule.clear();
-	m_settings.op_schedule.reserve(m_settings.n_years*m_settings.op_schedule.size());
+	m_settings.op_schedule.reserve(m_settings.n_years*op_hours.size());
 	for (int y = 0; y < m_settings.n_years; y++)
 	{
 		m_settings.op_schedule.insert(m_settings.op_schedule.end(), op_hours.begin(), op_hours.end());
@@ -180,32 +245,56 @@ void solarfield_availability::get_operating_hours()
 
 
 
+double solarfield_availability::get_cumulative_op_hours(int t)
+{
+	/*
+	t -- time period, from 0 to the number of periods simulated
+	retval -- operating hours of the periods before t
+	*/
+	return (double)(t / 8760) * m_cumulative_op_hours[8760] + m_cumulative_op_hours[t % 8760];
+}
+
 double solarfield_availability::get_time_of_failure(double t_start, double op_life)
 {
 	/*
 	Determines the time of failure, given operating hours (i.e., daily sunrise and sunset) and operating life.
-	sunrise -- daily sunrise (hour, 0-24)
-	sunset -- daily sunset (hour, 0-24)
+	After the hour containing t_start, the hour in which the operating life 
+	runs out is found by binary search on the cumulative operating hours, 
+	which repeat every year.
 	t_start -- time period of start of operating life
 	op_life -- operating lifetime (hours)
 	retval -- time period of end of life
 	*/
 	
-	double life_remaining = op_life;
 	int idx = int(t_start);
+	int nhours = (int)m_settings.op_schedule.size();
 	//check for end of op_life durign the current hour
 	if (m_settings.op_schedule[idx] * (t_start + 1 - idx) > op_life)
 		return t_start + op_life / (m_settings.op_schedule[idx] * (t_start + 1 - idx));
-	life_remaining -= (idx+1-t_start)*m_settings.op_schedule[idx];
-	while (idx < (int)m_settings.op_schedule.size()-1 && life_remaining > DBL_EPSILON)
+	double life_remaining = op_life - (idx+1-t_start)*m_settings.op_schedule[idx];
+	if (idx >= nhours - 1 || life_remaining <= DBL_EPSILON)
+		return (double)idx + 1;
+
+	//find the first hour end, k, by which the remaining life is used up 
+	//to within DBL_EPSILON
+	double start_hours = get_cumulative_op_hours(idx + 1);
+	double target = start_hours + life_remaining - DBL_EPSILON;
+	if (get_cumulative_op_hours(nhours) < target)
+		return (double)nhours;
+	int lo = idx + 2, hi = nhours;
+	while (lo < hi)
 	{
-		idx++;
-		life_remaining -= m_settings.op_schedule[idx];
-		if (life_remaining < -DBL_EPSILON)  //if op_life expired, subtract overage
-			return (double)idx + life_remaining / m_settings.op_schedule[idx] + 1;
+		int mid = lo + (hi - lo) / 2;
+		if (get_cumulative_op_hours(mid) < target)
+			lo = mid + 1;
+		else
+			hi = mid;
 	}
+	life_remaining -= get_cumulative_op_hours(lo) - start_hours;
+	if (life_remaining < -DBL_EPSILON)  //if op_life expired, subtract overage
+		return (double)lo + life_remaining / m_settings.op_schedule[lo - 1];
 	//if finishing at the end of an hour, return that value.
-	return (double)idx + 1;
+	return (double)lo;
 }
 
 double solarfield_availability::get_time_of_repair(double t_start, double repair_time, solarfield_staff_member* staff)
@@ -219,67 +308,33 @@ repair_time -- time of repair completion
 staff -- staff member (include labor stats)
 */
 {
-	double t_end = t_start * 1.0;
-	//try to finish today
-	double hours_left_today = 24 - remainder(t_start, 24.);
-	if (repair_time <= fmin(staff->get_time_available(), hours_left_today))
-	{
-		staff->m_hours_this_week += repair_time;
-		staff->m_hours_today += repair_time;
-		return t_start += repair_time;
-	}
-	//advance through future days, updating daily and weekly labor as required.
-	//stop when the available working hours is greater than the remaining 
-	//repair time.
-	t_end += hours_left_today;
-	double repair_remaining = repair_time - fmin(staff->get_time_available(), hours_left_today);
-	double week_labor = staff->get_time_available_week() - fmin(staff->get_time_available(), hours_left_today);
-	double day_labor = fmin(week_labor, staff->m_max_hours_per_day);
-	int days_left = (int)remainder(t_end, 168) / 24;
-	while (true)
-	{
-		for (int i = 0; i < days_left; i++)
-		{
-			day_labor = fmin(week_labor, staff->m_max_hours_per_day);
-			if (repair_remaining < fmin(week_labor, staff->m_max_hours_per_day))
-			{
-				staff->m_hours_this_week = staff->m_max_hours_per_week - week_labor + repair_remaining;
-				staff->m_hours_today = repair_remaining;
-				staff->add_time_worked(repair_time);
-				return t_end + repair_remaining;
-			}
-			week_labor -= day_labor;
-			repair_remaining -= day_labor;
-			t_end += 24;
-		}
-		days_left = 7;
-		week_labor = staff->m_max_hours_per_week;
-	}
+	return staff->schedule_repair(t_start, repair_time);
 }
 
-std::priority_queue<solarfield_event> solarfield_availability::create_initial_queue(std::vector<double> operating_hours)
+void solarfield_availability::create_initial_queue()
 {
-	/*int _helio_id,
-		bool _is_repair,
-		double _time,
-		double _priority*/
+	/*
+	Fills the event queue with the first failure of each heliostat, and 
+	empties the repair queue.
+	*/
 	double end_time;
-	std::priority_queue<solarfield_event> queue = {};
-	for (int idx=0; idx<m_field.m_helios.size(); idx++)
+	int n_helios = m_field.get_n_heliostats();
+	m_event_queue.reset(n_helios);
+	m_repair_queue.reset(n_helios);
+	for (int idx=0; idx<n_helios; idx++)
 	{
 		end_time = get_time_of_failure(
 				0.,
-			m_field.m_helios.at(idx)->get_op_time_to_next_failure()
+			m_field.get_op_time_to_next_failure(idx)
 			);
-		queue.push(solarfield_event(
+		m_event_queue.push(solarfield_event(
 			idx,
-			m_field.m_helios.at(idx)->get_next_component_to_fail(),
+			m_field.get_next_component_to_fail(idx),
 			false,
 			end_time,
 			1. / end_time
 		));
 	}
-	return queue;
 }
 
 void solarfield_availability::process_failure()
@@ -291,18 +346,17 @@ void solarfield_availability::process_failure()
 	
 	t_last -- time of last event [h]
 	*/
-	m_current_availability -= m_settings.helio_performance[m_current_event.helio_id] / m_settings.sum_performance;
+	m_current_availability -= m_helio_energy[m_current_event.helio_id] / m_settings.sum_performance;
 	if (m_results.min_avail > m_current_availability)
 		m_results.min_avail = m_current_availability;
 	m_results.n_failures_per_component[m_current_event.component_idx] += 1;
-	m_field.m_helios.at(m_current_event.helio_id)->fail(m_current_event.time, *m_gen);
+	m_field.fail(m_current_event.helio_id, m_current_event.time, *m_gen);
 	if (m_staff.is_staff_available())
 	{
-		solarfield_staff_member* staff = m_staff.get_available_staff();
-		staff->assign_heliostat(m_current_event.helio_id);
+		solarfield_staff_member* staff = m_staff.assign_available_staff(m_current_event.helio_id);
 		double end_time = get_time_of_repair(
 			m_current_event.time,
-			m_field.m_helios.at(m_current_event.helio_id)->get_repair_time(),
+			m_field.get_repair_time(m_current_event.helio_id),
 			staff
 		);
 		m_event_queue.push(
@@ -314,7 +368,7 @@ void solarfield_availability::process_failure()
 				1. / end_time
 			)
 		);
-		m_field.m_helios.at(m_current_event.helio_id)->start_repair(m_current_event.time);
+		m_field.start_repair(m_current_event.helio_id, m_current_event.time);
 	}
 	else
 	{
@@ -331,22 +385,26 @@ void solarfield_availability::process_repair()
 
 	t_last -- time of last event [h]
 	*/
-	m_current_availability += m_settings.helio_performance[m_current_event.helio_id] / m_settings.sum_performance;
+	m_current_availability += m_helio_energy[m_current_event.helio_id] / m_settings.sum_performance;
 	m_results.n_repairs_per_component[m_current_event.component_idx] += 1;
-	m_results.repair_cost_per_year[int((m_current_event.time-DBL_EPSILON) / 8760)] += m_field.m_components.at(m_current_event.component_idx)->get_repair_cost();
-	m_field.m_helios.at(m_current_event.helio_id)->end_repair(
+	//the last event may fall after the end of the simulated period
+	int year = int((m_current_event.time-DBL_EPSILON) / 8760);
+	if (year < m_settings.n_years)
+		m_results.repair_cost_per_year[year] += m_field.m_components.at(m_current_event.component_idx).get_repair_cost();
+	m_field.end_repair(
+		m_current_event.helio_id,
 		m_current_event.time,
 		m_current_event.component_idx
 	);
 	solarfield_staff_member* staff = m_staff.get_assigned_member(m_current_event.helio_id);
 	staff->m_n_repairs_completed++;
-	solarfield_heliostat* hel = m_field.m_helios.at(m_current_event.helio_id);
-	hel->update_failure_time();
-	double fail_time = get_time_of_failure(m_current_event.time, hel->get_op_time_to_next_failure());
+	int h = m_current_event.helio_id;
+	m_field.update_failure_time(h);
+	double fail_time = get_time_of_failure(m_current_event.time, m_field.get_op_time_to_next_failure(h));
 	m_event_queue.push(
 		solarfield_event(
-			m_current_event.helio_id,
-			hel->get_next_component_to_fail(),
+			h,
+			m_field.get_next_component_to_fail(h),
 			false,
 			fail_time,
 			1. / fail_time
@@ -357,10 +415,10 @@ void solarfield_availability::process_repair()
 	{
 		//new repair assignment
 		solarfield_event e = m_repair_queue.top();
-		staff->assign_heliostat(e.helio_id);
+		staff = m_staff.reassign_member(m_current_event.helio_id, e.helio_id);
 		double end_time = get_time_of_repair(
 			m_current_event.time,
-			m_field.m_helios.at(e.helio_id)->get_repair_time(),
+			m_field.get_repair_time(e.helio_id),
 			staff
 		);
 		m_event_queue.push(
@@ -372,31 +430,28 @@ void solarfield_availability::process_repair()
 				1. / end_time
 			)
 		);
-		m_field.m_helios.at(e.helio_id)->start_repair(m_current_event.time);
+		m_field.start_repair(e.helio_id, m_current_event.time);
 		m_repair_queue_length -= 1;
 		m_repair_queue.pop();
 	}
 	else
 	{
-		staff->free();
+		m_staff.free_member(m_current_event.helio_id);
 	}
 }
 
-void solarfield_availability::run_current_event(double t_last)
+void solarfield_availability::run_current_event()
 {
 	/* 
-	Processes the current event in the event queue, by 
-	updating the field availability from the last event time
-	to the current event time, then processing either a failure
-	or repair.
-	
-	t_last -- time of last event [h]
+	Processes the current event in the event queue, either a failure
+	or repair, then records the field availability and repair queue 
+	length from the event time on.
 	*/
-	update_statistics(t_last, m_current_event.time);
 	if (m_current_event.is_repair)
 		process_repair();
 	else
 		process_failure();
+	update_statistics(m_current_event.time);
 }
 
 void solarfield_availability::add_repair_to_queue()
@@ -410,15 +465,15 @@ void solarfield_availability::add_repair_to_queue()
 	else if (m_settings.repair_order == RANDOM)
 		repair_priority = m_gen->getVariate();
 	else if (m_settings.repair_order == PERFORMANCE)
-		repair_priority = m_field.m_helios.at(m_current_event.helio_id)->get_performance();
+		repair_priority = m_field.get_performance(m_current_event.helio_id);
 	else if (m_settings.repair_order == REPAIR_TIME)
-		repair_priority = 1. / m_field.m_helios.at(m_current_event.helio_id)->get_repair_time();
+		repair_priority = 1. / m_field.get_repair_time(m_current_event.helio_id);
 	else if (m_settings.repair_order == MEAN_REPAIR_TIME)
-		repair_priority = 1. / m_field.m_components.at(m_current_event.component_idx)->get_mean_repair_time();
+		repair_priority = 1. / m_field.m_components.at(m_current_event.component_idx).get_mean_repair_time();
 	else if (m_settings.repair_order == PERF_OVER_MRT)
 		repair_priority = (
-			m_field.m_helios.at(m_current_event.helio_id)->get_performance() /
-			m_field.m_components.at(m_current_event.component_idx)->get_mean_repair_time()
+			m_field.get_performance(m_current_event.helio_id) /
+			m_field.m_components.at(m_current_event.component_idx).get_mean_repair_time()
 			);
 	else
 		throw std::runtime_error("invalid repair order");
@@ -432,41 +487,13 @@ void solarfield_availability::add_repair_to_queue()
 	m_repair_queue_length += 1;
 }
 
-void solarfield_availability::update_statistics(double t_start, double t_end)
+void solarfield_availability::update_statistics(double t)
 {
 	/* 
-	Updates time-series summary statistics between t_start and t_end. 
+	Records the field availability and repair queue length from time t 
+	on, for the time-series statistics built at the end of simulate().
 	*/
-	int idx = (int)t_start;
-
-	//if start and end occur in same timestep, just update one index of results
-	//and terminate.
-	if (idx == int(t_end))
-	{
-		m_results.avail_schedule[idx] += (t_end - t_start)*m_current_availability;
-		m_results.queue_size_vs_time[idx] += (t_end - t_start)*m_repair_queue_length;
-		return;
-	}
-
-	//otherwise, update the results at (i) the timestep containing t_start, 
-	// (ii) all those timesteps falling between t_start and t_end, and, 
-	// (iii) , the timestep containing t_end.
-	m_results.avail_schedule[idx] += (idx + 1 - t_start)*m_current_availability;
-	m_results.queue_size_vs_time[idx] += (idx + 1 - t_start)*m_repair_queue_length;
-	while (idx < (int)(t_end)-1 && idx < m_settings.n_years * 8760 -1)
-	{
-		idx++;
-		m_results.avail_schedule[idx] += m_current_availability;
-		m_results.queue_size_vs_time[idx] += m_repair_queue_length;
-	}
-
-	//only update the timestep containing t_end if t_end is not at the 
-	//boundary between two time periods.
-	if (t_end - int(t_end) > DBL_EPSILON)
-	{
-		m_results.avail_schedule[int(t_end)] += (t_end - (int)t_end)*m_current_availability;
-		m_results.queue_size_vs_time[int(t_end)] += (t_end - (int)t_end)*m_repair_queue_length;
-	}
+	m_levels.set(t, m_current_availability, (double)m_repair_queue_length);
 }
 
 
@@ -481,20 +508,22 @@ void solarfield_availability::simulate(bool(*)(float prg, const char *msg), std:
 
 	//--- Initialize results
 	initialize();
-	m_event_queue = create_initial_queue();
-	m_repair_queue = {};	
+	create_initial_queue();
 	
 	{
+		//take each event off the queue before running it, as running it 
+		//queues the next event of the same heliostat
 		double t = 0.;
-		while (t < (double)nhours)
+		while (t < (double)nhours && !m_event_queue.empty())
 		{
 			m_current_event = m_event_queue.top();
+			m_event_queue.pop();
 			//m_current_event.print();
-			run_current_event(t);
+			run_current_event();
 			t = m_current_event.time;
-			m_event_queue.pop();
 		}
 	}
+	m_levels.get_hourly(m_results.avail_schedule, m_results.queue_size_vs_time);
 
 	//----------------------------------------------------------
 		
@@ -523,9 +552,9 @@ void solarfield_availability::simulate(bool(*)(float prg, const char *msg), std:
 	double max_hours = 0.;
 	for (size_t s = 0; s < m_staff.m_members.size(); s++)
 	{
-		hours_worked += m_staff.m_members[s]->m_hours_worked;
-		repairs_made += m_staff.m_members[s]->m_n_repairs_completed*problem_scale;
-		max_hours += m_staff.m_members[s]->m_fraction * m_settings.n_years * m_settings.max_hours_per_week * (8760. / 168.);
+		hours_worked += m_staff.m_members[s].m_hours_worked;
+		repairs_made += m_staff.m_members[s].m_n_repairs_completed*problem_scale;
+		max_hours += m_staff.m_members[s].m_fraction * m_settings.n_years * m_settings.max_hours_per_week * (8760. / 168.);
 	}
 
 	m_results.n_repairs = repairs_made;
@@ -537,7 +566,7 @@ void solarfield_availability::simulate(bool(*)(float prg, const char *msg), std:
 	if (m_settings.is_tracking)
 	{
 		for (size_t s = 0; s < m_staff.m_members.size(); s++)
-			m_results.staff_time.push_back(m_staff.m_members[s]->m_hours_worked);
+			m_results.staff_time.push_back(m_staff.m_members[s].m_hours_worked);
 	}
 	
 
@@ -561,10 +590,10 @@ void solarfield_availability::simulate(bool(*)(float prg, const char *msg), std:
 		//summary
 		ofs << "hrs_worked";
 		for (size_t s = 0; s< m_staff.m_members.size(); s++)
-			ofs << "," << m_staff.m_members.at(s)->m_hours_worked;
+			ofs << "," << m_staff.m_members.at(s).m_hours_worked;
 		ofs << "\nrepairs";
 		for (size_t s = 0; s< m_staff.m_members.size(); s++)
-			ofs << "," << m_staff.m_members.at(s)->m_n_repairs_completed*problem_scale;
+			ofs << "," << m_staff.m_members.at(s).m_n_repairs_completed*problem_scale;
 		ofs << "\n";
 		ofs << "\n";
 
@@ -630,3 +659,171 @@ void solarfield_availability::simulate(bool(*)(float prg, const char *msg), std:
 	m_sim_available = true;
 }
 
+static void add_series(std::vector<double> &sum, const std::vector<double> &x, bool first)
+{
+	if (first)
+		sum = x;
+	else
+		for (size_t i = 0; i < sum.size() && i < x.size(); i++)
+			sum[i] += x[i];
+}
+
+static void add_series(std::vector<std::vector<double>> &sum, const std::vector<std::vector<double>> &x, bool first)
+{
+	if (first)
+		sum = x;
+	else
+		for (size_t i = 0; i < sum.size() && i < x.size(); i++)
+			add_series(sum[i], x[i], false);
+}
+
+static void divide_series(std::vector<double> &sum, double n)
+{
+	for (size_t i = 0; i < sum.size(); i++)
+		sum[i] /= n;
+}
+
+void solarfield_availability::simulate_replications(int n_threads)
+{
+	/*
+	Simulates m_settings.n_replications independent realisations of the 
+	field, up to n_threads at a time, and sets m_results to their means, 
+	with the half-widths of the confidence intervals of the scalar results 
+	at level m_settings.ci_level (not a number for a single realisation).  
+	Each realisation runs on its own copy of the field and staff, with a 
+	generator set to substream r of stream m_settings.seed; substream 0 is the state set by assignStates(seed), 
+	so a single replication gives the same results as initialize() and 
+	simulate() with a generator reset to the seed, as the staff 
+	optimization has always run them.  Realisations are added in order, so the 
+	results do not depend on n_threads.  min_avail is the minimum over all 
+	realisations.  The field and staff of this object are left as they are.
+	n_threads -- maximum number of realisations simulated at once
+	*/
+	if (!(m_settings.ci_level > 0. && m_settings.ci_level < 1.))
+		throw std::runtime_error("Confidence level of the field availability results must be between 0 and 1");
+	//the realisations run on copies of the settings; set the field total here, as create_helio_field does
+	sample_heliostats(m_settings.n_helio_sim);
+
+	int nrep = std::max(1, m_settings.n_replications);
+	int nthreads = std::max(1, std::min(n_threads, nrep));
+	//few realisations are typical, so the intervals use Student's t quantile;
+	//a single realisation gives no interval
+	double z = nrep > 1 ? StudentTCDFInverse(0.5 + 0.5 * m_settings.ci_level, nrep - 1) :
+		std::numeric_limits<double>::quiet_NaN();
+
+	//results of the realisations simulated but not yet added
+	std::vector< solarfield_results > results(nrep);
+	std::vector< bool > done(nrep, false);
+	std::vector< std::exception_ptr > errors(nthreads);
+	std::mutex rep_mutex;
+	std::condition_variable rep_done;
+	int next = 0;     //next realisation to simulate
+	int next_add = 0; //next realisation to add to the means
+	bool failed = false;
+	MeanEstimate avail_est, repairs_est, utilization_est, cost_est;
+	double min_avail = 1.;
+
+	auto worker = [&](int w)
+	{
+		try
+		{
+			while (true)
+			{
+				int r;
+				{
+					std::unique_lock<std::mutex> lock(rep_mutex);
+					//hold at most nthreads realisations ahead of the next one added
+					while (!failed && next < nrep && next >= next_add + nthreads)
+						rep_done.wait(lock);
+					if (failed || next >= nrep)
+						break;
+					r = next++;
+				}
+
+				solarfield_availability sfa;
+				sfa.m_settings = m_settings;
+				WELLFiveTwelve gen(0);
+				gen.assignSubstream(m_settings.seed, (uint64_t)r);
+				sfa.assign_generator(gen);
+				sfa.initialize();
+				sfa.simulate();
+
+				std::lock_guard<std::mutex> lock(rep_mutex);
+				results.at(r) = std::move(sfa.m_results);
+				done.at(r) = true;
+				for (; next_add < nrep && done.at(next_add); next_add++)
+				{
+					const solarfield_results &x = results.at(next_add);
+					bool first = next_add == 0;
+					double repair_cost = 0.;
+					for (size_t y = 0; y < x.repair_cost_per_year.size(); y++)
+						repair_cost += x.repair_cost_per_year[y];
+					avail_est.Add(x.avg_avail, 1., true);
+					repairs_est.Add(x.n_repairs, 1., true);
+					utilization_est.Add(x.staff_utilization, 1., true);
+					cost_est.Add(repair_cost, 1., true);
+					min_avail = std::min(min_avail, x.min_avail);
+
+					add_series(m_results.avail_schedule, x.avail_schedule, first);
+					add_series(m_results.yearly_avg_avail, x.yearly_avg_avail, first);
+					add_series(m_results.n_repairs_per_component, x.n_repairs_per_component, first);
+					add_series(m_results.n_failures_per_component, x.n_failures_per_component, first);
+					add_series(m_results.repair_cost_per_year, x.repair_cost_per_year, first);
+					add_series(m_results.staff_time, x.staff_time, first);
+					add_series(m_results.failures_per_year, x.failures_per_year, first);
+					add_series(m_results.repair_time_per_year, x.repair_time_per_year, first);
+					add_series(m_results.queue_size_vs_time, x.queue_size_vs_time, first);
+					results.at(next_add) = solarfield_results();
+				}
+				rep_done.notify_all();
+			}
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(rep_mutex);
+			errors.at(w) = std::current_exception();
+			failed = true;
+			rep_done.notify_all();
+		}
+	};
+
+	if (nthreads == 1)
+		worker(0);
+	else
+	{
+		std::vector< std::thread > threads;
+		for (int w = 0; w < nthreads; w++)
+			threads.push_back(std::thread(worker, w));
+		for (size_t w = 0; w < threads.size(); w++)
+			threads.at(w).join();
+	}
+	for (int w = 0; w < nthreads; w++)
+	{
+		if (errors.at(w))
+			std::rethrow_exception(errors.at(w));
+	}
+
+	double n = (double)nrep;
+	divide_series(m_results.avail_schedule, n);
+	divide_series(m_results.yearly_avg_avail, n);
+	divide_series(m_results.n_repairs_per_component, n);
+	divide_series(m_results.n_failures_per_component, n);
+	divide_series(m_results.repair_cost_per_year, n);
+	divide_series(m_results.staff_time, n);
+	for (size_t i = 0; i < m_results.failures_per_year.size(); i++)
+		divide_series(m_results.failures_per_year[i], n);
+	for (size_t i = 0; i < m_results.repair_time_per_year.size(); i++)
+		divide_series(m_results.repair_time_per_year[i], n);
+	divide_series(m_results.queue_size_vs_time, n);
+
+	m_results.avg_avail = avail_est.GetMean();
+	m_results.min_avail = min_avail;
+	m_results.n_repairs = repairs_est.GetMean();
+	m_results.staff_utilization = utilization_est.GetMean();
+
+	m_results.n_replications = nrep;
+	m_results.avg_avail_ci = z * avail_est.GetStandardError();
+	m_results.n_repairs_ci = z * repairs_est.GetStandardError();
+	m_results.staff_utilization_ci = z * utilization_est.GetStandardError();
+	m_results.repair_cost_ci = z * cost_est.GetStandardError();
+}
@@ -1,5 +1,6 @@
 #include "solarfield_heliostat.h"
 #include <iostream>
+#include <stdexcept>
 
 helio_component_inputs::helio_component_inputs()
 {
@@ -94,158 +95,190 @@ double solarfield_helio_component::get_repair_cost()
 
 
 
-solarfield_heliostat::solarfield_heliostat()
+heliostat_field::heliostat_field()
 {
-	m_status = OPERATIONAL;
-	m_n_components = 0;
-
-	m_scale = 1.0;
-	m_performance = 1.0;
-
-	m_time_repairing = 0.0;
-	m_time_failed = 0.0;
-	m_time_operating = 0.0;
+	clear();
+}
 
+void heliostat_field::clear()
+{
+	m_n_helios = 0;
+	m_n_components = 0;
+	m_components.clear();
+
+	m_status.clear();
+	m_scale.clear();
+	m_performance.clear();
+	m_time_operating.clear();
+	m_time_repairing.clear();
+	m_time_failed.clear();
+	m_time_of_last_event.clear();
+	m_time_to_next_failure.clear();
+	m_next_component_to_fail.clear();
+	m_repair_time.clear();
+
+	m_lifetimes.clear();
 	m_n_failures.clear();
 	m_n_repairs.clear();
 
 	m_is_track_repair_time = false;
 	m_repair_time_per_component.clear();
-
 }
 
-
-void solarfield_heliostat::initialize(std::vector<solarfield_helio_component*> components, WELLFiveTwelve &gen, double scale, double performance)
+void heliostat_field::add_component(const helio_component_inputs &inputs)
 {
-	m_n_components = (int)components.size();
-	m_status = OPERATIONAL;
-	m_scale = scale;
-	m_performance = performance;
-
-	m_time_repairing = 0.0;
-	m_time_failed = 0.0;
-	m_time_operating = 0.0;
-
-	m_n_failures.assign(m_n_components, 0);
-	m_n_repairs.assign(m_n_components, 0);
+	if (m_n_helios > 0)
+		throw std::runtime_error("components must be added before the heliostats.");
+	m_components.push_back(solarfield_helio_component(inputs));
+	m_n_components = (int)m_components.size();
+}
 
-	m_components = components;
-	m_lifetimes.assign(m_n_components, 0);
-	for (int c = 0; c < m_n_components; c++)
+void heliostat_field::add_heliostats(int n_heliostats, WELLFiveTwelve &gen, double scale, const std::vector<double> &performance)
+{
+	/*
+	Adds new heliostats, drawing the lifetimes of their components in 
+	order of heliostat, then component.
+	n_heliostats -- number of heliostats to add
+	gen -- generator of the lifetimes
+	scale -- number of heliostats each heliostat represents
+	performance -- performance metric of each heliostat added
+	*/
+	int h0 = m_n_helios;
+	m_n_helios += n_heliostats;
+	size_t nh = (size_t)m_n_helios;
+	size_t nc = (size_t)m_n_components;
+
+	m_status.resize(nh, OPERATIONAL);
+	m_scale.resize(nh, scale);
+	m_performance.resize(nh);
+	m_time_operating.resize(nh, 0.);
+	m_time_repairing.resize(nh, 0.);
+	m_time_failed.resize(nh, 0.);
+	m_time_of_last_event.resize(nh, 0.);
+	m_time_to_next_failure.resize(nh, 0.);
+	m_next_component_to_fail.resize(nh, 0);
+	m_repair_time.resize(nh, 0.);
+
+	m_lifetimes.resize(nh * nc, 0.);
+	m_n_failures.resize(nh * nc, 0);
+	m_n_repairs.resize(nh * nc, 0);
+	if (m_is_track_repair_time)
+		m_repair_time_per_component.resize(nh * nc, 0.);
+
+	for (int h = h0; h < m_n_helios; h++)
 	{
-		m_lifetimes[c] = m_components.at(c)->gen_lifetime(0, gen);
+		m_performance[h] = performance.at(h - h0);
+		double *lifetimes = &m_lifetimes[h * nc];
+		for (size_t c = 0; c < nc; c++)
+			lifetimes[c] = m_components[c].gen_lifetime(0, gen);
+		update_failure_time(h);
 	}
-
-	update_failure_time();
-	
-	return;
 }
 
-void solarfield_heliostat::initialize_repair_time_tracking()
+void heliostat_field::initialize_repair_time_tracking()
 {
 	m_is_track_repair_time = true;
-	m_repair_time_per_component.resize(m_n_components);
+	m_repair_time_per_component.resize((size_t)m_n_helios * m_n_components, 0.);
 }
 
 
 
-int solarfield_heliostat::get_n_components()
+int heliostat_field::get_n_heliostats()
 {
-	return m_n_components;
+	return m_n_helios;
 }
 
-unsigned int solarfield_heliostat::get_operational_state()
+int heliostat_field::get_n_components()
 {
-	return m_status;
+	return m_n_components;
 }
 
-double solarfield_heliostat::get_performance()
+unsigned int heliostat_field::get_operational_state(int h)
 {
-	return m_performance;
+	return m_status[h];
 }
 
-double solarfield_heliostat::get_op_time_to_next_failure()
+double heliostat_field::get_performance(int h)
 {
-	return m_time_to_next_failure;
+	return m_performance[h];
 }
 
-void solarfield_heliostat::update_failure_time()
+double heliostat_field::get_op_time_to_next_failure(int h)
 {
-	m_next_component_to_fail = 0;
-	m_time_to_next_failure = m_lifetimes.at(0);
-	for (int i=1; i<m_n_components; i++)
-		if (m_lifetimes.at(i) < m_time_to_next_failure)
-		{
-			m_time_to_next_failure = m_lifetimes.at(i);
-			m_next_component_to_fail = i;
-		}
-	//std::cerr << "heliostat fail time: " << m_time_to_next_failure << "\n";
+	return m_time_to_next_failure[h];
 }
 
-unsigned int solarfield_heliostat::get_next_component_to_fail()
+void heliostat_field::update_failure_time(int h)
 {
-	return m_next_component_to_fail;
+	const double *lifetimes = &m_lifetimes[(size_t)h * m_n_components];
+	int next = 0;
+	for (int i = 1; i < m_n_components; i++)
+		if (lifetimes[i] < lifetimes[next])
+			next = i;
+	m_next_component_to_fail[h] = next;
+	m_time_to_next_failure[h] = lifetimes[next];
 }
 
-std::vector<solarfield_helio_component*>  solarfield_heliostat::get_components()
+unsigned int heliostat_field::get_next_component_to_fail(int h)
 {
-	return m_components;
+	return m_next_component_to_fail[h];
 }
 
-double solarfield_heliostat::get_repair_time()
+double heliostat_field::get_repair_time(int h)
 {
-	return m_repair_time;
+	return m_repair_time[h];
 }
 
-void solarfield_heliostat::fail(double time, WELLFiveTwelve &gen)
+void heliostat_field::fail(int h, double time, WELLFiveTwelve &gen)
 {
-	m_status = FAILED;
-	m_time_operating += m_time_to_next_failure;
-	m_n_failures[m_next_component_to_fail] += 1;
+	size_t row = (size_t)h * m_n_components;
+	int next = m_next_component_to_fail[h];
+	double ttf = m_time_to_next_failure[h];
+	m_status[h] = FAILED;
+	m_time_operating[h] += ttf;
+	m_n_failures[row + next] += 1;
 	
+	double *lifetimes = &m_lifetimes[row];
 	for (int c = 0; c < m_n_components; c++)
-		m_lifetimes[c] -= m_time_to_next_failure;
+		lifetimes[c] -= ttf;
 
-	m_time_of_last_event = time;
-	m_lifetimes[m_next_component_to_fail] = m_components.at(m_next_component_to_fail)->gen_lifetime(m_time_operating, gen);
-	m_repair_time = m_components.at(m_next_component_to_fail)->gen_repair_time(gen) * m_scale;  //assume block of m_scale heliostats repaired in series with identical repair times.
-	update_failure_time();
+	m_time_of_last_event[h] = time;
+	lifetimes[next] = m_components[next].gen_lifetime(m_time_operating[h], gen);
+	m_repair_time[h] = m_components[next].gen_repair_time(gen) * m_scale[h];  //assume block of m_scale heliostats repaired in series with identical repair times.
+	update_failure_time(h);
 }
 
-void solarfield_heliostat::start_repair(double time)
+void heliostat_field::start_repair(int h, double time)
 {
-	m_status = REPAIRING;
-	m_time_failed += (time - m_time_of_last_event);
-	m_time_of_last_event = time;	
+	m_status[h] = REPAIRING;
+	m_time_failed[h] += (time - m_time_of_last_event[h]);
+	m_time_of_last_event[h] = time;	
 }
 
-void solarfield_heliostat::end_repair(double time, int)
+void heliostat_field::end_repair(int h, double time, int idx)
 {
-	m_status = OPERATIONAL;
-	m_repair_time = 0.;
-	m_time_repairing += (time - m_time_of_last_event);
-	m_time_of_last_event = time;
+	m_status[h] = OPERATIONAL;
+	m_repair_time[h] = 0.;
+	m_n_repairs[(size_t)h * m_n_components + idx] += 1;
+	m_time_repairing[h] += (time - m_time_of_last_event[h]);
+	m_time_of_last_event[h] = time;
 }
 
-std::vector<int> solarfield_heliostat::get_failures_per_component()
+std::vector<int> heliostat_field::get_failures_per_component(int h)
 {
-	return m_n_failures;
+	std::vector<int>::const_iterator row = m_n_failures.begin() + (size_t)h * m_n_components;
+	return std::vector<int>(row, row + m_n_components);
 }
 
-std::vector<int> solarfield_heliostat::get_repairs_per_component()
+std::vector<int> heliostat_field::get_repairs_per_component(int h)
 {
-	return m_n_repairs;
+	std::vector<int>::const_iterator row = m_n_repairs.begin() + (size_t)h * m_n_components;
+	return std::vector<int>(row, row + m_n_components);
 }
 
-std::vector<double>* solarfield_heliostat::get_repair_time_tracking()
+const double* heliostat_field::get_repair_time_tracking(int h)
 {
-	return &m_repair_time_per_component;
+	if (!m_is_track_repair_time)
+		return NULL;
+	return &m_repair_time_per_component[(size_t)h * m_n_components];
 }
-
-
-void heliostat_field::add_component(const helio_component_inputs &inputs)
-{
-	solarfield_helio_component *comp = new solarfield_helio_component(inputs);
-	m_components.push_back(comp);
-	return;
-}
\ No newline at end of file
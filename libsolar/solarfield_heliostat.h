@@ -69,90 +69,65 @@ public:
 
 
 
-class solarfield_heliostat
+/*
+The heliostats of the field, stored as one array per attribute, indexed by 
+heliostat (and by heliostat and component for the per-component 
+attributes, at [h * n_components + c]), so the simulation of large fields 
+reads contiguous memory rather than one object per heliostat.  The 
+components are shared by all heliostats.
+*/
+class heliostat_field
 {
-private:
-	std::vector<int> m_n_failures;							// Total number of failures per component
-	std::vector<int> m_n_repairs;							// Total number of repairs completed per component
-	std::vector<double> m_lifetimes;   
-	std::vector<solarfield_helio_component*> m_components;
-	WELLFiveTwelve* m_gen;
-
-	unsigned int m_status;				// Current operational state 
-	int m_n_components;					// Number of components	
-
-	double m_scale;						// Heliostat scale (i.e number of heliostats this heliostat represents)
-	double m_output;                    // annual energy output
-	double m_performance;				// Performance metric (i.e. annual energy output) that can be used to prioritize repair
-
-	double m_time_operating;			// Total time operational [hr]
-	double m_time_repairing;			// Total time spent being repaired [hr]
-	double m_time_failed;				// Total time spent waiting to be repaired [hr]
-
-	double m_time_of_last_event;        // Time at last failure, repair start, 
-										// or repair end - used to track waiting time
-	double m_time_to_next_failure;      // Time to next failure - used for event generation
-	int m_next_component_to_fail;       // Used for event generation
-	double m_repair_time;               // Repair time - used for event generation
+	int m_n_helios;							// Number of heliostats
+	int m_n_components;						// Number of components per heliostat
+
+	std::vector<unsigned int> m_status;		// Current operational state 
+	std::vector<double> m_scale;			// Heliostat scale (i.e number of heliostats each heliostat represents)
+	std::vector<double> m_performance;		// Performance metric (i.e. annual energy output) that can be used to prioritize repair
+
+	std::vector<double> m_time_operating;		// Total time operational [hr]
+	std::vector<double> m_time_repairing;		// Total time spent being repaired [hr]
+	std::vector<double> m_time_failed;			// Total time spent waiting to be repaired [hr]
+	std::vector<double> m_time_of_last_event;	// Time at last failure, repair start, 
+												// or repair end - used to track waiting time
+	std::vector<double> m_time_to_next_failure;	// Time to next failure - used for event generation
+	std::vector<int> m_next_component_to_fail;	// Used for event generation
+	std::vector<double> m_repair_time;			// Repair time - used for event generation
+
+	// By heliostat and component
+	std::vector<double> m_lifetimes;		// Remaining operating life [hr]
+	std::vector<int> m_n_failures;			// Total number of failures
+	std::vector<int> m_n_repairs;			// Total number of repairs completed
 
 	bool m_is_track_repair_time;
 	std::vector<double> m_repair_time_per_component;
 
 public:
+	std::vector<solarfield_helio_component> m_components;
 
-	solarfield_heliostat();
-	~solarfield_heliostat(){};
-
-	void initialize(std::vector<solarfield_helio_component*> components, WELLFiveTwelve &gen, double scale = 1.0, double performance = 1.0);
-
-	int get_n_components();
-	unsigned int get_operational_state();
-	double get_performance();
-	double get_op_time_to_next_failure();
-	void update_failure_time();
-	unsigned int get_next_component_to_fail();
-	std::vector<solarfield_helio_component*> get_components();
-	double get_repair_time();
-
-	void fail(double time, WELLFiveTwelve &gen);
-	void start_repair(double time);
-	void end_repair(double time, int idx);
-
-	std::vector<int> get_failures_per_component();
-	std::vector<int> get_repairs_per_component();
+	heliostat_field();
 
+	void clear();
+	void add_component(const helio_component_inputs &inputs);
+	void add_heliostats(int n_heliostats, WELLFiveTwelve &gen, double scale, const std::vector<double> &performance);
 	void initialize_repair_time_tracking();
-	std::vector<double>* get_repair_time_tracking();
-
-};
-
 
-
-
-
-
-
-
-
-class heliostat_field
-{
-
-public:
-	std::vector<solarfield_heliostat *> m_helios;
-	std::vector<solarfield_helio_component *>  m_components;
-
-	heliostat_field() {};
-	~heliostat_field()
-	{
-		for (size_t i = 0; i < m_helios.size(); i++)
-			delete(m_helios[i]);
-		m_helios.clear();
-		for (size_t i = 0; i < m_components.size(); i++)
-			delete(m_components[i]);
-		m_components.clear();
-	};
-
-	void add_component(const helio_component_inputs &inputs);
+	int get_n_heliostats();
+	int get_n_components();
+	unsigned int get_operational_state(int h);
+	double get_performance(int h);
+	double get_op_time_to_next_failure(int h);
+	void update_failure_time(int h);
+	unsigned int get_next_component_to_fail(int h);
+	double get_repair_time(int h);
+
+	void fail(int h, double time, WELLFiveTwelve &gen);
+	void start_repair(int h, double time);
+	void end_repair(int h, double time, int idx);
+
+	std::vector<int> get_failures_per_component(int h);
+	std::vector<int> get_repairs_per_component(int h);
+	const double* get_repair_time_tracking(int h);
 };
 
 
@@ -1,6 +1,11 @@
 #include "./solarfield_opt.h"
 #include "./solarfield_avail.h"
 #include <iostream>
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 void solarfield_opt::initialize()
 {
@@ -9,22 +14,37 @@ void solarfield_opt::initialize()
 
 double solarfield_opt::calculate_rev_loss()
 {
-	double ann_revenue = m_sfa.m_settings.sum_performance * m_settings.price_per_kwh * m_settings.system_efficiency;
+	return calculate_rev_loss(m_sfa);
+}
+
+double solarfield_opt::calculate_labor_cost()
+{
+	return calculate_labor_cost(m_sfa);
+}
+
+double solarfield_opt::calculate_repair_cost()
+{
+	return calculate_repair_cost(m_sfa);
+}
+
+double solarfield_opt::calculate_rev_loss(const solarfield_availability &sfa)
+{
+	double ann_revenue = sfa.m_settings.sum_performance * m_settings.price_per_kwh * m_settings.system_efficiency;
 	double factor = 1.0;
 	double rev_loss = 0.;
-	for (size_t t = 0; t < m_sfa.m_settings.n_years; t++)
+	for (size_t t = 0; t < sfa.m_settings.n_years; t++)
 	{
-		rev_loss += ann_revenue * factor * (1-m_sfa.m_results.yearly_avg_avail[t]);
+		rev_loss += ann_revenue * factor * (1-sfa.m_results.yearly_avg_avail[t]);
 		factor *= (1.0 - m_settings.revenue_discount_rate);
 	}
 	return rev_loss;
 }
 
-double solarfield_opt::calculate_labor_cost()
+double solarfield_opt::calculate_labor_cost(const solarfield_availability &sfa)
 {
-	double ann_cost = 52 * m_sfa.m_settings.max_hours_per_week * m_settings.hourly_cost_per_staff * m_sfa.m_settings.n_om_staff;
+	double ann_cost = 52 * sfa.m_settings.max_hours_per_week * m_settings.hourly_cost_per_staff * sfa.m_settings.n_om_staff;
 	double total_cost = 0.;
-	for (size_t t = 0; t < m_sfa.m_settings.n_years; t++)
+	for (size_t t = 0; t < sfa.m_settings.n_years; t++)
 	{
 		total_cost += ann_cost;
 		ann_cost *= (1.0 - m_settings.labor_discount_rate);
@@ -32,13 +52,13 @@ double solarfield_opt::calculate_labor_cost()
 	return total_cost;
 }
 
-double solarfield_opt::calculate_repair_cost()
+double solarfield_opt::calculate_repair_cost(const solarfield_availability &sfa)
 {
 	double factor = 1.0;
 	double total_cost = 0.;
-	for (size_t t = 0; t < m_sfa.m_settings.n_years; t++)
+	for (size_t t = 0; t < sfa.m_settings.n_years; t++)
 	{
-		total_cost += factor * m_sfa.m_results.repair_cost_per_year[t];
+		total_cost += factor * sfa.m_results.repair_cost_per_year[t];
 		factor *= (1.0 - m_settings.repair_discount_rate);
 	}
 	return total_cost;
@@ -46,24 +66,106 @@ double solarfield_opt::calculate_repair_cost()
 
 void solarfield_opt::optimize_staff(bool(*)(float prg, const char *msg), std::string *)
 {
-	WELLFiveTwelve gen(0);
-	gen.assignStates(m_sfa.m_settings.seed % 100);
-	m_sfa.assign_generator(gen);
-	double total_cost;
+	/*
+	Finds the number of O&M staff that minimizes the sum of lost revenue, 
+	labor cost and repair cost, by simulating 1, 2, 3, ... staff until the 
+	total cost increases.  Each staff level is simulated by 
+	m_sfa.simulate_replications, with generators reset to the same seed, 
+	so the levels are independent and the costs are those of the mean 
+	results over m_sfa.m_settings.n_replications realisations.  The 
+	threads go to the replications of a level first; with threads left, 
+	levels beyond the last one compared are simulated at once on separate 
+	copies of the field, and the costs are compared in increasing order of 
+	staff, so the result is the same as that of the serial scan.  On 
+	return, m_results holds the results of the optimal level, and 
+	m_sfa.m_settings.n_om_staff the optimal number of staff.
+	*/
+	int max_staff = m_settings.max_num_staff;
+	int rep_threads = std::max(1, std::min(m_settings.n_threads, m_sfa.m_settings.n_replications));
+	int nthreads = std::max(1, std::min(m_settings.n_threads / rep_threads, max_staff));
+
+	//results of the levels simulated but not yet compared, by staff level
+	std::vector< solarfield_results > results(std::max(max_staff, 0) + 1);
+	std::vector< double > costs(results.size(), 0.);
+	std::vector< bool > done(results.size(), false);
+	std::vector< std::exception_ptr > errors(nthreads);
+	std::mutex scan_mutex;
+	std::condition_variable level_done;
+	int next = 1;             //next staff level to simulate
+	int next_compare = 1;     //next staff level to compare
+	int stop = max_staff + 1; //levels from here on are not simulated
+	int best = 0;
 	double best_cost = INFINITY;
-	m_sfa.m_settings.n_om_staff = 1;
-	while (m_sfa.m_settings.n_om_staff <= m_settings.max_num_staff)
+	bool failed = false;
+
+	auto worker = [&](int w)
 	{
-		gen.assignStates(m_sfa.m_settings.seed % 100);
-		m_sfa.initialize();
-		m_sfa.simulate();
-		total_cost = calculate_rev_loss() + calculate_labor_cost() + calculate_repair_cost();
-		if (total_cost > best_cost)
-			break;
-		best_cost = total_cost;
-		m_results = m_sfa.m_results;
-		m_sfa.m_settings.n_om_staff++;
+		try
+		{
+			while (true)
+			{
+				int n_staff;
+				{
+					std::unique_lock<std::mutex> lock(scan_mutex);
+					while (!failed && next < stop && next >= next_compare + nthreads)
+						level_done.wait(lock);
+					if (failed || next >= stop)
+						break;
+					n_staff = next++;
+				}
+
+				solarfield_availability sfa;
+				sfa.m_settings = m_sfa.m_settings;
+				sfa.m_settings.n_om_staff = n_staff;
+				sfa.simulate_replications(rep_threads);
+				double total_cost = calculate_rev_loss(sfa) + calculate_labor_cost(sfa) + calculate_repair_cost(sfa);
+
+				std::lock_guard<std::mutex> lock(scan_mutex);
+				results.at(n_staff) = std::move(sfa.m_results);
+				costs.at(n_staff) = total_cost;
+				done.at(n_staff) = true;
+				for (; next_compare < stop && done.at(next_compare); next_compare++)
+				{
+					if (costs.at(next_compare) > best_cost)
+					{
+						//keep the last level simulated by the serial scan in m_sfa
+						m_sfa.m_results = std::move(results.at(next_compare));
+						stop = next_compare;
+						break;
+					}
+					best_cost = costs.at(next_compare);
+					best = next_compare;
+					m_results = std::move(results.at(next_compare));
+				}
+				level_done.notify_all();
+			}
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(scan_mutex);
+			errors.at(w) = std::current_exception();
+			failed = true;
+			level_done.notify_all();
+		}
+	};
+
+	if (nthreads == 1)
+		worker(0);
+	else
+	{
+		std::vector< std::thread > threads;
+		for (int w = 0; w < nthreads; w++)
+			threads.push_back(std::thread(worker, w));
+		for (size_t w = 0; w < threads.size(); w++)
+			threads.at(w).join();
+	}
+	for (int w = 0; w < nthreads; w++)
+	{
+		if (errors.at(w))
+			std::rethrow_exception(errors.at(w));
 	}
-	m_sfa.m_settings.n_om_staff--;  //this is the optimal number of staff to be output
 
-}
\ No newline at end of file
+	if (stop > max_staff && best > 0)
+		m_sfa.m_results = m_results;
+	m_sfa.m_settings.n_om_staff = best;  //this is the optimal number of staff to be output
+}
@@ -18,6 +18,9 @@ public:
 	double calculate_rev_loss();
 	double calculate_labor_cost();
 	double calculate_repair_cost();
+	double calculate_rev_loss(const solarfield_availability &sfa);
+	double calculate_labor_cost(const solarfield_availability &sfa);
+	double calculate_repair_cost(const solarfield_availability &sfa);
 	void optimize_staff(bool(*callback)(float prg, const char *msg) = 0, std::string *results_file_name = 0);
 
 };
@@ -1,5 +1,6 @@
 
 #include <algorithm>
+#include <cmath>
 #include "solarfield_staff.h"
 
 
@@ -18,7 +19,8 @@ void solarfield_staff_member::initialize(double max_hours_per_day, double max_ho
 	m_n_repairs_started = 0;
 	m_max_hours_per_day = max_hours_per_day;
 	m_max_hours_per_week = fmin(7 * max_hours_per_day, max_hours_per_week);
-	m_helio_assigned = NULL;
+	m_fraction = 1.0;
+	m_helio_assigned = -1;
 	free();
 }
 
@@ -41,6 +43,78 @@ void solarfield_staff_member::add_time_worked(double time)
 	return;
 }
 
+double solarfield_staff_member::schedule_repair(double t_start, double repair_time)
+{
+	/*
+	Books a repair starting at t_start, and updates the daily and weekly 
+	hours worked through its end.  The repair takes the hours available 
+	today, then those of each following day, up to the daily and weekly 
+	limits.  Whole weeks in which the repair cannot end take the weekly 
+	limit each and are skipped at once, so the cost does not grow with 
+	the repair time.
+	t_start -- start time of the repair [h]
+	repair_time -- labor time of the repair [h]
+	retval -- time of repair completion [h]
+	*/
+	//try to finish today
+	double hours_left_today = 24 - remainder(t_start, 24.);
+	double hours_today = fmin(get_time_available(), hours_left_today);
+	if (repair_time <= hours_today)
+	{
+		m_hours_this_week += repair_time;
+		m_hours_today += repair_time;
+		return t_start + repair_time;
+	}
+	if (m_max_hours_per_day <= 0. || m_max_hours_per_week <= 0.)
+		throw std::runtime_error("staff member has no working hours for a repair.");
+
+	//advance through the days left this week, updating daily and weekly 
+	//labor, then through whole weeks; stop when the available working hours 
+	//of a day exceed the remaining repair time.
+	double t_end = t_start + hours_left_today;
+	double repair_remaining = repair_time - hours_today;
+	double week_labor = get_time_available_week() - hours_today;
+	int days_left = (int)remainder(t_end, 168) / 24;
+	while (true)
+	{
+		for (int i = 0; i < days_left; i++)
+		{
+			double day_labor = fmin(week_labor, m_max_hours_per_day);
+			if (repair_remaining < day_labor)
+			{
+				m_hours_this_week = m_max_hours_per_week - week_labor + repair_remaining;
+				m_hours_today = repair_remaining;
+				add_time_worked(repair_time);
+				return t_end + repair_remaining;
+			}
+			week_labor -= day_labor;
+			repair_remaining -= day_labor;
+			t_end += 24;
+		}
+		//a whole week holds m_max_hours_per_week (at most 7 days of the 
+		//daily limit), so the repair ends in the first week that starts 
+		//with less than that remaining
+		if (repair_remaining >= m_max_hours_per_week)
+		{
+			double weeks = floor(repair_remaining / m_max_hours_per_week);
+			repair_remaining -= weeks * m_max_hours_per_week;
+			if (repair_remaining < 0.)
+			{
+				weeks -= 1.;
+				repair_remaining += m_max_hours_per_week;
+			}
+			else if (repair_remaining >= m_max_hours_per_week)
+			{
+				weeks += 1.;
+				repair_remaining -= m_max_hours_per_week;
+			}
+			t_end += 168. * weeks;
+		}
+		days_left = 7;
+		week_labor = m_max_hours_per_week;
+	}
+}
+
 void solarfield_staff_member::assign_heliostat(int helio_id)
 {
 	m_busy = true;
@@ -67,31 +141,41 @@ int solarfield_staff_member::get_assigned_heliostat()
 
 solarfield_repair_staff::solarfield_repair_staff()
 {
-	m_members.clear();
 	m_is_prioritize_partial_repairs = true;
-	m_n_staff = 0;
 	m_max_hours_per_day = std::numeric_limits<double>::quiet_NaN();
 	m_max_hours_per_week = std::numeric_limits<double>::quiet_NaN();
+	clear();
+};
 
+void solarfield_repair_staff::clear()
+{
+	m_members.clear();
+	m_idle = std::priority_queue<int, std::vector<int>, std::greater<int> >();
+	m_member_of_helio.clear();
+	m_n_staff = 0;
 	m_total_repair_length = 0;
 	m_total_repair_time = 0.0;
-};
+}
+
+void solarfield_repair_staff::add_member(double max_per_day, double max_per_week)
+{
+	/* adds an idle member, with the given daily and weekly limits on hours worked. */
+	m_members.push_back(solarfield_staff_member());
+	m_members.back().initialize(max_per_day, max_per_week);
+	m_idle.push((int)m_members.size() - 1);
+	m_n_staff = (int)m_members.size();
+}
 
 bool solarfield_repair_staff::is_staff_available()
 {
-	for (solarfield_staff_member* m : m_members)
-		if (!(m->is_busy()))
-			return true;
-	return false;
+	return !m_idle.empty();
 }
 
 solarfield_staff_member* solarfield_repair_staff::get_assigned_member(int helio_id)
 {
-	for (solarfield_staff_member* m : m_members)
-		if (m->get_assigned_heliostat() == helio_id)
-			return m;
-	throw std::runtime_error("helio id not assigned to any staff member.");
-	return NULL;
+	if (helio_id < 0 || helio_id >= (int)m_member_of_helio.size() || m_member_of_helio[helio_id] < 0)
+		throw std::runtime_error("helio id not assigned to any staff member.");
+	return &m_members[m_member_of_helio[helio_id]];
 }
 
 /*
@@ -110,9 +194,49 @@ void solarfield_repair_staff::reset_time_fractions(std::vector<double> & time_fr
 
 solarfield_staff_member* solarfield_repair_staff::get_available_staff()
 {
-	for (solarfield_staff_member* m : m_members)
-		if (!m->m_busy)
-			return m;
-	throw std::runtime_error("no members available");
-	return NULL;
-}
\ No newline at end of file
+	if (m_idle.empty())
+		throw std::runtime_error("no members available");
+	return &m_members[m_idle.top()];
+}
+
+solarfield_staff_member* solarfield_repair_staff::assign_available_staff(int helio_id)
+{
+	/*
+	Assigns the idle member of lowest index to repair a heliostat.
+	retval -- the member assigned
+	*/
+	if (m_idle.empty())
+		throw std::runtime_error("no members available");
+	int m = m_idle.top();
+	m_idle.pop();
+	if (helio_id >= (int)m_member_of_helio.size())
+		m_member_of_helio.resize(helio_id + 1, -1);
+	m_member_of_helio[helio_id] = m;
+	m_members[m].assign_heliostat(helio_id);
+	return &m_members[m];
+}
+
+solarfield_staff_member* solarfield_repair_staff::reassign_member(int helio_id, int new_helio_id)
+{
+	/*
+	Moves the member repairing one heliostat to the repair of another.
+	retval -- the member reassigned
+	*/
+	solarfield_staff_member *member = get_assigned_member(helio_id);
+	int m = m_member_of_helio[helio_id];
+	m_member_of_helio[helio_id] = -1;
+	if (new_helio_id >= (int)m_member_of_helio.size())
+		m_member_of_helio.resize(new_helio_id + 1, -1);
+	m_member_of_helio[new_helio_id] = m;
+	member->assign_heliostat(new_helio_id);
+	return member;
+}
+
+void solarfield_repair_staff::free_member(int helio_id)
+{
+	/* Makes the member repairing a heliostat idle. */
+	solarfield_staff_member *member = get_assigned_member(helio_id);
+	m_idle.push(m_member_of_helio[helio_id]);
+	m_member_of_helio[helio_id] = -1;
+	member->free();
+}
@@ -5,6 +5,9 @@
 #include "solarfield_structures.h"
 #include "./../libcycle/distributions.h"
 #include <stdexcept>
+#include <vector>
+#include <queue>
+#include <functional>
 
 enum repair_order {
 	FAILURE_ORDER,		// Repair in order failed
@@ -39,6 +42,7 @@ public:
 	double get_time_available();
 	double get_time_available_week();
 	void add_time_worked(double time);
+	double schedule_repair(double t_start, double repair_time);
 	void assign_heliostat(int helio_id);
 	void free();
 	bool is_busy();
@@ -48,8 +52,16 @@ public:
 
 
 
+/*
+The repair staff, with a free list of idle members and an index of the 
+member repairing each heliostat, so that finding an idle member or the 
+member assigned to a heliostat does not scan the staff.  Idle members are 
+assigned lowest index first.
+*/
 class solarfield_repair_staff
 {
+	std::priority_queue<int, std::vector<int>, std::greater<int> > m_idle;	// Indices of idle members
+	std::vector<int> m_member_of_helio;		// Index of the member repairing each heliostat, or -1
 
 public:
 
@@ -62,22 +74,17 @@ public:
 
 	double m_total_repair_time;				// Repair time for heliostats either in repair queue or undergoing repairs
 
-	std::vector<solarfield_staff_member*> m_members;	    // Staff members
+	std::vector<solarfield_staff_member> m_members;	    // Staff members
 
 	solarfield_repair_staff();
-	~solarfield_repair_staff()
-	{
-		for (size_t i = 0; i < m_members.size(); i++)
-			delete(m_members[i]);
-		m_members.clear();
-	};
-
-
-	solarfield_repair_staff(int nstaff, double max_per_day, double max_per_week);
+	void clear();
 	void add_member(double max_per_day, double max_per_week);
 	bool is_staff_available();
 	solarfield_staff_member* get_assigned_member(int helio_id);
 	solarfield_staff_member* get_available_staff();
+	solarfield_staff_member* assign_available_staff(int helio_id);
+	solarfield_staff_member* reassign_member(int helio_id, int new_helio_id);
+	void free_member(int helio_id);
 
 	//void reset_time_fractions(std::vector<double> & time_fraction);
 
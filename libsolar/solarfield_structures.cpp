@@ -2,6 +2,8 @@
 #include "solarfield_staff.h"
 
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
 
 
 
@@ -15,12 +17,15 @@ solarfield_settings::solarfield_settings()
 
 	n_helio = std::numeric_limits<int>::quiet_NaN();
 	n_helio_sim = 8000;
+	helio_sampling = FIRST_HELIOSTATS;
 
 	is_fix_hours = false;	
 	sunrise = 6.9;
 	sunset = 19.;
 
 	seed = 123;
+	n_replications = 1;
+	ci_level = 0.95;
 	repair_order = PERF_OVER_MRT;
 	is_tracking = false;
 
@@ -51,6 +56,174 @@ void solarfield_event::print()
 		<< "priority: " << priority << "\n";
 }
 
+solarfield_event_queue::solarfield_event_queue()
+{
+	m_n_pushed = 0;
+}
+
+void solarfield_event_queue::reset(int n_helios)
+{
+	/*
+	Empties the queue, and sizes it for events of heliostats 0 to n_helios-1.
+	*/
+	m_heap.clear();
+	m_heap.reserve(n_helios);
+	m_time.assign(n_helios, 0.);
+	m_priority.assign(n_helios, 0.);
+	m_component_idx.assign(n_helios, 0);
+	m_is_repair.assign(n_helios, 0);
+	m_is_queued.assign(n_helios, 0);
+	m_n_pushed = 0;
+}
+
+bool solarfield_event_queue::empty() const
+{
+	return m_heap.empty();
+}
+
+size_t solarfield_event_queue::size() const
+{
+	return m_heap.size();
+}
+
+void solarfield_event_queue::push(const solarfield_event &e)
+{
+	int h = e.helio_id;
+	if (h < 0 || h >= (int)m_is_queued.size())
+		throw std::runtime_error("event heliostat out of range of the event queue.");
+	if (m_is_queued[h])
+		throw std::runtime_error("heliostat already has an event in the queue.");
+	m_is_queued[h] = 1;
+	m_time[h] = e.time;
+	m_priority[h] = e.priority;
+	m_component_idx[h] = e.component_idx;
+	m_is_repair[h] = e.is_repair ? 1 : 0;
+
+	heap_entry entry;
+	entry.priority = e.priority;
+	entry.order = m_n_pushed++;
+	entry.helio_id = h;
+
+	//sift up
+	size_t i = m_heap.size();
+	m_heap.push_back(entry);
+	while (i > 0)
+	{
+		size_t parent = (i - 1) / EVENT_HEAP_ARITY;
+		if (!precedes(entry, m_heap[parent]))
+			break;
+		m_heap[i] = m_heap[parent];
+		i = parent;
+	}
+	m_heap[i] = entry;
+}
+
+solarfield_event solarfield_event_queue::top() const
+{
+	if (m_heap.empty())
+		throw std::runtime_error("top of an empty event queue.");
+	int h = m_heap.front().helio_id;
+	return solarfield_event(h, m_component_idx[h], m_is_repair[h] != 0, m_time[h], m_priority[h]);
+}
+
+void solarfield_event_queue::pop()
+{
+	if (m_heap.empty())
+		throw std::runtime_error("pop of an empty event queue.");
+	m_is_queued[m_heap.front().helio_id] = 0;
+	heap_entry entry = m_heap.back();
+	m_heap.pop_back();
+	size_t n = m_heap.size();
+	if (n == 0)
+		return;
+
+	//sift down the last entry from the root
+	size_t i = 0;
+	while (true)
+	{
+		size_t first = i * EVENT_HEAP_ARITY + 1;
+		if (first >= n)
+			break;
+		size_t last = std::min(first + EVENT_HEAP_ARITY, n);
+		size_t best = first;
+		for (size_t c = first + 1; c < last; c++)
+			if (precedes(m_heap[c], m_heap[best]))
+				best = c;
+		if (!precedes(m_heap[best], entry))
+			break;
+		m_heap[i] = m_heap[best];
+		i = best;
+	}
+	m_heap[i] = entry;
+}
+
+solarfield_level_record::solarfield_level_record()
+{
+	m_availability = 0.;
+	m_queue_length = 0.;
+}
+
+void solarfield_level_record::reset(int n_hours, double availability, double queue_length)
+{
+	/*
+	Empties the record, and sets the levels at time 0.
+	n_hours -- number of hours of the schedules
+	availability, queue_length -- levels at time 0
+	*/
+	m_avail_partial.assign(n_hours, 0.);
+	m_avail_delta.assign(n_hours, 0.);
+	m_queue_partial.assign(n_hours, 0.);
+	m_queue_delta.assign(n_hours, 0.);
+	m_availability = 0.;
+	m_queue_length = 0.;
+	set(0., availability, queue_length);
+}
+
+void solarfield_level_record::add_change(std::vector<double> &partial, std::vector<double> &delta, double t, double d)
+{
+	int h = (int)t;
+	if (h >= (int)partial.size())
+		return;
+	partial[h] += (h + 1 - t) * d;
+	if (h + 1 < (int)delta.size())
+		delta[h + 1] += d;
+}
+
+void solarfield_level_record::set(double t, double availability, double queue_length)
+{
+	/*
+	Records the levels that hold from time t on.
+	t -- time of the change [h]
+	availability -- field availability
+	queue_length -- repair queue length
+	*/
+	if (availability != m_availability)
+		add_change(m_avail_partial, m_avail_delta, t, availability - m_availability);
+	if (queue_length != m_queue_length)
+		add_change(m_queue_partial, m_queue_delta, t, queue_length - m_queue_length);
+	m_availability = availability;
+	m_queue_length = queue_length;
+}
+
+void solarfield_level_record::get_hourly(std::vector<double> &availability, std::vector<double> &queue_length) const
+{
+	/*
+	Sets the hourly mean levels from the changes recorded.
+	availability, queue_length -- hourly schedules, sized to the record
+	*/
+	size_t n = m_avail_partial.size();
+	availability.resize(n);
+	queue_length.resize(n);
+	double avail = 0., queue = 0.;
+	for (size_t h = 0; h < n; h++)
+	{
+		avail += m_avail_delta[h];
+		queue += m_queue_delta[h];
+		availability[h] = avail + m_avail_partial[h];
+		queue_length[h] = queue + m_queue_partial[h];
+	}
+}
+
 void solarfield_results::print()
 {
 	std::cerr << "Results: \n"
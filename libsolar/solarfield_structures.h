@@ -8,6 +8,11 @@
 #include "solarfield_staff.h"
 #include "../libclearsky/clearsky.h"
 
+enum helio_sampling {
+	FIRST_HELIOSTATS,	// Simulate the first n_helio_sim heliostats
+	STRATIFIED			// Simulate one heliostat per stratum of heliostats of similar performance
+};
+
 struct solarfield_settings
 {
 	//-- Simulation duration and resolution
@@ -23,6 +28,7 @@ struct solarfield_settings
 	//-- Heliostats
 	int n_helio;
 	int n_helio_sim;
+	unsigned int helio_sampling;	// Choice of the simulated heliostats: FIRST_HELIOSTATS, STRATIFIED
 	std::vector<helio_component_inputs> helio_components;  // Heliostat component inputs
 	std::vector<double> helio_performance;				   // Heliostat annual energy output [kWh]
 	double sum_performance;      //[kWh]
@@ -37,6 +43,8 @@ struct solarfield_settings
 
 	//-- Simulation options
 	int seed;					// Random number seed
+	int n_replications;			// Number of independent realisations averaged by simulate_replications
+	double ci_level;			// Confidence level of the intervals of the replicated results
 	unsigned int repair_order;	// Order that repairs are prioritized: FAILURE_ORDER, PERFORMANCE, REPAIR_TIME, MEAN_REPAIR_TIME, RANDOM
 	bool is_tracking;			// Enable detailed tracking of outputs?
 
@@ -69,6 +77,14 @@ struct solarfield_results
 	double heliostat_repair_cost_y1;
 	double heliostat_repair_cost;
 
+	// Replicated runs: number of realisations averaged, and half-widths of the 
+	// confidence intervals of the means (not a number for a single realisation)
+	int n_replications;
+	double avg_avail_ci;
+	double n_repairs_ci;
+	double staff_utilization_ci;
+	double repair_cost_ci;		// Total undiscounted repair cost over all years
+
 	// Optional outputs for debugging if "is_tracking" = true
 	std::vector<double> staff_time;							// Total time worked per staff member[hr]
 
@@ -114,6 +130,79 @@ struct solarfield_event
 
 bool operator<(const solarfield_event& e1, const solarfield_event& e2);
 
+/*
+Priority queue of field events holding at most one event per heliostat, 
+as the event and repair queues of the simulation do.  The event data are 
+kept in arrays indexed by heliostat, and the heap (of arity 
+EVENT_HEAP_ARITY) holds only each event's priority, push order and 
+heliostat, so sifting compares adjacent entries of one array.  The event 
+with the highest priority is on top; of events with equal priorities, 
+the one pushed first.
+*/
+class solarfield_event_queue
+{
+	struct heap_entry
+	{
+		double priority;
+		unsigned long long order;
+		int helio_id;
+	};
+
+	std::vector<heap_entry> m_heap;
+	std::vector<double> m_time;				// Event data by heliostat
+	std::vector<double> m_priority;
+	std::vector<int> m_component_idx;
+	std::vector<unsigned char> m_is_repair;
+	std::vector<unsigned char> m_is_queued;
+	unsigned long long m_n_pushed;
+
+	static bool precedes(const heap_entry &a, const heap_entry &b)
+	{
+		return a.priority > b.priority || (a.priority == b.priority && a.order < b.order);
+	}
+
+public:
+	static const size_t EVENT_HEAP_ARITY = 4;
+
+	solarfield_event_queue();
+
+	void reset(int n_helios);
+	bool empty() const;
+	size_t size() const;
+	void push(const solarfield_event &e);
+	solarfield_event top() const;
+	void pop();
+};
+
+/*
+Piecewise-constant field availability and repair queue length, recorded 
+as a difference array of their changes.  A change by d at time t in hour 
+h adds d times the part of hour h after t to that hour, and d to every 
+later hour; the first part is kept per hour, and the second as a change 
+at the start of hour h+1, so that recording a change touches two entries 
+of each series.  The hourly means are built in one prefix-sum pass at the 
+end of the simulation.  Changes from the end of the schedule on are 
+dropped, as the last event may fall after the simulated period.
+*/
+class solarfield_level_record
+{
+	std::vector<double> m_avail_partial;	// Changes in each hour, weighted by the part of the hour after them
+	std::vector<double> m_avail_delta;		// Changes from the start of each hour on
+	std::vector<double> m_queue_partial;
+	std::vector<double> m_queue_delta;
+	double m_availability;					// Last levels recorded
+	double m_queue_length;
+
+	void add_change(std::vector<double> &partial, std::vector<double> &delta, double t, double d);
+
+public:
+	solarfield_level_record();
+
+	void reset(int n_hours, double availability, double queue_length);
+	void set(double t, double availability, double queue_length);
+	void get_hourly(std::vector<double> &availability, std::vector<double> &queue_length) const;
+};
+
 struct solarfield_opt_settings
 {
 	//inputs
@@ -126,8 +215,9 @@ struct solarfield_opt_settings
 	double system_efficiency; //assumed efficiency including receiver, TES losses, power cycle
 	double price_per_kwh;  //assumed average for grid output
 	double num_years;      //years of operation to calculate NPV of annual costs
+	int n_threads;         //threads used by optimize_staff: up to n_replications per staff level, and n_threads / that many levels at once
 	
-	solarfield_opt_settings() {};
+	solarfield_opt_settings() : n_threads(1) {};
 	//void print();
 };
 